@@ -4,12 +4,19 @@
 #ifndef BOX_H
 #define BOX_H
 
+#include "ThreadStorage.h"
 #include "utils.h"
 #include <algorithm>
 #include <complex>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <tbb/spin_mutex.h>
+#include <utility>
+#include <vector>
 
+#include "BoxBatch.h"
+#include "BoxKernel.h"
 #include "VectorMath.h"
 
 /*! \file Box.h
@@ -131,6 +138,12 @@ public:
         return m_2d;
     }
 
+    //! Returns whether any tilt factor of the box is nonzero (tilts out of the plane are ignored in 2D)
+    bool isTriclinic() const
+    {
+        return (m_xy != 0) || (!m_2d && (m_xz != 0 || m_yz != 0));
+    }
+
     //! Get the value of Lx
     float getLx() const
     {
@@ -231,11 +244,12 @@ public:
      */
     void makeAbsolute(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = makeAbsolute(vecs[i]);
-            }
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            batch.load(vecs + begin, n);
+            transform.makeAbsolute(batch);
+            batch.store(vecs + begin);
         });
     }
 
@@ -263,13 +277,18 @@ public:
         return delta;
     }
 
+    //! Convert absolute coordinates into fractional coordinates in place
+    /*! \param vecs Vectors of absolute coordinates
+     *  \param Nvecs Number of vectors
+     */
     void makeFractional(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = makeFractional(vecs[i]);
-            }
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            batch.load(vecs + begin, n);
+            transform.makeFractional(batch);
+            batch.store(vecs + begin);
         });
     }
 
@@ -296,16 +315,23 @@ public:
      */
     void getImages(vec3<float>* vecs, unsigned int Nvecs, vec3<int>* res) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                getImage(vecs[i], res[i]);
-            }
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            BoxBatch<int> images;
+            batch.load(vecs + begin, n);
+            transform.getImages(batch, images);
+            images.store(res + begin);
         });
     }
 
     //! Wrap a vector back into the box
-    /*! \param v Vector to wrap, updated to the minimum image obeying the periodic settings
+    /*! The lattice vectors are subtracted from \a v according to its
+     *  rounded fractional coordinates along each periodic axis (see
+     *  BoxKernel::wrap, which is specialized for a given kind of box and
+     *  should be preferred in loops over many vectors).
+     *
+     *  \param v Vector to wrap, updated to the minimum image obeying the periodic settings
      *  \returns Wrapped vector
      */
     vec3<float> wrap(const vec3<float>& v) const
@@ -316,20 +342,30 @@ public:
             return v;
         }
 
-        vec3<float> v_frac = makeFractional(v);
-        if (m_periodic.x)
+        vec3<float> w(v);
+        if (m_periodic.z && !m_2d)
         {
-            v_frac.x = util::modulusPositive(v_frac.x, float(1.0));
+            const float image = std::floor(w.z * m_Linv.z + float(0.5));
+            w.x -= image * m_L.z * m_xz;
+            w.y -= image * m_L.z * m_yz;
+            w.z -= image * m_L.z;
         }
         if (m_periodic.y)
         {
-            v_frac.y = util::modulusPositive(v_frac.y, float(1.0));
+            const float image = std::floor((w.y - m_yz * w.z) * m_Linv.y + float(0.5));
+            w.x -= image * m_L.y * m_xy;
+            w.y -= image * m_L.y;
         }
-        if (m_periodic.z)
+        if (m_periodic.x)
         {
-            v_frac.z = util::modulusPositive(v_frac.z, float(1.0));
+            const float frac_x = w.x - m_xy * w.y - (m_xz - m_yz * m_xy) * w.z;
+            w.x -= std::floor(frac_x * m_Linv.x + float(0.5)) * m_L.x;
         }
-        return makeAbsolute(v_frac);
+        if (m_2d)
+        {
+            w.z = float(0.0);
+        }
+        return w;
     }
 
     //! Wrap vectors back into the box in place
@@ -338,14 +374,33 @@ public:
      */
     void wrap(vec3<float>* vecs, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = wrap(vecs[i]);
-            }
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            batch.load(vecs + begin, n);
+            transform.wrap(batch);
+            batch.store(vecs + begin);
         });
     }
 
+    //! Call a function with the BoxKernel specialized for this box
+    /*! The specialization is selected once based on whether the box is
+     *  triclinic, its dimensionality and its periodic flags, so that the
+     *  function can loop over many vectors without checking them again.
+     *
+     *  \param f Function object accepting any BoxKernel, usually a generic lambda.
+     *  \returns The value returned by \a f.
+     */
+    template<typename Function>
+    auto dispatchKernel(const Function& f) const -> decltype(f(std::declval<BoxKernel<false, false, 0>>()))
+    {
+        if (isTriclinic())
+        {
+            return m_2d ? dispatchPeriodicKernel<true, true>(f) : dispatchPeriodicKernel<true, false>(f);
+        }
+        return m_2d ? dispatchPeriodicKernel<false, true>(f) : dispatchPeriodicKernel<false, false>(f);
+    }
+
     //! Unwrap given positions to their absolute location in place
     /*! \param vecs Vectors of coordinates to unwrap
      *  \param images images flags for this point
@@ -353,16 +408,14 @@ public:
     */
     void unwrap(vec3<float>* vecs, const vec3<int>* images, unsigned int Nvecs) const
     {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] += getLatticeVector(0) * float(images[i].x);
-                vecs[i] += getLatticeVector(1) * float(images[i].y);
-                if (!m_2d)
-                {
-                    vecs[i] += getLatticeVector(2) * float(images[i].z);
-                }
-            }
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            BoxBatch<int> image_batch;
+            batch.load(vecs + begin, n);
+            image_batch.load(images + begin, n);
+            transform.unwrap(batch, image_batch);
+            batch.store(vecs + begin);
         });
     }
 
@@ -372,26 +425,78 @@ public:
      *  \param masses Optional array of masses, of length Nvecs
      *  \return Center of mass as a vec3<float>
      */
-    vec3<float> centerOfMass(vec3<float>* vecs, size_t Nvecs, const float* masses = nullptr) const
+    vec3<float> centerOfMass(const vec3<float>* vecs, size_t Nvecs, const float* masses = nullptr) const
     {
-        // This roughly follows the implementation in
-        // https://en.wikipedia.org/wiki/Center_of_mass#Systems_with_periodic_boundary_conditions
-        float total_mass(0);
-        vec3<std::complex<float>> xi_mean;
+        vec3<float> com;
+        centersOfMass(vecs, Nvecs, nullptr, 1, &com, masses);
+        return com;
+    }
 
-        for (size_t i = 0; i < Nvecs; ++i)
+    //! Compute the centers of mass of labeled groups of vectors
+    /*! Fractional coordinates are treated as angles on a circle along each
+     *  axis, and the center of mass along each axis is the angle of the mass
+     *  weighted average of the corresponding points on the circle. This
+     *  roughly follows the implementation in
+     *  https://en.wikipedia.org/wiki/Center_of_mass#Systems_with_periodic_boundary_conditions
+     *
+     *  The sines and cosines are evaluated in vectorized batches, and each
+     *  thread accumulates partial sums for every label, which are reduced at
+     *  the end.
+     *  Labels without any vectors (or with zero total mass) have undefined
+     *  (NaN) centers.
+     *
+     *  \param vecs Vectors to compute centers of mass
+     *  \param Nvecs Number of vectors
+     *  \param labels Label of each vector, less than num_labels, or nullptr if all vectors belong to label 0
+     *  \param num_labels Number of labels
+     *  \param centers Output array of centers of mass, of length num_labels
+     *  \param masses Optional array of masses, of length Nvecs
+     */
+    void centersOfMass(const vec3<float>* vecs, size_t Nvecs, const unsigned int* labels,
+                       unsigned int num_labels, vec3<float>* centers, const float* masses = nullptr) const
+    {
+        // Sums of the mass weighted cosines and sines along each axis and of
+        // the masses for every label.
+        util::ThreadStorage<double> local_sums({num_labels, 7});
+        const BoxBatchTransform transform(getBatchTransform());
+        forEachBoxBatch(Nvecs, [&](size_t begin, unsigned int n) {
+            BoxBatch<float> batch;
+            BoxBatch<float> sines;
+            BoxBatch<float> cosines;
+            batch.load(vecs + begin, n);
+            transform.makeFractional(batch);
+            sinCosTurns(batch.x, sines.x, cosines.x, n);
+            sinCosTurns(batch.y, sines.y, cosines.y, n);
+            sinCosTurns(batch.z, sines.z, cosines.z, n);
+
+            util::ManagedArray<double>& sums = local_sums.local();
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                const unsigned int label = (labels != nullptr) ? labels[begin + i] : 0;
+                const double mass = (masses != nullptr) ? masses[begin + i] : 1.0;
+                double* label_sums = &sums[7 * static_cast<size_t>(label)];
+                label_sums[0] += mass * cosines.x[i];
+                label_sums[1] += mass * sines.x[i];
+                label_sums[2] += mass * cosines.y[i];
+                label_sums[3] += mass * sines.y[i];
+                label_sums[4] += mass * cosines.z[i];
+                label_sums[5] += mass * sines.z[i];
+                label_sums[6] += mass;
+            }
+        });
+
+        util::ManagedArray<double> sums({num_labels, 7});
+        local_sums.reduceInto(sums);
+        for (unsigned int c = 0; c < num_labels; ++c)
         {
-            vec3<float> phase(constants::TWO_PI * makeFractional(vecs[i]));
-            vec3<std::complex<float>> xi(std::polar(float(1.0), phase.x), std::polar(float(1.0), phase.y),
-                                         std::polar(float(1.0), phase.z));
-            float mass = (masses != nullptr) ? masses[i] : float(1.0);
-            total_mass += mass;
-            xi_mean += std::complex<float>(mass, 0) * xi;
+            const double* label_sums = &sums[7 * static_cast<size_t>(c)];
+            const double total_mass = label_sums[6];
+            const vec3<float> angles(
+                static_cast<float>(std::atan2(label_sums[1] / total_mass, label_sums[0] / total_mass)),
+                static_cast<float>(std::atan2(label_sums[3] / total_mass, label_sums[2] / total_mass)),
+                static_cast<float>(std::atan2(label_sums[5] / total_mass, label_sums[4] / total_mass)));
+            centers[c] = wrap(makeAbsolute(angles / constants::TWO_PI));
         }
-        xi_mean /= std::complex<float>(total_mass, 0);
-
-        return wrap(makeAbsolute(vec3<float>(std::arg(xi_mean.x), std::arg(xi_mean.y), std::arg(xi_mean.z))
-                                 / constants::TWO_PI));
     }
 
     //! Subtract center of mass from vectors
@@ -402,11 +507,13 @@ public:
     void center(vec3<float>* vecs, unsigned int Nvecs, const float* masses = nullptr) const
     {
         vec3<float> com(centerOfMass(vecs, Nvecs, masses));
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = wrap(vecs[i] - com);
-            }
+        dispatchKernel([=](const auto& kernel) {
+            util::forLoopWrapper(0, Nvecs, [=, &kernel](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    vecs[i] = kernel.wrap(vecs[i] - com);
+                }
+            });
         });
     }
 
@@ -435,11 +542,13 @@ public:
         {
             throw std::invalid_argument("The number of query points and points must match.");
         }
-        util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                distances[i] = computeDistance(query_points[i], points[i]);
-            }
+        dispatchKernel([&](const auto& kernel) {
+            util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    distances[i] = kernel.distance(query_points[i], points[i]);
+                }
+            });
         });
     }
 
@@ -454,13 +563,176 @@ public:
     void computeAllDistances(const vec3<float>* query_points, const unsigned int n_query_points,
                              const vec3<float>* points, const unsigned int n_points, float* distances) const
     {
+        forEachDistanceBatch(query_points, n_query_points, points, n_points,
+                             [=](size_t i, size_t j, const float* r_sq, unsigned int n) {
+                                 float* row = distances + i * n_points + j;
+                                 for (unsigned int k = 0; k < n; ++k)
+                                 {
+                                     row[k] = std::sqrt(r_sq[k]);
+                                 }
+                             });
+    }
+
+    //! Find the k nearest points to each query point by computing all pairwise distances.
+    /*! Unlike computeAllDistances, this requires no storage beyond the
+     *  results. Ties are resolved in favor of the lower point index.
+     *
+     *  \param query_points Query point positions.
+     *  \param n_query_points The number of query points.
+     *  \param points Point positions.
+     *  \param n_points The number of points.
+     *  \param k The number of nearest points to find for each query point (at most n_points).
+     *  \param distances Pointer to array of length n_query_points*k containing the distances to the nearest
+     *         points of each query point in increasing order (overwritten in place).
+     *  \param indices Pointer to array of length n_query_points*k containing the indices of the nearest
+     *         points (overwritten in place).
+     */
+    void computeNearestDistances(const vec3<float>* query_points, const unsigned int n_query_points,
+                                 const vec3<float>* points, const unsigned int n_points, const unsigned int k,
+                                 float* distances, unsigned int* indices) const
+    {
+        if (k == 0 || k > n_points)
+        {
+            throw std::invalid_argument(
+                "The number of nearest points must be between 1 and the number of points.");
+        }
+        // Rows hold squared distances while they are being filled. Batches of
+        // points of the same query point may be processed concurrently, so
+        // each row is locked while a batch is inserted into it, and points
+        // are ordered by (squared distance, index) so that the result does
+        // not depend on the order of the batches.
+        std::fill(distances, distances + static_cast<size_t>(n_query_points) * k,
+                  std::numeric_limits<float>::infinity());
+        std::fill(indices, indices + static_cast<size_t>(n_query_points) * k,
+                  std::numeric_limits<unsigned int>::max());
+        std::vector<tbb::spin_mutex> row_mutexes(n_query_points);
+        forEachDistanceBatch(query_points, n_query_points, points, n_points,
+                             [&](size_t i, size_t j, const float* r_sq, unsigned int n) {
+                                 float* row_r_sq = distances + i * k;
+                                 unsigned int* row_indices = indices + i * k;
+                                 const auto closer = [&](unsigned int l, unsigned int m) {
+                                     return r_sq[l] < row_r_sq[m]
+                                         || (r_sq[l] == row_r_sq[m] && j + l < row_indices[m]);
+                                 };
+                                 tbb::spin_mutex::scoped_lock lock(row_mutexes[i]);
+                                 for (unsigned int l = 0; l < n; ++l)
+                                 {
+                                     if (closer(l, k - 1))
+                                     {
+                                         // Insertion into the sorted row.
+                                         unsigned int m = k - 1;
+                                         for (; m > 0 && closer(l, m - 1); --m)
+                                         {
+                                             row_r_sq[m] = row_r_sq[m - 1];
+                                             row_indices[m] = row_indices[m - 1];
+                                         }
+                                         row_r_sq[m] = r_sq[l];
+                                         row_indices[m] = static_cast<unsigned int>(j + l);
+                                     }
+                                 }
+                             });
+        util::forLoopWrapper(0, static_cast<size_t>(n_query_points) * k, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                distances[i] = std::sqrt(distances[i]);
+            }
+        });
+    }
+
+    //! Histogram the distances between all pairs of query points and points.
+    /*! Unlike computeAllDistances, this requires no storage beyond the
+     *  histogram. As in numpy.histogram, the bins are half-open except for
+     *  the last one, which includes r_max, so pairs at distances greater
+     *  than r_max are not counted.
+     *
+     *  \param query_points Query point positions.
+     *  \param n_query_points The number of query points.
+     *  \param points Point positions.
+     *  \param n_points The number of points.
+     *  \param r_max Upper bound of the histogram.
+     *  \param bins Number of bins of width r_max / bins.
+     *  \param counts Pointer to array of length bins containing the number of pairs in each bin
+     *         (overwritten in place).
+     */
+    void computeDistanceHistogram(const vec3<float>* query_points, const unsigned int n_query_points,
+                                  const vec3<float>* points, const unsigned int n_points, const float r_max,
+                                  const unsigned int bins, unsigned int* counts) const
+    {
+        if (bins == 0)
+        {
+            throw std::invalid_argument("The number of bins must be positive.");
+        }
+        if (r_max <= 0)
+        {
+            throw std::invalid_argument("r_max must be positive.");
+        }
+        const float bin_scale = static_cast<float>(bins) / r_max;
+        util::ThreadStorage<unsigned int> local_counts(bins);
+        forEachDistanceBatch(query_points, n_query_points, points, n_points,
+                             [&](size_t /*i*/, size_t /*j*/, const float* r_sq, unsigned int n) {
+                                 util::ManagedArray<unsigned int>& thread_counts = local_counts.local();
+                                 for (unsigned int l = 0; l < n; ++l)
+                                 {
+                                     // The distance itself is compared against the right edge,
+                                     // since squaring r_max may round differently, so that the
+                                     // counts match binning the output of computeAllDistances.
+                                     const float r = std::sqrt(r_sq[l]);
+                                     if (r <= r_max)
+                                     {
+                                         const auto bin = static_cast<unsigned int>(r * bin_scale);
+                                         ++thread_counts[std::min(bin, bins - 1)];
+                                     }
+                                 }
+                             });
+        util::ManagedArray<unsigned int> total_counts(bins);
+        local_counts.reduceInto(total_counts);
+        std::copy(total_counts.get(), total_counts.get() + bins, counts);
+    }
+
+    //! Apply a function to the squared distances between all pairs of query points and points
+    /*! The pairs are split into 2D tiles of query points and batches of
+     *  BOX_BATCH_SIZE points, which are distributed across threads, so that
+     *  both many query points and a few query points against many points
+     *  run in parallel. Within a tile, each batch of points is staged in SoA
+     *  form once and reused for all query points of the tile, so that the
+     *  work is limited by arithmetic rather than by memory bandwidth. The
+     *  squared distances of a batch are computed with
+     *  BoxBatchTransform::distancesSquared and passed to the function
+     *  without being stored, which allows reductions over all pairs without
+     *  a dense distance matrix.
+     *
+     *  The function may be called concurrently for the same query point with
+     *  different batches of points, so per query point results must be
+     *  updated with synchronization (or by tiles writing disjoint outputs).
+     *
+     *  \param query_points Query point positions.
+     *  \param n_query_points The number of query points.
+     *  \param points Point positions.
+     *  \param n_points The number of points.
+     *  \param body An object with operator(size_t query_point_idx, size_t point_begin, const float* r_sq,
+     *         unsigned int n), where r_sq holds the n squared distances from the query point to the points
+     *         starting at point_begin.
+     */
+    template<typename Body>
+    void forEachDistanceBatch(const vec3<float>* query_points, const unsigned int n_query_points,
+                              const vec3<float>* points, const unsigned int n_points, const Body& body) const
+    {
+        const BoxBatchTransform transform(getBatchTransform());
+        const size_t n_batches = (size_t(n_points) + BOX_BATCH_SIZE - 1) / BOX_BATCH_SIZE;
         util::forLoopWrapper2D(
-            0, n_query_points, 0, n_points, [&](size_t begin_n, size_t end_n, size_t begin_m, size_t end_m) {
-                for (size_t i = begin_n; i < end_n; ++i)
+            0, n_query_points, 0, n_batches,
+            [&](size_t query_begin, size_t query_end, size_t batch_begin, size_t batch_end) {
+                BoxBatch<float> batch;
+                alignas(32) float r_sq[BOX_BATCH_SIZE];
+                for (size_t b = batch_begin; b < batch_end; ++b)
                 {
-                    for (size_t j = begin_m; j < end_m; ++j)
+                    const size_t j = b * BOX_BATCH_SIZE;
+                    const auto n = static_cast<unsigned int>(std::min<size_t>(BOX_BATCH_SIZE, n_points - j));
+                    batch.load(points + j, n);
+                    for (size_t i = query_begin; i < query_end; ++i)
                     {
-                        distances[i * n_points + j] = computeDistance(query_points[i], points[j]);
+                        transform.distancesSquared(query_points[i], batch, r_sq);
+                        body(i, j, r_sq, n);
                     }
                 }
             });
@@ -598,6 +870,47 @@ public:
     }
 
 private:
+    //! Select the BoxKernel specialization for the periodic flags of this box
+    template<bool Triclinic, bool TwoD, typename Function>
+    auto dispatchPeriodicKernel(const Function& f) const
+        -> decltype(f(std::declval<BoxKernel<Triclinic, TwoD, 0>>()))
+    {
+        const unsigned int periodic_mask = (m_periodic.x ? PERIODIC_X : 0) | (m_periodic.y ? PERIODIC_Y : 0)
+            | (m_periodic.z ? PERIODIC_Z : 0);
+        switch (periodic_mask)
+        {
+        case 0:
+            return f(makeKernel<Triclinic, TwoD, 0>());
+        case PERIODIC_X:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_X>());
+        case PERIODIC_Y:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_Y>());
+        case PERIODIC_X | PERIODIC_Y:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_X | PERIODIC_Y>());
+        case PERIODIC_Z:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_Z>());
+        case PERIODIC_X | PERIODIC_Z:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_X | PERIODIC_Z>());
+        case PERIODIC_Y | PERIODIC_Z:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_Y | PERIODIC_Z>());
+        default:
+            return f(makeKernel<Triclinic, TwoD, PERIODIC_X | PERIODIC_Y | PERIODIC_Z>());
+        }
+    }
+
+    //! Create a BoxBatchTransform with the dimensions and periodicity of this box
+    BoxBatchTransform getBatchTransform() const
+    {
+        return BoxBatchTransform(m_lo, m_L, m_Linv, m_xy, m_xz, m_yz, m_periodic, m_2d);
+    }
+
+    //! Create a BoxKernel with the dimensions of this box
+    template<bool Triclinic, bool TwoD, unsigned int PeriodicMask>
+    BoxKernel<Triclinic, TwoD, PeriodicMask> makeKernel() const
+    {
+        return BoxKernel<Triclinic, TwoD, PeriodicMask>(m_L, m_Linv, m_xy, m_xz, m_yz);
+    }
+
     vec3<float> m_lo;      //!< Minimum coords in the box
     vec3<float> m_hi;      //!< Maximum coords in the box
     vec3<float> m_L;       //!< L precomputed (used to avoid subtractions in boundary conditions)
@@ -0,0 +1,508 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOX_BATCH_H
+#define BOX_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "VectorMath.h"
+#include "utils.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*! \file BoxBatch.h
+    \brief Vectorized box transformations of batches of vectors.
+*/
+
+namespace freud { namespace box {
+
+//! Number of vectors transformed together by a BoxBatchTransform.
+/*! This is a multiple of the AVX2 lane width, so a batch is always processed
+ *  in whole registers.
+ */
+constexpr unsigned int BOX_BATCH_SIZE = 64;
+
+//! Structure-of-arrays staging buffer for a batch of vectors.
+/*! Vectors are stored in AoS layout throughout freud. They are de-interleaved
+ *  into this buffer so that the box transformations can operate on contiguous
+ *  lanes, and interleaved back afterwards. Lanes past the size of the batch
+ *  up to the next multiple of the lane width are zeroed, so they can be
+ *  transformed along with the others.
+ */
+template<typename Scalar> struct BoxBatch
+{
+    //! Copy n <= BOX_BATCH_SIZE vectors into the batch.
+    void load(const vec3<Scalar>* vecs, unsigned int n)
+    {
+        size = n;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            x[i] = vecs[i].x;
+            y[i] = vecs[i].y;
+            z[i] = vecs[i].z;
+        }
+        for (unsigned int i = n; i < ((n + 7) & ~7u); ++i)
+        {
+            x[i] = y[i] = z[i] = Scalar(0);
+        }
+    }
+
+    //! Copy the vectors of the batch back to AoS layout.
+    void store(vec3<Scalar>* vecs) const
+    {
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            vecs[i] = vec3<Scalar>(x[i], y[i], z[i]);
+        }
+    }
+
+    alignas(32) Scalar x[BOX_BATCH_SIZE]; //!< x components of the vectors
+    alignas(32) Scalar y[BOX_BATCH_SIZE]; //!< y components of the vectors
+    alignas(32) Scalar z[BOX_BATCH_SIZE]; //!< z components of the vectors
+    unsigned int size {0};                //!< Number of vectors in the batch
+};
+
+//! Apply a function to consecutive batches of at most BOX_BATCH_SIZE indices in parallel.
+/*! \param N Number of indices.
+ *  \param body An object with operator(size_t begin, unsigned int n).
+ */
+template<typename Body> inline void forEachBoxBatch(size_t N, const Body& body)
+{
+    util::forLoopWrapper(0, N, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i += BOX_BATCH_SIZE)
+        {
+            body(i, static_cast<unsigned int>(std::min<size_t>(BOX_BATCH_SIZE, end - i)));
+        }
+    });
+}
+
+//! Compute the sines and cosines of angles given in turns
+/*! The angles are reduced to the nearest quarter turn, leaving a remainder in
+ *  [-1/8, 1/8] turns whose sine and cosine are evaluated with polynomials
+ *  accurate to single precision, and the results are rotated by the quarter
+ *  turns. Fractional coordinates are naturally expressed in turns, so no
+ *  division by 2 pi is needed for periodic averages.
+ *
+ *  \param turns Angles in turns (one turn is 2 pi), for n lanes rounded up to a multiple of 8.
+ *  \param sin_out Output sines.
+ *  \param cos_out Output cosines.
+ *  \param n Number of angles.
+ */
+inline void sinCosTurns(const float* turns, float* sin_out, float* cos_out, unsigned int n)
+{
+    constexpr float quarter_turn_angle = float(M_PI / 2.0);
+#if defined(__AVX2__)
+    const __m256 four = _mm256_set1_ps(4.0);
+    const __m256 angle_scale = _mm256_set1_ps(quarter_turn_angle);
+    const __m256 one = _mm256_set1_ps(1.0);
+    const __m256 sign = _mm256_set1_ps(-0.0);
+    const __m256i int_one = _mm256_set1_epi32(1);
+    const __m256i int_two = _mm256_set1_epi32(2);
+    for (unsigned int i = 0; i < n; i += 8)
+    {
+        const __m256 t = _mm256_mul_ps(_mm256_loadu_ps(turns + i), four);
+        const __m256 quarters = _mm256_round_ps(t, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m256 x = _mm256_mul_ps(_mm256_sub_ps(t, quarters), angle_scale);
+        const __m256 x2 = _mm256_mul_ps(x, x);
+
+        __m256 s = _mm256_set1_ps(float(1.0 / 362880.0));
+        s = _mm256_add_ps(_mm256_mul_ps(s, x2), _mm256_set1_ps(float(-1.0 / 5040.0)));
+        s = _mm256_add_ps(_mm256_mul_ps(s, x2), _mm256_set1_ps(float(1.0 / 120.0)));
+        s = _mm256_add_ps(_mm256_mul_ps(s, x2), _mm256_set1_ps(float(-1.0 / 6.0)));
+        s = _mm256_mul_ps(x, _mm256_add_ps(_mm256_mul_ps(s, x2), one));
+
+        __m256 c = _mm256_set1_ps(float(-1.0 / 3628800.0));
+        c = _mm256_add_ps(_mm256_mul_ps(c, x2), _mm256_set1_ps(float(1.0 / 40320.0)));
+        c = _mm256_add_ps(_mm256_mul_ps(c, x2), _mm256_set1_ps(float(-1.0 / 720.0)));
+        c = _mm256_add_ps(_mm256_mul_ps(c, x2), _mm256_set1_ps(float(1.0 / 24.0)));
+        c = _mm256_add_ps(_mm256_mul_ps(c, x2), _mm256_set1_ps(float(-0.5)));
+        c = _mm256_add_ps(_mm256_mul_ps(c, x2), one);
+
+        // Rotate by the quarter turns: odd quarters swap sine and cosine,
+        // quarters 2 and 3 negate the sine, and quarters 1 and 2 negate the cosine.
+        const __m256i q = _mm256_cvtps_epi32(quarters);
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, int_one), int_one));
+        const __m256 sin_sign = _mm256_and_ps(
+            _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, int_two), 30)), sign);
+        const __m256 cos_sign = _mm256_and_ps(
+            _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(q, int_one), 30)), sign);
+        _mm256_storeu_ps(sin_out + i, _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sin_sign));
+        _mm256_storeu_ps(cos_out + i, _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cos_sign));
+    }
+#else
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const float t = turns[i] * float(4.0);
+        const float quarters = std::nearbyint(t);
+        const float x = (t - quarters) * quarter_turn_angle;
+        const float x2 = x * x;
+        float s = float(1.0 / 362880.0);
+        s = s * x2 + float(-1.0 / 5040.0);
+        s = s * x2 + float(1.0 / 120.0);
+        s = s * x2 + float(-1.0 / 6.0);
+        s = x * (s * x2 + float(1.0));
+
+        float c = float(-1.0 / 3628800.0);
+        c = c * x2 + float(1.0 / 40320.0);
+        c = c * x2 + float(-1.0 / 720.0);
+        c = c * x2 + float(1.0 / 24.0);
+        c = c * x2 + float(-0.5);
+        c = c * x2 + float(1.0);
+
+        const unsigned int q = static_cast<unsigned int>(static_cast<int>(quarters)) & 3u;
+        const float sin_q = (q & 1u) != 0 ? c : s;
+        const float cos_q = (q & 1u) != 0 ? s : c;
+        sin_out[i] = (q >= 2u) ? -sin_q : sin_q;
+        cos_out[i] = (q == 1u || q == 2u) ? -cos_q : cos_q;
+    }
+#endif
+}
+
+//! Transformations between absolute, fractional and image coordinates of batches of vectors
+/*! The arithmetic matches the corresponding scalar methods of Box, but is
+ *  applied to eight lanes at once with AVX2 when it is enabled at compile
+ *  time (e.g. with -march=native); otherwise scalar loops over the lanes are
+ *  used. Tilt factors are always applied, so the same code handles
+ *  orthorhombic and triclinic boxes.
+ */
+class BoxBatchTransform
+{
+public:
+    //! Constructor
+    /*! \param lo Minimum coordinates of the box.
+     *  \param L Box lengths.
+     *  \param Linv Inverse box lengths.
+     *  \param xy Tilt factor xy.
+     *  \param xz Tilt factor xz.
+     *  \param yz Tilt factor yz.
+     *  \param periodic Periodic flags.
+     *  \param is2D Whether the box is two dimensional.
+     */
+    BoxBatchTransform(const vec3<float>& lo, const vec3<float>& L, const vec3<float>& Linv, float xy,
+                      float xz, float yz, const vec3<bool>& periodic, bool is2D)
+        : m_lo(lo), m_L(L), m_Linv(Linv), m_xy(xy), m_xz(xz), m_yz(yz), m_periodic(periodic), m_2d(is2D)
+    {}
+
+    //! Convert absolute coordinates into fractional coordinates (see Box::makeFractional).
+    void makeFractional(BoxBatch<float>& b) const
+    {
+        const float tilt_x = m_xz - m_yz * m_xy;
+#if defined(__AVX2__)
+        const __m256 lo_x = _mm256_set1_ps(m_lo.x);
+        const __m256 lo_y = _mm256_set1_ps(m_lo.y);
+        const __m256 lo_z = _mm256_set1_ps(m_lo.z);
+        const __m256 L_x = _mm256_set1_ps(m_L.x);
+        const __m256 L_y = _mm256_set1_ps(m_L.y);
+        const __m256 L_z = _mm256_set1_ps(m_L.z);
+        const __m256 xy = _mm256_set1_ps(m_xy);
+        const __m256 yz = _mm256_set1_ps(m_yz);
+        const __m256 txz = _mm256_set1_ps(tilt_x);
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            const __m256 vx = _mm256_load_ps(b.x + i);
+            const __m256 vy = _mm256_load_ps(b.y + i);
+            const __m256 vz = _mm256_load_ps(b.z + i);
+            const __m256 dx = _mm256_sub_ps(
+                _mm256_sub_ps(vx, lo_x), _mm256_add_ps(_mm256_mul_ps(txz, vz), _mm256_mul_ps(xy, vy)));
+            const __m256 dy = _mm256_sub_ps(_mm256_sub_ps(vy, lo_y), _mm256_mul_ps(yz, vz));
+            _mm256_store_ps(b.x + i, _mm256_div_ps(dx, L_x));
+            _mm256_store_ps(b.y + i, _mm256_div_ps(dy, L_y));
+            _mm256_store_ps(b.z + i,
+                            m_2d ? _mm256_setzero_ps() : _mm256_div_ps(_mm256_sub_ps(vz, lo_z), L_z));
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            const float vx = b.x[i];
+            const float vy = b.y[i];
+            const float vz = b.z[i];
+            b.x[i] = ((vx - m_lo.x) - (tilt_x * vz + m_xy * vy)) / m_L.x;
+            b.y[i] = ((vy - m_lo.y) - m_yz * vz) / m_L.y;
+            b.z[i] = m_2d ? float(0.0) : (vz - m_lo.z) / m_L.z;
+        }
+#endif
+    }
+
+    //! Convert fractional coordinates into absolute coordinates (see Box::makeAbsolute).
+    void makeAbsolute(BoxBatch<float>& b) const
+    {
+#if defined(__AVX2__)
+        const __m256 lo_x = _mm256_set1_ps(m_lo.x);
+        const __m256 lo_y = _mm256_set1_ps(m_lo.y);
+        const __m256 lo_z = _mm256_set1_ps(m_lo.z);
+        const __m256 L_x = _mm256_set1_ps(m_L.x);
+        const __m256 L_y = _mm256_set1_ps(m_L.y);
+        const __m256 L_z = _mm256_set1_ps(m_L.z);
+        const __m256 xy = _mm256_set1_ps(m_xy);
+        const __m256 xz = _mm256_set1_ps(m_xz);
+        const __m256 yz = _mm256_set1_ps(m_yz);
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            const __m256 vx = _mm256_add_ps(lo_x, _mm256_mul_ps(_mm256_load_ps(b.x + i), L_x));
+            const __m256 vy = _mm256_add_ps(lo_y, _mm256_mul_ps(_mm256_load_ps(b.y + i), L_y));
+            const __m256 vz = _mm256_add_ps(lo_z, _mm256_mul_ps(_mm256_load_ps(b.z + i), L_z));
+            _mm256_store_ps(b.x + i,
+                            _mm256_add_ps(vx, _mm256_add_ps(_mm256_mul_ps(xy, vy), _mm256_mul_ps(xz, vz))));
+            _mm256_store_ps(b.y + i, _mm256_add_ps(vy, _mm256_mul_ps(yz, vz)));
+            _mm256_store_ps(b.z + i, m_2d ? _mm256_setzero_ps() : vz);
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            const float vx = m_lo.x + b.x[i] * m_L.x;
+            const float vy = m_lo.y + b.y[i] * m_L.y;
+            const float vz = m_lo.z + b.z[i] * m_L.z;
+            b.x[i] = vx + (m_xy * vy + m_xz * vz);
+            b.y[i] = vy + m_yz * vz;
+            b.z[i] = m_2d ? float(0.0) : vz;
+        }
+#endif
+    }
+
+    //! Wrap vectors back into the box (see Box::wrap).
+    void wrap(BoxBatch<float>& b) const
+    {
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            return;
+        }
+#if defined(__AVX2__)
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            __m256 vx = _mm256_load_ps(b.x + i);
+            __m256 vy = _mm256_load_ps(b.y + i);
+            __m256 vz = _mm256_load_ps(b.z + i);
+            wrapLanes(vx, vy, vz);
+            _mm256_store_ps(b.x + i, vx);
+            _mm256_store_ps(b.y + i, vy);
+            _mm256_store_ps(b.z + i, vz);
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            wrapLane(b.x[i], b.y[i], b.z[i]);
+        }
+#endif
+    }
+
+    //! Compute the squared lengths of the wrapped vectors from a point to a batch of points.
+    /*! \param r_i The point from which vectors are computed.
+     *  \param b Batch of points.
+     *  \param r_sq Output array of squared distances, of length BOX_BATCH_SIZE.
+     */
+    void distancesSquared(const vec3<float>& r_i, const BoxBatch<float>& b, float* r_sq) const
+    {
+        const bool periodic = m_periodic.x || m_periodic.y || m_periodic.z;
+#if defined(__AVX2__)
+        const __m256 qx = _mm256_set1_ps(r_i.x);
+        const __m256 qy = _mm256_set1_ps(r_i.y);
+        const __m256 qz = _mm256_set1_ps(r_i.z);
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            __m256 dx = _mm256_sub_ps(_mm256_load_ps(b.x + i), qx);
+            __m256 dy = _mm256_sub_ps(_mm256_load_ps(b.y + i), qy);
+            __m256 dz = _mm256_sub_ps(_mm256_load_ps(b.z + i), qz);
+            if (periodic)
+            {
+                wrapLanes(dx, dy, dz);
+            }
+            _mm256_storeu_ps(r_sq + i,
+                             _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                           _mm256_mul_ps(dz, dz)));
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            float dx = b.x[i] - r_i.x;
+            float dy = b.y[i] - r_i.y;
+            float dz = b.z[i] - r_i.z;
+            if (periodic)
+            {
+                wrapLane(dx, dy, dz);
+            }
+            r_sq[i] = dx * dx + dy * dy + dz * dz;
+        }
+#endif
+    }
+
+    //! Compute the periodic images of vectors (see Box::getImage).
+    /*! \param b Batch of vectors, converted to fractional coordinates in place.
+     *  \param images Output batch of image indices.
+     */
+    void getImages(BoxBatch<float>& b, BoxBatch<int>& images) const
+    {
+        makeFractional(b);
+        images.size = b.size;
+#if defined(__AVX2__)
+        const __m256 half = _mm256_set1_ps(0.5);
+        const __m256 sign = _mm256_set1_ps(-0.0);
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            // Fractional coordinates are shifted to the box center and
+            // rounded half away from zero.
+            const __m256 fx = _mm256_sub_ps(_mm256_load_ps(b.x + i), half);
+            const __m256 fy = _mm256_sub_ps(_mm256_load_ps(b.y + i), half);
+            const __m256 fx_r = _mm256_add_ps(fx, _mm256_or_ps(_mm256_and_ps(fx, sign), half));
+            const __m256 fy_r = _mm256_add_ps(fy, _mm256_or_ps(_mm256_and_ps(fy, sign), half));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(images.x + i), _mm256_cvttps_epi32(fx_r));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(images.y + i), _mm256_cvttps_epi32(fy_r));
+            if (m_2d)
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(images.z + i), _mm256_setzero_si256());
+            }
+            else
+            {
+                const __m256 fz = _mm256_sub_ps(_mm256_load_ps(b.z + i), half);
+                const __m256 fz_r = _mm256_add_ps(fz, _mm256_or_ps(_mm256_and_ps(fz, sign), half));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(images.z + i), _mm256_cvttps_epi32(fz_r));
+            }
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            const float fx = b.x[i] - float(0.5);
+            const float fy = b.y[i] - float(0.5);
+            const float fz = m_2d ? float(0.0) : b.z[i] - float(0.5);
+            images.x[i] = static_cast<int>((fx >= float(0.0)) ? fx + float(0.5) : fx - float(0.5));
+            images.y[i] = static_cast<int>((fy >= float(0.0)) ? fy + float(0.5) : fy - float(0.5));
+            images.z[i] = static_cast<int>((fz >= float(0.0)) ? fz + float(0.5) : fz - float(0.5));
+        }
+#endif
+    }
+
+    //! Unwrap vectors to their absolute location given their images (see Box::unwrap).
+    void unwrap(BoxBatch<float>& b, const BoxBatch<int>& images) const
+    {
+        const float a2_x = m_L.y * m_xy;
+        const float a3_x = m_L.z * m_xz;
+        const float a3_y = m_L.z * m_yz;
+#if defined(__AVX2__)
+        const __m256 L_x = _mm256_set1_ps(m_L.x);
+        const __m256 L_y = _mm256_set1_ps(m_L.y);
+        const __m256 L_z = _mm256_set1_ps(m_L.z);
+        const __m256 a2x = _mm256_set1_ps(a2_x);
+        const __m256 a3x = _mm256_set1_ps(a3_x);
+        const __m256 a3y = _mm256_set1_ps(a3_y);
+        for (unsigned int i = 0; i < b.size; i += 8)
+        {
+            const __m256 ix
+                = _mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(images.x + i)));
+            const __m256 iy
+                = _mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(images.y + i)));
+            __m256 vx = _mm256_add_ps(_mm256_load_ps(b.x + i), _mm256_mul_ps(L_x, ix));
+            vx = _mm256_add_ps(vx, _mm256_mul_ps(a2x, iy));
+            __m256 vy = _mm256_add_ps(_mm256_load_ps(b.y + i), _mm256_mul_ps(L_y, iy));
+            if (!m_2d)
+            {
+                const __m256 iz
+                    = _mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(images.z + i)));
+                vx = _mm256_add_ps(vx, _mm256_mul_ps(a3x, iz));
+                vy = _mm256_add_ps(vy, _mm256_mul_ps(a3y, iz));
+                _mm256_store_ps(b.z + i, _mm256_add_ps(_mm256_load_ps(b.z + i), _mm256_mul_ps(L_z, iz)));
+            }
+            _mm256_store_ps(b.x + i, vx);
+            _mm256_store_ps(b.y + i, vy);
+        }
+#else
+        for (unsigned int i = 0; i < b.size; ++i)
+        {
+            const float ix = static_cast<float>(images.x[i]);
+            const float iy = static_cast<float>(images.y[i]);
+            b.x[i] += m_L.x * ix;
+            b.x[i] += a2_x * iy;
+            b.y[i] += m_L.y * iy;
+            if (!m_2d)
+            {
+                const float iz = static_cast<float>(images.z[i]);
+                b.x[i] += a3_x * iz;
+                b.y[i] += a3_y * iz;
+                b.z[i] += m_L.z * iz;
+            }
+        }
+#endif
+    }
+
+private:
+#if defined(__AVX2__)
+    //! Wrap eight vectors in registers into a periodic box.
+    void wrapLanes(__m256& vx, __m256& vy, __m256& vz) const
+    {
+        const __m256 half = _mm256_set1_ps(0.5);
+        if (m_periodic.z && !m_2d)
+        {
+            const __m256 shift = _mm256_mul_ps(
+                _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(vz, _mm256_set1_ps(m_Linv.z)), half)),
+                _mm256_set1_ps(m_L.z));
+            vx = _mm256_sub_ps(vx, _mm256_mul_ps(shift, _mm256_set1_ps(m_xz)));
+            vy = _mm256_sub_ps(vy, _mm256_mul_ps(shift, _mm256_set1_ps(m_yz)));
+            vz = _mm256_sub_ps(vz, shift);
+        }
+        if (m_periodic.y)
+        {
+            const __m256 frac_y = _mm256_sub_ps(vy, _mm256_mul_ps(_mm256_set1_ps(m_yz), vz));
+            const __m256 shift = _mm256_mul_ps(
+                _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(frac_y, _mm256_set1_ps(m_Linv.y)), half)),
+                _mm256_set1_ps(m_L.y));
+            vx = _mm256_sub_ps(vx, _mm256_mul_ps(shift, _mm256_set1_ps(m_xy)));
+            vy = _mm256_sub_ps(vy, shift);
+        }
+        if (m_periodic.x)
+        {
+            const __m256 frac_x = _mm256_sub_ps(_mm256_sub_ps(vx, _mm256_mul_ps(_mm256_set1_ps(m_xy), vy)),
+                                                _mm256_mul_ps(_mm256_set1_ps(m_xz - m_yz * m_xy), vz));
+            vx = _mm256_sub_ps(
+                vx,
+                _mm256_mul_ps(
+                    _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(frac_x, _mm256_set1_ps(m_Linv.x)), half)),
+                    _mm256_set1_ps(m_L.x)));
+        }
+        if (m_2d)
+        {
+            vz = _mm256_setzero_ps();
+        }
+    }
+#else
+    //! Wrap a vector into a periodic box.
+    void wrapLane(float& vx, float& vy, float& vz) const
+    {
+        if (m_periodic.z && !m_2d)
+        {
+            const float shift = std::floor(vz * m_Linv.z + float(0.5)) * m_L.z;
+            vx -= shift * m_xz;
+            vy -= shift * m_yz;
+            vz -= shift;
+        }
+        if (m_periodic.y)
+        {
+            const float shift = std::floor((vy - m_yz * vz) * m_Linv.y + float(0.5)) * m_L.y;
+            vx -= shift * m_xy;
+            vy -= shift;
+        }
+        if (m_periodic.x)
+        {
+            vx -= std::floor((vx - m_xy * vy - (m_xz - m_yz * m_xy) * vz) * m_Linv.x + float(0.5)) * m_L.x;
+        }
+        if (m_2d)
+        {
+            vz = float(0.0);
+        }
+    }
+#endif
+
+    vec3<float> m_lo;        //!< Minimum coords in the box
+    vec3<float> m_L;         //!< L precomputed (used to avoid subtractions in boundary conditions)
+    vec3<float> m_Linv;      //!< 1/L precomputed (used to avoid divisions in boundary conditions)
+    float m_xy;              //!< xy tilt factor
+    float m_xz;              //!< xz tilt factor
+    float m_yz;              //!< yz tilt factor
+    vec3<bool> m_periodic;   //!< 0/1 in each direction to tell if the box is periodic in that direction
+    bool m_2d;               //!< Specify whether box is 2D.
+};
+
+}; }; // end namespace freud::box
+
+#endif // BOX_BATCH_H
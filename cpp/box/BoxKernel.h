@@ -0,0 +1,125 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOX_KERNEL_H
+#define BOX_KERNEL_H
+
+#include <cmath>
+
+#include "VectorMath.h"
+
+/*! \file BoxKernel.h
+    \brief Box operations specialized at compile time for the box shape, dimensionality and periodicity.
+*/
+
+namespace freud { namespace box {
+
+//! Bit of a periodic mask indicating periodicity along the first lattice vector.
+constexpr unsigned int PERIODIC_X = 1;
+//! Bit of a periodic mask indicating periodicity along the second lattice vector.
+constexpr unsigned int PERIODIC_Y = 2;
+//! Bit of a periodic mask indicating periodicity along the third lattice vector.
+constexpr unsigned int PERIODIC_Z = 4;
+
+//! Box operations for inner loops, specialized for one kind of box
+/*! A BoxKernel is obtained from Box::dispatchKernel, which selects the
+ *  specialization matching the box once, so that loops over many vectors do
+ *  not check the tilt factors, dimensionality or periodic flags per vector.
+ *
+ *  Wrapping subtracts the lattice vectors multiplied by the rounded
+ *  fractional coordinates along each periodic axis, starting from the third
+ *  lattice vector so that the tilt factors are handled exactly. This only
+ *  requires multiplications and rounding, which compilers can vectorize,
+ *  rather than conversions to and from fractional coordinates and floating
+ *  point modulus operations. Wrapped vectors lie in the half-open interval
+ *  [-L/2, L/2) of fractional coordinates, like Box::wrap.
+ *
+ *  \tparam Triclinic Whether any tilt factor may be nonzero.
+ *  \tparam TwoD Whether the box is two dimensional.
+ *  \tparam PeriodicMask Bitwise or of PERIODIC_X, PERIODIC_Y and PERIODIC_Z.
+ */
+template<bool Triclinic, bool TwoD, unsigned int PeriodicMask> class BoxKernel
+{
+public:
+    static constexpr bool periodic_x = (PeriodicMask & PERIODIC_X) != 0; //!< Periodic along a_1.
+    static constexpr bool periodic_y = (PeriodicMask & PERIODIC_Y) != 0; //!< Periodic along a_2.
+    static constexpr bool periodic_z = !TwoD && (PeriodicMask & PERIODIC_Z) != 0; //!< Periodic along a_3.
+
+    //! Constructor
+    /*! \param L Box lengths.
+     *  \param Linv Inverse box lengths.
+     *  \param xy Tilt factor xy.
+     *  \param xz Tilt factor xz.
+     *  \param yz Tilt factor yz.
+     */
+    BoxKernel(const vec3<float>& L, const vec3<float>& Linv, float xy, float xz, float yz)
+        : m_L(L), m_Linv(Linv), m_xy(xy), m_xz(xz), m_yz(yz)
+    {}
+
+    //! Wrap a vector back into the box
+    vec3<float> wrap(vec3<float> v) const
+    {
+        if (periodic_z)
+        {
+            const float image = std::floor(v.z * m_Linv.z + float(0.5));
+            v.z -= image * m_L.z;
+            if (Triclinic)
+            {
+                v.x -= image * m_L.z * m_xz;
+                v.y -= image * m_L.z * m_yz;
+            }
+        }
+        if (periodic_y)
+        {
+            const float frac_y = (Triclinic && !TwoD) ? v.y - m_yz * v.z : v.y;
+            const float image = std::floor(frac_y * m_Linv.y + float(0.5));
+            v.y -= image * m_L.y;
+            if (Triclinic)
+            {
+                v.x -= image * m_L.y * m_xy;
+            }
+        }
+        if (periodic_x)
+        {
+            float frac_x = v.x;
+            if (Triclinic)
+            {
+                frac_x -= m_xy * v.y;
+                if (!TwoD)
+                {
+                    frac_x -= (m_xz - m_yz * m_xy) * v.z;
+                }
+            }
+            v.x -= std::floor(frac_x * m_Linv.x + float(0.5)) * m_L.x;
+        }
+        if (TwoD && PeriodicMask != 0)
+        {
+            v.z = float(0.0);
+        }
+        return v;
+    }
+
+    //! Compute the squared length of the wrapped vector from r_i to r_j
+    float distanceSquared(const vec3<float>& r_i, const vec3<float>& r_j) const
+    {
+        const vec3<float> r_ij = wrap(r_j - r_i);
+        return dot(r_ij, r_ij);
+    }
+
+    //! Compute the length of the wrapped vector from r_i to r_j
+    float distance(const vec3<float>& r_i, const vec3<float>& r_j) const
+    {
+        return std::sqrt(distanceSquared(r_i, r_j));
+    }
+
+private:
+    vec3<float> m_L;    //!< Box lengths
+    vec3<float> m_Linv; //!< Inverse box lengths
+    float m_xy;         //!< xy tilt factor
+    float m_xz;         //!< xz tilt factor
+    float m_yz;         //!< yz tilt factor
+};
+
+}; }; // end namespace freud::box
+
+#endif // BOX_KERNEL_H
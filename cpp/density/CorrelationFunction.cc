@@ -1,15 +1,22 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <complex>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 
 #include "CorrelationFunction.h"
+#include "FFT.h"
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
+#include "SlabDeposition.h"
 
 /*! \file CorrelationFunction.cc
     \brief Generic pairwise correlation functions.
@@ -18,7 +25,9 @@
 namespace freud { namespace density {
 
 template<typename T>
-CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : BondHistogramCompute()
+CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max, CorrelationFunctionMethod method,
+                                            float grid_spacing)
+    : BondHistogramCompute(), m_method(method), m_grid_spacing(grid_spacing)
 {
     if (bins == 0)
     {
@@ -28,6 +37,18 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
     {
         throw std::invalid_argument("CorrelationFunction requires r_max to be positive.");
     }
+    if (method != correlation_direct && method != correlation_fft)
+    {
+        throw std::invalid_argument("CorrelationFunction requires a valid method.");
+    }
+    if (grid_spacing < 0)
+    {
+        throw std::invalid_argument("CorrelationFunction requires grid_spacing to be nonnegative.");
+    }
+    if (grid_spacing == 0)
+    {
+        m_grid_spacing = r_max / float(bins);
+    }
 
     // We must construct two separate histograms, one for the counts and one
     // for the actual correlation function. The counts are used to normalize
@@ -70,6 +91,15 @@ template<typename T> void CorrelationFunction<T>::reset()
     m_local_correlation_function.reset();
 }
 
+template<typename T> void CorrelationFunction<T>::setAccumulationStrategy(util::AccumulationStrategy strategy)
+{
+    // Build the correlation function bins first, since strategies relying on
+    // atomic addition are rejected for complex values.
+    CFThreadHistogram local_correlation_function(m_correlation_function, strategy);
+    BondHistogramCompute::setAccumulationStrategy(strategy);
+    m_local_correlation_function = std::move(local_correlation_function);
+}
+
 // Define an overloaded pair of product functions to deal with complex conjugation if necessary.
 inline std::complex<double> product(std::complex<double> x, std::complex<double> y)
 {
@@ -81,6 +111,17 @@ inline double product(double x, double y)
     return x * y;
 }
 
+// Define an overloaded pair of functions to convert correlations of grids to the type of the values.
+inline void fromGrid(std::complex<double>& result, std::complex<double> x)
+{
+    result = x;
+}
+
+inline void fromGrid(double& result, std::complex<double> x)
+{
+    result = x.real();
+}
+
 template<typename T>
 void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* neighbor_query, const T* values,
                                         const vec3<float>* query_points, const T* query_values,
@@ -88,10 +129,34 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
                                         const freud::locality::NeighborList* nlist,
                                         freud::locality::QueryArgs qargs)
 {
+    if (m_method == correlation_fft)
+    {
+        if (nlist != nullptr)
+        {
+            throw std::invalid_argument("The FFT method of CorrelationFunction does not support neighbor "
+                                        "lists.");
+        }
+        // All pairs within the r_max of the histogram are correlated, so any
+        // other query would silently give a different result.
+        const bool default_mode = (qargs.mode == freud::locality::QueryType::none)
+            || (qargs.mode == freud::locality::QueryType::ball);
+        const bool default_r_max
+            = (qargs.r_max == freud::locality::DEFAULT_R_MAX) || (qargs.r_max == getBounds()[0].second);
+        if (!default_mode || !default_r_max || qargs.num_neighbors != freud::locality::DEFAULT_NUM_NEIGHBORS
+            || qargs.r_min != freud::locality::DEFAULT_R_MIN || !qargs.r_shells.empty()
+            || qargs.num_types != 0)
+        {
+            throw std::invalid_argument("The FFT method of CorrelationFunction only supports the exclude_ii "
+                                        "query argument.");
+        }
+        accumulateFFT(neighbor_query, values, query_points, query_values, n_query_points, qargs.exclude_ii);
+        return;
+    }
+
     accumulateGeneral(
         neighbor_query, query_points, n_query_points, nlist, qargs,
         [=](const freud::locality::NeighborBond& neighbor_bond) {
-            size_t value_bin = m_histogram.bin({neighbor_bond.distance});
+            size_t value_bin = m_histogram.bin(std::array<float, 1> {neighbor_bond.distance});
             m_local_histograms.increment(value_bin);
             m_local_correlation_function.increment(
                 value_bin,
@@ -99,6 +164,188 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
         });
 }
 
+template<typename T>
+void CorrelationFunction<T>::accumulateFFT(const freud::locality::NeighborQuery* neighbor_query,
+                                           const T* values, const vec3<float>* query_points,
+                                           const T* query_values, unsigned int n_query_points,
+                                           bool exclude_ii)
+{
+    const box::Box& box = neighbor_query->getBox();
+    const unsigned int n_points = neighbor_query->getNPoints();
+    const unsigned int dimensions = box.is2D() ? 2 : 3;
+    const float r_max = getBounds()[0].second;
+    const vec3<bool> box_periodic = box.getPeriodic();
+    const vec3<float> box_plane_distance = box.getNearestPlaneDistance();
+    const std::array<bool, 3> periodic {box_periodic.x, box_periodic.y, box_periodic.z};
+    const std::array<float, 3> plane_distance {box_plane_distance.x, box_plane_distance.y,
+                                               box_plane_distance.z};
+
+    // The grid spans the box along its lattice vectors. Periodic axes wrap
+    // around, and aperiodic axes are zero padded so that displacements of up
+    // to r_max do not alias.
+    std::array<size_t, 3> width {1, 1, 1};
+    std::vector<size_t> shape {1, 1, 1};
+    std::array<vec3<float>, 3> voxel_vectors;
+    for (unsigned int axis = 0; axis < dimensions; ++axis)
+    {
+        const vec3<float> lattice_vector = box.getLatticeVector(axis);
+        const float length = std::sqrt(dot(lattice_vector, lattice_vector));
+        width[axis] = std::max(size_t(1), size_t(std::ceil(length / m_grid_spacing)));
+        voxel_vectors[axis] = lattice_vector / float(width[axis]);
+        if (periodic[axis])
+        {
+            if (r_max > plane_distance[axis] / float(2.0))
+            {
+                throw std::invalid_argument("The FFT method of CorrelationFunction requires r_max to be at "
+                                            "most half the distance between opposite faces of the box "
+                                            "along periodic dimensions.");
+            }
+            shape[axis] = width[axis];
+        }
+        else
+        {
+            const auto cut = size_t(std::ceil(r_max * float(width[axis]) / plane_distance[axis]));
+            shape[axis] = util::FFT::nextPowerOfTwo(width[axis] + cut + 1);
+        }
+    }
+    const size_t grid_size = shape[0] * shape[1] * shape[2];
+
+    // Grid index of the voxel containing a point.
+    const auto voxel_of = [&](const vec3<float>& point) {
+        const vec3<float> fraction = box.makeFractional(point);
+        const std::array<float, 3> fractions {fraction.x, fraction.y, fraction.z};
+        std::array<long int, 3> voxel {0, 0, 0};
+        for (unsigned int axis = 0; axis < dimensions; ++axis)
+        {
+            const auto w = long(width[axis]);
+            const auto v = long(std::floor(fractions[axis] * float(w)));
+            voxel[axis] = periodic[axis] ? ((v % w) + w) % w : std::max(0L, std::min(v, w - 1));
+        }
+        return voxel;
+    };
+    const auto grid_index = [&](const std::array<long int, 3>& voxel) {
+        std::array<size_t, 3> index;
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            const auto n = long(shape[axis]);
+            index[axis] = size_t(((voxel[axis] % n) + n) % n);
+        }
+        return (index[0] * shape[1] + index[1]) * shape[2] + index[2];
+    };
+
+    // Deposit the values and the number of points of both sets of points,
+    // with each slab of rows of the grid filled by a single thread.
+    const size_t row_size = shape[1] * shape[2];
+    const util::SlabDeposition<std::complex<double>> slabs(shape[0], row_size, 0, false);
+    const auto deposit = [&](const vec3<float>* points, unsigned int n, const T* point_values,
+                             util::ManagedArray<std::complex<double>>& value_grid,
+                             util::ManagedArray<std::complex<double>>& count_grid) {
+        std::vector<size_t> indices(n);
+        util::forLoopWrapper(0, n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                indices[i] = grid_index(voxel_of(points[i]));
+            }
+        });
+        const auto row_of = [&](size_t i) { return indices[i] / row_size; };
+        slabs.compute(value_grid, n, row_of, [&](size_t i, const auto& writer) {
+            writer.deposit(indices[i] / row_size, indices[i] % row_size,
+                           std::complex<double>(point_values[i]));
+        });
+        slabs.compute(count_grid, n, row_of, [&](size_t i, const auto& writer) {
+            writer.deposit(indices[i] / row_size, indices[i] % row_size, std::complex<double>(1.0));
+        });
+    };
+    const bool same_points = (values == query_values) && (n_points == n_query_points)
+        && (query_points == neighbor_query->getPoints());
+    util::ManagedArray<std::complex<double>> value_grid(grid_size);
+    util::ManagedArray<std::complex<double>> count_grid(grid_size);
+    util::ManagedArray<std::complex<double>> query_value_grid;
+    util::ManagedArray<std::complex<double>> query_count_grid;
+    deposit(neighbor_query->getPoints(), n_points, values, value_grid, count_grid);
+    if (!same_points)
+    {
+        query_value_grid.prepare(grid_size);
+        query_count_grid.prepare(grid_size);
+        deposit(query_points, n_query_points, query_values, query_value_grid, query_count_grid);
+    }
+
+    // Correlate the grids, C(d) = sum_x conj(P(x)) Q(x + d), whose transform
+    // is conj(P(k)) Q(k).
+    util::transformGrid(value_grid.get(), shape, false);
+    util::transformGrid(count_grid.get(), shape, false);
+    if (!same_points)
+    {
+        util::transformGrid(query_value_grid.get(), shape, false);
+        util::transformGrid(query_count_grid.get(), shape, false);
+    }
+    const util::ManagedArray<std::complex<double>>& query_value_transform
+        = same_points ? value_grid : query_value_grid;
+    const util::ManagedArray<std::complex<double>>& query_count_transform
+        = same_points ? count_grid : query_count_grid;
+    util::forLoopWrapper(0, grid_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            value_grid[i] = std::conj(value_grid[i]) * query_value_transform[i];
+            count_grid[i] = std::conj(count_grid[i]) * query_count_transform[i];
+        }
+    });
+    util::transformGrid(value_grid.get(), shape, true);
+    util::transformGrid(count_grid.get(), shape, true);
+
+    // Remove the pairs of each point with the query point of the same index.
+    if (exclude_ii)
+    {
+        for (unsigned int i = 0; i < std::min(n_points, n_query_points); ++i)
+        {
+            const std::array<long int, 3> point_voxel = voxel_of((*neighbor_query)[i]);
+            const std::array<long int, 3> query_point_voxel = voxel_of(query_points[i]);
+            const size_t index = grid_index({query_point_voxel[0] - point_voxel[0],
+                                             query_point_voxel[1] - point_voxel[1],
+                                             query_point_voxel[2] - point_voxel[2]});
+            value_grid[index] -= std::complex<double>(product(values[i], query_values[i]));
+            count_grid[index] -= 1.0;
+        }
+    }
+
+    // Bin the correlation of each displacement by its length.
+    util::forLoopWrapper(0, grid_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto count = std::llround(count_grid[i].real());
+            if (count <= 0)
+            {
+                continue;
+            }
+            const std::array<size_t, 3> index {i / (shape[1] * shape[2]), (i / shape[2]) % shape[1],
+                                               i % shape[2]};
+            vec3<float> displacement(0, 0, 0);
+            for (unsigned int axis = 0; axis < dimensions; ++axis)
+            {
+                const auto d = (index[axis] <= shape[axis] / 2) ? long(index[axis])
+                                                                 : long(index[axis]) - long(shape[axis]);
+                displacement += float(d) * voxel_vectors[axis];
+            }
+            const size_t value_bin
+                = m_histogram.bin(std::array<float, 1> {std::sqrt(dot(displacement, displacement))});
+            if (value_bin == util::Axis::OVERFLOW_BIN)
+            {
+                continue;
+            }
+            T value;
+            fromGrid(value, value_grid[i]);
+            m_local_histograms.increment(value_bin, static_cast<unsigned int>(count));
+            m_local_correlation_function.increment(value_bin, value);
+        }
+    });
+
+    m_box = box;
+    m_frame_counter++;
+    m_n_points = n_points;
+    m_n_query_points = n_query_points;
+    m_reduce = true;
+}
+
 template class CorrelationFunction<std::complex<double>>;
 template class CorrelationFunction<double>;
 
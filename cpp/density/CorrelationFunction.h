@@ -18,6 +18,13 @@
 
 namespace freud { namespace density {
 
+//! Methods for computing correlation functions.
+typedef enum
+{
+    correlation_direct = 1, //!< Accumulate the product of the values of every bond.
+    correlation_fft = 2     //!< Correlate values deposited on a grid with fast Fourier transforms.
+} CorrelationFunctionMethod;
+
 //! Computes the pairwise correlation function <p*q>(r) between two sets of points with associated values p
 //! and q.
 /*! Two sets of points and two sets of values associated with those
@@ -42,12 +49,31 @@ namespace freud { namespace density {
     for both points and ref_points, we omit accumulating the
     self-correlation value in the first bin.
 
+    <b>FFT method:</b><br>
+    The number of bonds within r_max grows as r_max^d, which makes the
+    direct method expensive for correlations extending over a large part
+    of the box. The FFT method instead deposits the values (and the
+    number of points) onto a grid spanning the box, correlates the grids
+    of the points and query points with fast Fourier transforms, and bins
+    the correlation of each grid displacement by its length. Distances are
+    thereby rounded to displacements between voxel centers, so the result
+    approximates the direct method with an error of the order of the grid
+    spacing. Aperiodic dimensions are zero padded. All pairs of points
+    within r_max are correlated, so neighbor lists and query arguments other
+    than exclude_ii are not supported.
+
 */
 template<typename T> class CorrelationFunction : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    CorrelationFunction(unsigned int bins, float r_max);
+    /*! \param bins Number of bins.
+     *  \param r_max Maximum distance.
+     *  \param method Method computing the correlation function.
+     *  \param grid_spacing Grid spacing of the FFT method, or 0 to use the bin width.
+     */
+    CorrelationFunction(unsigned int bins, float r_max, CorrelationFunctionMethod method = correlation_direct,
+                        float grid_spacing = 0);
 
     //! Destructor
     ~CorrelationFunction() override = default;
@@ -55,6 +81,9 @@ public:
     //! Reset the PCF array to all zeros
     void reset() override;
 
+    //! Set the strategy for accumulating the counts and correlation function across threads.
+    void setAccumulationStrategy(util::AccumulationStrategy strategy) override;
+
     //! accumulate the correlation function
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const T* values,
                     const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
@@ -70,10 +99,29 @@ public:
         return reduceAndReturn(m_correlation_function.getBinCounts());
     }
 
+    //! Get the method computing the correlation function.
+    CorrelationFunctionMethod getMethod() const
+    {
+        return m_method;
+    }
+
+    //! Get the grid spacing of the FFT method.
+    float getGridSpacing() const
+    {
+        return m_grid_spacing;
+    }
+
 private:
+    //! Accumulate the correlation function of all pairs within r_max with the FFT method.
+    void accumulateFFT(const freud::locality::NeighborQuery* neighbor_query, const T* values,
+                       const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
+                       bool exclude_ii);
+
     // Typedef thread local histogram type for use in code.
     using CFThreadHistogram = typename util::Histogram<T>::ThreadLocalHistogram;
 
+    CorrelationFunctionMethod m_method;             //!< Method computing the correlation function.
+    float m_grid_spacing;                           //!< Grid spacing of the FFT method.
     util::Histogram<T> m_correlation_function;      //!< The correlation function
     CFThreadHistogram m_local_correlation_function; //!< Thread local copy of the correlation function
 };
@@ -1,10 +1,16 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <vector>
 
+#include "FFT.h"
 #include "GaussianDensity.h"
+#include "SlabDeposition.h"
 
 /*! \file GaussianDensity.cc
     \brief Routines for computing Gaussian smeared densities from points.
@@ -12,8 +18,60 @@
 
 namespace freud { namespace density {
 
-GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma)
-    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_has_computed(false)
+namespace {
+
+//! One-dimensional factors of a point's Gaussian along one axis of an orthorhombic box.
+struct AxisWeights
+{
+    std::vector<unsigned int> bins; //!< Bin indices along the axis within the cutoff.
+    std::vector<float> dist_sq;     //!< Squared wrapped distances from the point to the bin centers.
+    std::vector<float> weights;     //!< Unnormalized Gaussian factors exp(-d^2 / (2 sigma^2)).
+
+    //! Compute the factors for the bins bin - bin_cut to bin + bin_cut.
+    /*! \param box Orthorhombic box, used to wrap distances along the axis.
+     *  \param axis Unit vector of the axis.
+     *  \param coord Coordinate of the point along the axis.
+     *  \param bin Bin containing the point.
+     *  \param bin_cut Number of bins within the cutoff on either side.
+     *  \param width Number of bins along the axis.
+     *  \param grid_size Size of a bin along the axis.
+     *  \param L Box length along the axis.
+     *  \param periodic Whether the box is periodic along the axis.
+     *  \param inv_two_sigmasq 1 / (2 sigma^2).
+     */
+    void compute(const box::Box& box, const vec3<float>& axis, float coord, int bin, int bin_cut,
+                 unsigned int width, float grid_size, float L, bool periodic, float inv_two_sigmasq)
+    {
+        bins.clear();
+        dist_sq.clear();
+        weights.clear();
+        for (int i = bin - bin_cut; i <= bin + bin_cut; i++)
+        {
+            if (!periodic && (i < 0 || i >= int(width)))
+            {
+                continue;
+            }
+            const float d = (grid_size * static_cast<float>(i)) + (grid_size / float(2.0)) - coord
+                - (L / float(2.0));
+            // Wrapping an orthorhombic box is separable, so wrapping each
+            // component alone gives the same distances as wrapping the vector.
+            const float wrapped = dot(axis, box.wrap(axis * d));
+            const float d_sq = wrapped * wrapped;
+            bins.push_back(static_cast<unsigned int>(((i % int(width)) + int(width)) % int(width)));
+            dist_sq.push_back(d_sq);
+            weights.push_back(std::exp(-d_sq * inv_two_sigmasq));
+        }
+    }
+};
+
+} // namespace
+
+constexpr float GaussianDensity::FFT_MIN_SIGMA_BINS;
+constexpr double GaussianDensity::DIRECT_COST_PER_VOXEL;
+
+GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma,
+                                 GaussianDensityMethod method)
+    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_method(method), m_has_computed(false)
 {
     if (r_max <= 0)
     {
@@ -21,6 +79,174 @@ GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float si
     }
 }
 
+bool GaussianDensity::preferFFT(unsigned int n_points, const vec3<float>& grid_size,
+                                const vec3<int>& bin_cut) const
+{
+    // Cloud-in-cell assignment interpolates the Gaussian linearly between
+    // voxels, which is only accurate if it spans several voxels.
+    const float min_sigma = FFT_MIN_SIGMA_BINS * std::max(grid_size.x, std::max(grid_size.y, grid_size.z));
+    if (m_box.isTriclinic() || m_sigma < min_sigma)
+    {
+        return false;
+    }
+    const double direct_cost = DIRECT_COST_PER_VOXEL * double(n_points) * double(2 * bin_cut.x + 1)
+        * double(2 * bin_cut.y + 1) * double(2 * bin_cut.z + 1);
+    // Forward and inverse transforms of the grid, and of the kernel unless it is cached.
+    const std::vector<size_t> shape = getFFTShape(bin_cut);
+    const double num_transforms = (m_kernel_box == m_box && m_kernel_shape == shape) ? 2 : 3;
+    const double fft_cost = num_transforms * util::transformGridCost(shape);
+    return fft_cost < direct_cost;
+}
+
+std::vector<size_t> GaussianDensity::getFFTShape(const vec3<int>& bin_cut) const
+{
+    // Aperiodic axes are padded so that the circular convolution does not
+    // wrap around. Deposits extend up to bin_cut + 1 bins outside the grid
+    // and the kernel extends bin_cut bins on either side.
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const auto padded = [](unsigned int width, int cut, bool periodic_axis) {
+        return periodic_axis ? size_t(width) : util::FFT::nextPowerOfTwo(width + 2 * size_t(cut) + 3);
+    };
+    return {padded(m_width.x, bin_cut.x, periodic.x), padded(m_width.y, bin_cut.y, periodic.y),
+            padded(m_width.z, bin_cut.z, periodic.z || m_box.is2D())};
+}
+
+void GaussianDensity::computeFFT(const freud::locality::NeighborQuery* nq, const float* values,
+                                 const vec3<float>& grid_size, const vec3<int>& bin_cut, float normalization)
+{
+    if (m_box.isTriclinic())
+    {
+        throw std::invalid_argument("The FFT method of GaussianDensity requires an orthorhombic box.");
+    }
+    const std::vector<size_t> shape = getFFTShape(bin_cut);
+    const size_t n_grid = shape[0] * shape[1] * shape[2];
+    const vec3<float> L = m_box.getL();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const bool is2D = m_box.is2D();
+    const vec3<int> width(m_width.x, m_width.y, m_width.z);
+
+    // Map a (possibly out of range) bin index to its position in the padded grid.
+    const auto grid_index = [&](int i, int j, int k) {
+        const auto wrap_axis = [](int bin, size_t n) { return size_t(((bin % int(n)) + int(n)) % int(n)); };
+        return (wrap_axis(i, shape[0]) * shape[1] + wrap_axis(j, shape[1])) * shape[2]
+            + wrap_axis(k, shape[2]);
+    };
+
+    // The transform of the kernel only depends on the box and grid, so it is
+    // reused across computes. Since the kernel is symmetric, it is real.
+    if (m_kernel_box != m_box || m_kernel_shape != shape)
+    {
+        std::vector<std::complex<float>> kernel(n_grid, std::complex<float>(0));
+        const float r_max_sq = m_r_max * m_r_max;
+        const float sigmasq = m_sigma * m_sigma;
+        for (int di = -bin_cut.x; di <= bin_cut.x; ++di)
+        {
+            for (int dj = -bin_cut.y; dj <= bin_cut.y; ++dj)
+            {
+                for (int dk = -bin_cut.z; dk <= bin_cut.z; ++dk)
+                {
+                    const vec3<float> delta = m_box.wrap(vec3<float>(
+                        grid_size.x * static_cast<float>(di), grid_size.y * static_cast<float>(dj),
+                        grid_size.z * static_cast<float>(dk)));
+                    const float r_sq = dot(delta, delta);
+                    if (r_sq < r_max_sq)
+                    {
+                        kernel[grid_index(di, dj, dk)]
+                            += normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
+                    }
+                }
+            }
+        }
+        util::transformGrid(kernel.data(), shape, false);
+        m_kernel_transform.resize(n_grid);
+        for (size_t i = 0; i < n_grid; ++i)
+        {
+            m_kernel_transform[i] = kernel[i].real();
+        }
+        m_kernel_box = m_box;
+        m_kernel_shape = shape;
+    }
+
+    // Deposit the points on the grid with cloud-in-cell assignment.
+    util::BinAccumulator<float> deposit(n_grid, m_accumulation_strategy);
+    util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const vec3<float> point = (*nq)[idx];
+            const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+            // Fractional bin coordinates relative to the voxel centers.
+            const float u = (point.x + L.x / float(2.0)) / grid_size.x - float(0.5);
+            const float v = (point.y + L.y / float(2.0)) / grid_size.y - float(0.5);
+            const float w = is2D ? float(0.0) : (point.z + L.z / float(2.0)) / grid_size.z - float(0.5);
+            const vec3<int> bin(int(std::floor(u)), int(std::floor(v)), int(std::floor(w)));
+            const vec3<float> frac(u - float(bin.x), v - float(bin.y), w - float(bin.z));
+
+            for (int a = 0; a <= 1; ++a)
+            {
+                const int i = bin.x + a;
+                const float weight_x = a ? frac.x : float(1.0) - frac.x;
+                if (!periodic.x && (i < -bin_cut.x - 1 || i > width.x + bin_cut.x))
+                {
+                    continue;
+                }
+                for (int b = 0; b <= 1; ++b)
+                {
+                    const int j = bin.y + b;
+                    const float weight_y = b ? frac.y : float(1.0) - frac.y;
+                    if (!periodic.y && (j < -bin_cut.y - 1 || j > width.y + bin_cut.y))
+                    {
+                        continue;
+                    }
+                    for (int c = 0; c <= (is2D ? 0 : 1); ++c)
+                    {
+                        const int k = bin.z + c;
+                        const float weight_z = is2D ? float(1.0) : (c ? frac.z : float(1.0) - frac.z);
+                        if (!periodic.z && !is2D && (k < -bin_cut.z - 1 || k > width.z + bin_cut.z))
+                        {
+                            continue;
+                        }
+                        deposit.add(grid_index(i, j, k), value * weight_x * weight_y * weight_z);
+                    }
+                }
+            }
+        }
+    });
+    util::ManagedArray<float> deposit_array(n_grid);
+    deposit.reduceInto(deposit_array);
+
+    // Convolve the deposited values with the kernel.
+    std::vector<std::complex<float>> grid(n_grid);
+    util::forLoopWrapper(0, n_grid, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            grid[i] = std::complex<float>(deposit_array[i], 0);
+        }
+    });
+    util::transformGrid(grid.data(), shape, false);
+    util::forLoopWrapper(0, n_grid, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            grid[i] *= m_kernel_transform[i];
+        }
+    });
+    util::transformGrid(grid.data(), shape, true);
+
+    util::forLoopWrapper(0, m_width.x, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (size_t j = 0; j < m_width.y; ++j)
+            {
+                for (size_t k = 0; k < m_width.z; ++k)
+                {
+                    m_density_array[(i * m_width.y + j) * m_width.z + k]
+                        = grid[(i * shape[1] + j) * shape[2] + k].real();
+                }
+            }
+        }
+    });
+}
+
 //! Get a reference to the last computed Density
 const util::ManagedArray<float>& GaussianDensity::getDensity() const
 {
@@ -59,7 +285,6 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
     }
 
     m_density_array.prepare({m_width.x, m_width.y, m_width.z});
-    util::ThreadStorage<float> local_bin_counts({m_width.x, m_width.y, m_width.z});
 
     // set up some constants first
     const float Lx = m_box.getLx();
@@ -81,82 +306,186 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
     const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
     const float normalization = std::pow(normalization_base, dimensions);
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
+    const vec3<float> grid_size(grid_size_x, grid_size_y, grid_size_z);
+    const vec3<int> bin_cut(bin_cut_x, bin_cut_y, bin_cut_z);
+    if (m_method == method_fft || (m_method == method_automatic && preferFFT(n_points, grid_size, bin_cut)))
+    {
+        computeFFT(nq, values, grid_size, bin_cut, normalization);
+        return;
+    }
+
+    // Scratch space of the separable path, reused for all points of a thread.
+    struct SeparableScratch
+    {
+        AxisWeights x_weights;
+        AxisWeights y_weights;
+        AxisWeights z_weights;
+        std::vector<float> row;
+        std::vector<size_t> z_runs;
+    };
+    tbb::enumerable_thread_specific<SeparableScratch> separable_scratch;
+
+    // In an orthorhombic box the Gaussian factorizes into one factor per
+    // axis, so only 3 * (2 * bin_cut + 1) exponentials are needed per point
+    // instead of one per voxel in the cutoff cube.
+    const float inv_two_sigmasq = float(1.0) / (float(2.0) * sigmasq);
+    const auto deposit_separable = [&](size_t idx, const auto& writer) {
+        SeparableScratch& scratch = separable_scratch.local();
+        AxisWeights& x_weights = scratch.x_weights;
+        AxisWeights& y_weights = scratch.y_weights;
+        AxisWeights& z_weights = scratch.z_weights;
+        std::vector<float>& row = scratch.row;
+        std::vector<size_t>& z_runs = scratch.z_runs;
+
+        const vec3<float> point = (*nq)[idx];
+        const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+        const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+        const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+        x_weights.compute(m_box, vec3<float>(1, 0, 0), point.x, bin_x, bin_cut_x, m_width.x, grid_size_x, Lx,
+                          periodic.x, inv_two_sigmasq);
+        y_weights.compute(m_box, vec3<float>(0, 1, 0), point.y, bin_y, bin_cut_y, m_width.y, grid_size_y, Ly,
+                          periodic.y, inv_two_sigmasq);
+        z_weights.compute(m_box, vec3<float>(0, 0, 1), point.z, bin_z, bin_cut_z, m_width.z, grid_size_z, Lz,
+                          periodic.z, inv_two_sigmasq);
+
+        // Split the z bins, which are contiguous in the grid, into runs of
+        // consecutive indices (periodic wrapping starts a new run).
+        const size_t n_z = z_weights.bins.size();
+        z_runs.clear();
+        for (size_t k = 0; k < n_z; ++k)
         {
-            const vec3<float> point = (*nq)[idx];
-            const float value = (values != nullptr) ? values[idx] : 1.0f;
+            if (k == 0 || z_weights.bins[k] != z_weights.bins[k - 1] + 1)
+            {
+                z_runs.push_back(k);
+            }
+        }
+        z_runs.push_back(n_z);
+        row.resize(n_z);
+
+        for (size_t i = 0; i < x_weights.bins.size(); ++i)
+        {
+            for (size_t j = 0; j < y_weights.bins.size(); ++j)
+            {
+                const float r_sq_xy = x_weights.dist_sq[i] + y_weights.dist_sq[j];
+                if (r_sq_xy >= r_max_sq)
+                {
+                    continue;
+                }
+                const float weight_xy = value * normalization * x_weights.weights[i] * y_weights.weights[j];
+
+                // Outer product of the x and y factors with the z factors,
+                // limited to the spherical cutoff.
+                for (size_t k = 0; k < n_z; ++k)
+                {
+                    row[k] = (r_sq_xy + z_weights.dist_sq[k] < r_max_sq) ? weight_xy * z_weights.weights[k]
+                                                                        : float(0.0);
+                }
+
+                const size_t offset = size_t(y_weights.bins[j]) * m_width.z;
+                for (size_t run = 0; run + 1 < z_runs.size(); ++run)
+                {
+                    const size_t first = z_runs[run];
+                    writer.deposit(x_weights.bins[i], offset + z_weights.bins[first], &row[first],
+                                   z_runs[run + 1] - first);
+                }
+            }
+        }
+    };
 
-            // Find which bin the particle is in
-            int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
-            int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
-            int bin_z = int((point.z + Lz / float(2.0)) / grid_size_z);
+    // Triclinic boxes evaluate the Gaussian of the wrapped distance to every voxel.
+    const auto deposit_exact = [&](size_t idx, const auto& writer) {
+        const vec3<float> point = (*nq)[idx];
+        const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+        // Find which bin the particle is in
+        int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+        int bin_z = int((point.z + Lz / float(2.0)) / grid_size_z);
+
+        // In 2D, only loop over the z=0 plane
+        if (m_box.is2D())
+        {
+            bin_z = 0;
+        }
 
-            // In 2D, only loop over the z=0 plane
-            if (m_box.is2D())
+        // Reject bins that are outside the box in aperiodic directions
+        // Only evaluate over bins that are within the cutoff
+        for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+        {
+            if (!periodic.z && (k < 0 || k >= int(m_width.z)))
             {
-                bin_z = 0;
+                continue;
             }
+            const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
+                - (Lz / float(2.0));
 
-            // Reject bins that are outside the box in aperiodic directions
-            // Only evaluate over bins that are within the cutoff
-            for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+            for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
             {
-                if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                if (!periodic.y && (j < 0 || j >= int(m_width.y)))
                 {
                     continue;
                 }
-                const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
-                    - (Lz / float(2.0));
+                const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0)) - point.y
+                    - (Ly / float(2.0));
 
-                for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+                for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
                 {
-                    if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                    if (!periodic.x && (i < 0 || i >= int(m_width.x)))
                     {
                         continue;
                     }
-                    const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
-                        - point.y - (Ly / float(2.0));
+                    const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0))
+                        - point.x - (Lx / float(2.0));
 
-                    for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
-                    {
-                        if (!periodic.x && (i < 0 || i >= int(m_width.x)))
-                        {
-                            continue;
-                        }
-                        const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0))
-                            - point.x - (Lx / float(2.0));
+                    // Calculate the distance from the particle to the grid cell
+                    const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
 
-                        // Calculate the distance from the particle to the grid cell
-                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                    const float r_sq = dot(delta, delta);
 
-                        const float r_sq = dot(delta, delta);
+                    // Check to see if this distance is within the specified r_max
+                    if (r_sq < r_max_sq)
+                    {
+                        // Evaluate the gaussian
+                        const float gaussian
+                            = value * normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
 
-                        // Check to see if this distance is within the specified r_max
-                        if (r_sq < r_max_sq)
-                        {
-                            // Evaluate the gaussian
-                            const float gaussian
-                                = value * normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
-
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
-                            const unsigned int nj = (j + m_width.y) % m_width.y;
-                            const unsigned int nk = (k + m_width.z) % m_width.z;
-
-                            // Store the gaussian contribution
-                            local_bin_counts.local()(ni, nj, nk) += gaussian;
-                        }
+                        // Assure that out of range indices are corrected for storage
+                        // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                        const unsigned int ni = (i + m_width.x) % m_width.x;
+                        const unsigned int nj = (j + m_width.y) % m_width.y;
+                        const unsigned int nk = (k + m_width.z) % m_width.z;
+
+                        // Store the gaussian contribution
+                        writer.deposit(ni, nj * m_width.z + nk, gaussian);
                     }
                 }
             }
         }
-    });
+    };
 
-    // Parallel reduction over thread storage
-    local_bin_counts.reduceInto(m_density_array);
+    // Each thread deposits onto its own slabs of rows along x (unless the
+    // cutoff is too wide to give every thread a slab).
+    const auto row_of = [&](size_t idx) {
+        const int bin_x = int(((*nq)[idx].x + Lx / float(2.0)) / grid_size_x);
+        return size_t(periodic.x ? ((bin_x % int(m_width.x)) + int(m_width.x)) % int(m_width.x)
+                                 : std::max(0, std::min(bin_x, int(m_width.x) - 1)));
+    };
+    const auto deposit_points = [&](const auto& deposit_point) {
+        util::depositOnGrid(m_density_array, m_width.x, size_t(m_width.y) * m_width.z, size_t(bin_cut_x),
+                            periodic.x, n_points, row_of, deposit_point);
+    };
+
+    if (m_box.isTriclinic())
+    {
+        deposit_points(deposit_exact);
+    }
+    else
+    {
+        deposit_points(deposit_separable);
+    }
 }
 
 }; }; // end namespace freud::density
@@ -4,10 +4,12 @@
 #ifndef GAUSSIAN_DENSITY_H
 #define GAUSSIAN_DENSITY_H
 
+#include <vector>
+
+#include "BinAccumulator.h"
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
-#include "ThreadStorage.h"
 #include "VectorMath.h"
 
 /*! \file GaussianDensity.h
@@ -16,16 +18,42 @@
 
 namespace freud { namespace density {
 
+//! Methods for computing Gaussian densities.
+typedef enum
+{
+    method_automatic = 0, //!< Choose the faster method from a cost estimate.
+    method_direct = 1,    //!< Evaluate the Gaussian of each point on every voxel within r_max.
+    method_fft = 2        //!< Deposit points on the grid and convolve with the Gaussian using FFTs.
+} GaussianDensityMethod;
+
 //! Computes the density of a system on a grid.
 /*! Replaces particle positions with a gaussian and calculates the
         contribution from the grid based upon the distance of the grid cell
         from the center of the Gaussian.
+
+        For large sigma relative to the voxel size, the number of voxels
+        within r_max of each point grows quickly. The FFT method instead
+        deposits the points on the grid with cloud-in-cell assignment and
+        convolves the grid with the Gaussian (sampled on the grid and
+        truncated at r_max) in Fourier space, at a cost independent of sigma.
+        Since cloud-in-cell assignment interpolates the Gaussian linearly
+        between voxels, the results agree with the direct method up to a
+        relative error of order (grid size / sigma)^2. The FFT method requires
+        an orthorhombic box, and is only chosen automatically if sigma spans at
+        least FFT_MIN_SIGMA_BINS voxels and its estimated cost is lower.
 */
 class GaussianDensity
 {
 public:
+    //! Minimum sigma, in voxels, for which the FFT method is chosen automatically.
+    static constexpr float FFT_MIN_SIGMA_BINS = 4;
+
+    //! Cost of evaluating one voxel with the direct method, relative to a radix-2 butterfly.
+    static constexpr double DIRECT_COST_PER_VOXEL = 0.5;
+
     //! Constructor
-    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma);
+    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma,
+                    GaussianDensityMethod method = method_direct);
 
     // Destructor
     ~GaussianDensity() = default;
@@ -48,6 +76,26 @@ public:
         return m_r_max;
     }
 
+    //! Get the method used to compute the density.
+    GaussianDensityMethod getMethod() const
+    {
+        return m_method;
+    }
+
+    //! Get the strategy for accumulating the deposited points of the FFT method across threads.
+    util::AccumulationStrategy getAccumulationStrategy() const
+    {
+        return m_accumulation_strategy;
+    }
+
+    //! Set the strategy for accumulating the deposited points of the FFT method across threads.
+    /*! By default the strategy is chosen automatically (see BinAccumulator).
+     */
+    void setAccumulationStrategy(util::AccumulationStrategy strategy)
+    {
+        m_accumulation_strategy = strategy;
+    }
+
     //! Compute the density.
     void compute(const freud::locality::NeighborQuery* nq, const float* values = nullptr);
 
@@ -57,13 +105,30 @@ public:
     vec3<unsigned int> getWidth();
 
 private:
-    box::Box m_box;             //!< Simulation box containing the points.
-    vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
-    float m_r_max;              //!< Max distance at which to compute density.
-    float m_sigma;              //!< Gaussian width sigma.
-    bool m_has_computed;        //!< Tracks whether a call to compute has been made.
+    //! Whether the FFT method is estimated to be faster than the direct method.
+    bool preferFFT(unsigned int n_points, const vec3<float>& grid_size, const vec3<int>& bin_cut) const;
+
+    //! Get the shape of the padded grid used by the FFT method.
+    std::vector<size_t> getFFTShape(const vec3<int>& bin_cut) const;
+
+    //! Compute the density with the FFT method.
+    void computeFFT(const freud::locality::NeighborQuery* nq, const float* values,
+                    const vec3<float>& grid_size, const vec3<int>& bin_cut, float normalization);
+
+    box::Box m_box;                 //!< Simulation box containing the points.
+    vec3<unsigned int> m_width;     //!< Number of bins in the grid in each dimension.
+    float m_r_max;                  //!< Max distance at which to compute density.
+    float m_sigma;                  //!< Gaussian width sigma.
+    GaussianDensityMethod m_method; //!< Method used to compute the density.
+    bool m_has_computed;            //!< Tracks whether a call to compute has been made.
+    util::AccumulationStrategy m_accumulation_strategy {
+        util::AccumulationStrategy::automatic}; //!< Strategy for depositing points (FFT method).
 
     util::ManagedArray<float> m_density_array; //! Computed density array.
+
+    box::Box m_kernel_box;                 //!< Box for which the kernel transform was computed.
+    std::vector<size_t> m_kernel_shape;    //!< Padded grid shape of the kernel transform.
+    std::vector<float> m_kernel_transform; //!< Fourier transform of the Gaussian kernel.
 };
 
 }; }; // end namespace freud::density
@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "LocalDensity.h"
 #include "NeighborComputeFunctional.h"
 
@@ -11,53 +14,85 @@
 namespace freud { namespace density {
 
 LocalDensity::LocalDensity(float r_max, float diameter)
-    : m_box(box::Box()), m_r_max(r_max), m_diameter(diameter)
+    : m_box(box::Box()), m_r_max(r_max), m_r_maxs {r_max}, m_multiple_radii(false), m_diameter(diameter)
 {}
 
+LocalDensity::LocalDensity(std::vector<float> r_maxs, float diameter)
+    : m_box(box::Box()), m_r_max(0), m_r_maxs(std::move(r_maxs)), m_multiple_radii(true),
+      m_diameter(diameter)
+{
+    if (m_r_maxs.empty())
+    {
+        throw std::invalid_argument("LocalDensity requires at least one r_max.");
+    }
+    if (std::any_of(m_r_maxs.begin(), m_r_maxs.end(), [](float r_max) { return r_max <= 0; }))
+    {
+        throw std::invalid_argument("LocalDensity requires all r_max values to be positive.");
+    }
+    m_r_max = *std::max_element(m_r_maxs.begin(), m_r_maxs.end());
+}
+
 void LocalDensity::compute(const freud::locality::NeighborQuery* neighbor_query,
                            const vec3<float>* query_points, unsigned int n_query_points,
                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
 {
     m_box = neighbor_query->getBox();
 
-    m_density_array.prepare(n_query_points);
-    m_num_neighbors_array.prepare(n_query_points);
+    const size_t num_radii = m_r_maxs.size();
+    if (m_multiple_radii)
+    {
+        m_density_array.prepare({n_query_points, num_radii});
+        m_num_neighbors_array.prepare({n_query_points, num_radii});
+    }
+    else
+    {
+        m_density_array.prepare(n_query_points);
+        m_num_neighbors_array.prepare(n_query_points);
+    }
+
+    // local density is area (volume) of particles divided by the area of the circle (sphere)
+    std::vector<float> volumes(num_radii);
+    for (size_t k = 0; k < num_radii; ++k)
+    {
+        const float r_max = m_r_maxs[k];
+        const float area = M_PI * r_max * r_max;
+        const float volume = static_cast<float>(4.0 / 3.0 * M_PI) * r_max * r_max * r_max;
+        volumes[k] = m_box.is2D() ? area : volume;
+    }
 
-    const float area = M_PI * m_r_max * m_r_max;
-    const float volume = static_cast<float>(4.0 / 3.0 * M_PI) * m_r_max * m_r_max * m_r_max;
     // compute the local density
     freud::locality::loopOverNeighborsIterator(
         neighbor_query, query_points, n_query_points, qargs, nlist,
-        [=](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            float num_neighbors = 0;
+        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+            // The counts of all radii are accumulated locally and written once.
+            thread_local std::vector<float> num_neighbors;
+            num_neighbors.assign(num_radii, 0);
             for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
             {
-                // count particles that are fully in the r_max sphere
-                if (nb.distance < (m_r_max - m_diameter / float(2.0)))
-                {
-                    num_neighbors += float(1.0);
-                }
-                else
+                for (size_t k = 0; k < num_radii; ++k)
                 {
-                    // partially count particles that intersect the r_max sphere
-                    // this is not particularly accurate for a single particle, but works well on average for
-                    // lots of them. It smooths out the neighbor count distributions and avoids noisy spikes
-                    // that obscure data
-                    num_neighbors
-                        += float(1.0) + (m_r_max - (nb.distance + m_diameter / float(2.0))) / m_diameter;
-                }
-                m_num_neighbors_array[i] = num_neighbors;
-                if (m_box.is2D())
-                {
-                    // local density is area of particles divided by the area of the circle
-                    m_density_array[i] = m_num_neighbors_array[i] / area;
-                }
-                else
-                {
-                    // local density is volume of particles divided by the volume of the sphere
-                    m_density_array[i] = m_num_neighbors_array[i] / volume;
+                    const float r_max = m_r_maxs[k];
+                    // count particles that are fully in the r_max sphere
+                    if (nb.distance < (r_max - m_diameter / float(2.0)))
+                    {
+                        num_neighbors[k] += float(1.0);
+                    }
+                    else if (nb.distance < (r_max + m_diameter / float(2.0)))
+                    {
+                        // partially count particles that intersect the r_max sphere
+                        // this is not particularly accurate for a single particle, but works well on average
+                        // for lots of them. It smooths out the neighbor count distributions and avoids noisy
+                        // spikes that obscure data
+                        num_neighbors[k]
+                            += float(1.0) + (r_max - (nb.distance + m_diameter / float(2.0))) / m_diameter;
+                    }
                 }
             }
+            for (size_t k = 0; k < num_radii; ++k)
+            {
+                m_num_neighbors_array[i * num_radii + k] = num_neighbors[k];
+                m_density_array[i * num_radii + k] = num_neighbors[k] / volumes[k];
+            }
         });
 }
 
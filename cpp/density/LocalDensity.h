@@ -4,6 +4,8 @@
 #ifndef LOCAL_DENSITY_H
 #define LOCAL_DENSITY_H
 
+#include <vector>
+
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
@@ -17,7 +19,10 @@
 namespace freud { namespace density {
 
 //! Compute the local density at each point
-/*!
+/*! The density may be computed for several radii at once. The neighbors of
+ *  each query point are then traversed once (out to the largest radius), the
+ *  smoothed counts of all radii are accumulated locally, and each query
+ *  point's outputs are written once.
  */
 class LocalDensity
 {
@@ -25,6 +30,11 @@ public:
     //! Constructor
     LocalDensity(float r_max, float diameter);
 
+    //! Constructor computing the density for several radii.
+    /*! The outputs have shape (n_query_points, r_maxs.size()).
+     */
+    LocalDensity(std::vector<float> r_maxs, float diameter);
+
     //! Destructor
     ~LocalDensity() = default;
 
@@ -34,12 +44,24 @@ public:
         return m_box;
     }
 
-    //! Return the cutoff distance.
+    //! Return the cutoff distance (the largest one if there are several).
     float getRMax() const
     {
         return m_r_max;
     }
 
+    //! Return the cutoff distances.
+    const std::vector<float>& getRMaxs() const
+    {
+        return m_r_maxs;
+    }
+
+    //! Return whether the outputs have one column per radius.
+    bool hasMultipleRadii() const
+    {
+        return m_multiple_radii;
+    }
+
     //! Return the cutoff distance.
     float getDiameter() const
     {
@@ -64,9 +86,11 @@ public:
     }
 
 private:
-    box::Box m_box;   //!< Simulation box where the particles belong
-    float m_r_max;    //!< Maximum neighbor distance
-    float m_diameter; //!< Diameter of the particles
+    box::Box m_box;              //!< Simulation box where the particles belong
+    float m_r_max;               //!< Maximum neighbor distance
+    std::vector<float> m_r_maxs; //!< Neighbor distances at which the density is computed
+    bool m_multiple_radii;       //!< Whether the outputs have one column per radius
+    float m_diameter;            //!< Diameter of the particles
 
     util::ManagedArray<float> m_density_array;       //!< density array computed
     util::ManagedArray<float> m_num_neighbors_array; //!< number of neighbors array computed
@@ -0,0 +1,180 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "MeshDensity.h"
+#include "SlabDeposition.h"
+
+/*! \file MeshDensity.cc
+    \brief Computes densities on a grid with particle-mesh assignment schemes.
+*/
+
+namespace freud { namespace density {
+
+namespace {
+
+//! Voxels and weights of a point along one dimension of the grid.
+struct AxisAssignment
+{
+    unsigned int count {0}; //!< Number of voxels within the grid.
+    unsigned int bins[3];   //!< Voxel indices.
+    float weights[3];       //!< Weights of the voxels.
+
+    //! Assign a point to the voxels along one dimension.
+    /*! \param assignment Assignment scheme.
+     *  \param u Coordinate of the point in units of voxels (voxel i spans [i, i + 1)).
+     *  \param width Number of voxels along the dimension.
+     *  \param periodic Whether the dimension is periodic.
+     */
+    void compute(MeshAssignment assignment, float u, unsigned int width, bool periodic)
+    {
+        int first = 0;
+        float candidate_weights[3];
+        const int order = static_cast<int>(assignment);
+        if (assignment == assignment_ngp)
+        {
+            first = int(std::floor(u));
+            candidate_weights[0] = float(1.0);
+        }
+        else if (assignment == assignment_cic)
+        {
+            // Linear weights of the two voxels whose centers surround the point.
+            const float x = u - float(0.5);
+            first = int(std::floor(x));
+            const float d = x - float(first);
+            candidate_weights[0] = float(1.0) - d;
+            candidate_weights[1] = d;
+        }
+        else
+        {
+            // Quadratic weights of the voxel containing the point and its neighbors.
+            const int center = int(std::floor(u));
+            const float d = u - (float(center) + float(0.5));
+            first = center - 1;
+            candidate_weights[0] = float(0.5) * (float(0.5) - d) * (float(0.5) - d);
+            candidate_weights[1] = float(0.75) - d * d;
+            candidate_weights[2] = float(0.5) * (float(0.5) + d) * (float(0.5) + d);
+        }
+
+        count = 0;
+        for (int i = 0; i < order; ++i)
+        {
+            const int bin = first + i;
+            if (periodic)
+            {
+                bins[count] = static_cast<unsigned int>(((bin % int(width)) + int(width)) % int(width));
+            }
+            else if (bin >= 0 && bin < int(width))
+            {
+                bins[count] = static_cast<unsigned int>(bin);
+            }
+            else
+            {
+                continue;
+            }
+            weights[count] = candidate_weights[i];
+            ++count;
+        }
+    }
+};
+
+} // namespace
+
+MeshDensity::MeshDensity(vec3<unsigned int> width, MeshAssignment assignment)
+    : m_box(), m_width(width), m_assignment(assignment), m_has_computed(false)
+{
+    if (width.x == 0 || width.y == 0 || width.z == 0)
+    {
+        throw std::invalid_argument("MeshDensity requires at least one voxel in each dimension.");
+    }
+    if (assignment != assignment_ngp && assignment != assignment_cic && assignment != assignment_tsc)
+    {
+        throw std::invalid_argument("MeshDensity requires a valid assignment scheme.");
+    }
+}
+
+void MeshDensity::compute(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    // set the number of dimensions for the calculation the first time it is done
+    if (!m_has_computed || nq->getBox().is2D() == m_box.is2D())
+    {
+        m_box = nq->getBox();
+        m_has_computed = true;
+    }
+    else
+    {
+        throw std::invalid_argument("The dimensionality of the box passed to MeshDensity has "
+                                    "changed. A new instance must be created to handle a different "
+                                    "number of dimensions.");
+    }
+
+    const bool is2D = m_box.is2D();
+    if (is2D)
+    {
+        m_width.z = 1;
+    }
+    m_density_array.prepare({m_width.x, m_width.y, m_width.z});
+
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const float inverse_voxel_volume
+        = float(m_width.x) * float(m_width.y) * float(m_width.z) / m_box.getVolume();
+
+    // Coordinates of a point in units of voxels.
+    const auto voxel_coordinates = [&](size_t idx) {
+        const vec3<float> fraction = m_box.makeFractional((*nq)[idx]);
+        return vec3<float>(fraction.x * float(m_width.x), fraction.y * float(m_width.y),
+                           fraction.z * float(m_width.z));
+    };
+
+    // The assignment stencils extend at most one voxel from the voxel
+    // containing each point, so slabs along x only need a halo of one row.
+    const auto row_of = [&](size_t idx) {
+        const int bin_x = int(std::floor(voxel_coordinates(idx).x));
+        return size_t(periodic.x ? ((bin_x % int(m_width.x)) + int(m_width.x)) % int(m_width.x)
+                                 : std::max(0, std::min(bin_x, int(m_width.x) - 1)));
+    };
+
+    const auto deposit_point = [&](size_t idx, const auto& writer) {
+        const vec3<float> u = voxel_coordinates(idx);
+        const float value = ((values != nullptr) ? values[idx] : float(1.0)) * inverse_voxel_volume;
+
+        AxisAssignment x_assignment;
+        AxisAssignment y_assignment;
+        AxisAssignment z_assignment;
+        x_assignment.compute(m_assignment, u.x, m_width.x, periodic.x);
+        y_assignment.compute(m_assignment, u.y, m_width.y, periodic.y);
+        if (is2D)
+        {
+            z_assignment.count = 1;
+            z_assignment.bins[0] = 0;
+            z_assignment.weights[0] = float(1.0);
+        }
+        else
+        {
+            z_assignment.compute(m_assignment, u.z, m_width.z, periodic.z);
+        }
+
+        for (unsigned int i = 0; i < x_assignment.count; ++i)
+        {
+            const float weight_x = value * x_assignment.weights[i];
+            for (unsigned int j = 0; j < y_assignment.count; ++j)
+            {
+                const float weight_xy = weight_x * y_assignment.weights[j];
+                const size_t offset = size_t(y_assignment.bins[j]) * m_width.z;
+                for (unsigned int k = 0; k < z_assignment.count; ++k)
+                {
+                    writer.deposit(x_assignment.bins[i], offset + z_assignment.bins[k],
+                                   weight_xy * z_assignment.weights[k]);
+                }
+            }
+        }
+    };
+
+    util::depositOnGrid(m_density_array, m_width.x, size_t(m_width.y) * m_width.z, 1, periodic.x,
+                        nq->getNPoints(), row_of, deposit_point);
+}
+
+}; }; // end namespace freud::density
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MESH_DENSITY_H
+#define MESH_DENSITY_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file MeshDensity.h
+    \brief Computes densities on a grid with particle-mesh assignment schemes.
+*/
+
+namespace freud { namespace density {
+
+//! Schemes assigning the mass of a point to the voxels around it.
+typedef enum
+{
+    assignment_ngp = 1, //!< Nearest grid point: the voxel containing the point.
+    assignment_cic = 2, //!< Cloud in cell: linear weights over 2 voxels per dimension.
+    assignment_tsc = 3  //!< Triangular shaped cloud: quadratic weights over 3 voxels per dimension.
+} MeshAssignment;
+
+//! Computes the density of a system on a grid with a particle-mesh assignment scheme.
+/*! Each point's value (1 by default) is distributed over the voxels nearest
+    to it with the weights of the assignment scheme, which sum to one, and
+    divided by the voxel volume. The grid spans the box along its lattice
+    vectors, so the voxels of triclinic boxes are parallelepipeds. Periodic
+    dimensions wrap around, while contributions outside of the grid along
+    aperiodic dimensions are discarded.
+
+    Compared to GaussianDensity, each point only touches 1, 8, or 27 voxels in
+    3D, which makes this suitable for computing coarse fields of many points,
+    e.g. as the input of Fourier transforms for structure factors. The
+    assignment order is the number of voxels touched along each dimension, and
+    higher orders reduce aliasing at a slightly higher cost.
+*/
+class MeshDensity
+{
+public:
+    //! Constructor
+    MeshDensity(vec3<unsigned int> width, MeshAssignment assignment);
+
+    // Destructor
+    ~MeshDensity() = default;
+
+    //! Get the simulation box.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+    //! Get the assignment scheme.
+    MeshAssignment getAssignment() const
+    {
+        return m_assignment;
+    }
+
+    //! Compute the density.
+    void compute(const freud::locality::NeighborQuery* nq, const float* values = nullptr);
+
+    //! Get a reference to the last computed density.
+    const util::ManagedArray<float>& getDensity() const
+    {
+        return m_density_array;
+    }
+
+    //! Get the number of voxels in each dimension.
+    vec3<unsigned int> getWidth() const
+    {
+        return m_width;
+    }
+
+private:
+    box::Box m_box;              //!< Simulation box containing the points.
+    vec3<unsigned int> m_width;  //!< Number of voxels in the grid in each dimension.
+    MeshAssignment m_assignment; //!< Assignment scheme.
+    bool m_has_computed;         //!< Tracks whether a call to compute has been made.
+
+    util::ManagedArray<float> m_density_array; //! Computed density array.
+};
+
+}; }; // end namespace freud::density
+
+#endif // MESH_DENSITY_H
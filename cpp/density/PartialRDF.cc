@@ -0,0 +1,160 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "PartialRDF.h"
+
+/*! \file PartialRDF.cc
+    \brief Routines for computing the radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+namespace {
+
+//! Count the number of points of each type.
+std::vector<unsigned int> countTypes(const unsigned int* types, unsigned int n, unsigned int num_types)
+{
+    if (std::any_of(types, types + n, [num_types](unsigned int type) { return type >= num_types; }))
+    {
+        throw std::invalid_argument("All types must be less than the number of types of the PartialRDF.");
+    }
+    std::vector<unsigned int> counts(num_types, 0);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        ++counts[types[i]];
+    }
+    return counts;
+}
+
+} // namespace
+
+PartialRDF::PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min, bool normalize)
+    : BondHistogramCompute(), m_num_types(num_types), m_normalize(normalize),
+      m_pair_normalization(size_t(num_types) * num_types, 0), m_query_point_counts(num_types, 0)
+{
+    if (num_types == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of types.");
+    }
+    if (bins == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of bins.");
+    }
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("PartialRDF requires r_max to be positive.");
+    }
+    if (r_max <= r_min)
+    {
+        throw std::invalid_argument("PartialRDF requires that r_max must be greater than r_min.");
+    }
+
+    // The histogram is binned by query point type, point type, and distance.
+    // Bonds are binned directly into linear indices, so the type axes only
+    // define the shape of the histogram.
+    m_r_axis = std::make_shared<util::RegularAxis>(bins, r_min, r_max);
+    BHAxes axes;
+    axes.push_back(std::make_shared<util::RegularAxis>(num_types, 0, num_types));
+    axes.push_back(std::make_shared<util::RegularAxis>(num_types, 0, num_types));
+    axes.push_back(m_r_axis);
+    m_histogram = BondHistogram(axes);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+}
+
+void PartialRDF::reset()
+{
+    BondHistogramCompute::reset();
+    std::fill(m_pair_normalization.begin(), m_pair_normalization.end(), 0);
+    std::fill(m_query_point_counts.begin(), m_query_point_counts.end(), 0);
+}
+
+void PartialRDF::reduce()
+{
+    const size_t bins = m_r_axis->size();
+    const std::vector<size_t> shape {m_num_types, m_num_types, bins};
+    m_pcf.prepare(shape);
+    m_N_r.prepare(shape);
+
+    // Volumes of the shells (or areas of the rings in 2D) of the bins.
+    const std::vector<float> bin_edges = m_r_axis->getBinEdges();
+    std::vector<float> shell_volumes(bins);
+    for (size_t i = 0; i < bins; ++i)
+    {
+        const float r = bin_edges[i];
+        const float nextr = bin_edges[i + 1];
+        shell_volumes[i] = m_box.is2D() ? float(M_PI * (nextr * nextr - r * r))
+                                        : float((4.0 / 3.0) * M_PI * (nextr * nextr * nextr - r * r * r));
+    }
+
+    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+        const size_t pair = i / bins;
+        const double normalization = m_pair_normalization[pair];
+        m_pcf[i] = (normalization > 0)
+            ? float(double(m_histogram[i]) / (normalization * double(shell_volumes[i % bins])))
+            : float(0);
+    });
+
+    // The accumulation of the cumulative counts must be performed in
+    // sequence along each row, so it is done after the reduction.
+    util::forLoopWrapper(0, size_t(m_num_types) * m_num_types, [&](size_t begin, size_t end) {
+        for (size_t pair = begin; pair < end; ++pair)
+        {
+            const double query_point_count = m_query_point_counts[pair / m_num_types];
+            const double prefactor = (query_point_count > 0) ? 1.0 / query_point_count : 0.0;
+            double cumulative_count = 0;
+            for (size_t i = 0; i < bins; ++i)
+            {
+                cumulative_count += double(m_histogram[pair * bins + i]);
+                m_N_r[pair * bins + i] = float(cumulative_count * prefactor);
+            }
+        }
+    });
+}
+
+void PartialRDF::accumulate(const freud::locality::NeighborQuery* neighbor_query,
+                            const vec3<float>* query_points, unsigned int n_query_points,
+                            const unsigned int* point_types, const unsigned int* query_point_types,
+                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    const std::vector<unsigned int> point_counts
+        = countTypes(point_types, neighbor_query->getNPoints(), m_num_types);
+    const std::vector<unsigned int> query_point_counts
+        = countTypes(query_point_types, n_query_points, m_num_types);
+
+    // Each frame contributes N_a * rho_b to the normalization of the pair
+    // (a, b). With normalize, a query point does not count towards the
+    // density of its own type, as in RDF.
+    const double volume = neighbor_query->getBox().getVolume();
+    for (unsigned int a = 0; a < m_num_types; ++a)
+    {
+        m_query_point_counts[a] += query_point_counts[a];
+        for (unsigned int b = 0; b < m_num_types; ++b)
+        {
+            double num_points = point_counts[b];
+            if (m_normalize && a == b)
+            {
+                num_points = std::max(num_points - 1.0, 0.0);
+            }
+            m_pair_normalization[a * m_num_types + b] += double(query_point_counts[a]) * num_points / volume;
+        }
+    }
+
+    const size_t num_types = m_num_types;
+    const size_t bins = m_r_axis->size();
+    const util::RegularAxis& r_axis = *m_r_axis;
+    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
+                      [&](const freud::locality::NeighborBond& neighbor_bond) {
+                          const size_t r_bin = r_axis.bin(neighbor_bond.distance);
+                          if (r_bin != util::Axis::OVERFLOW_BIN)
+                          {
+                              const size_t pair = query_point_types[neighbor_bond.query_point_idx] * num_types
+                                  + point_types[neighbor_bond.point_idx];
+                              m_local_histograms.increment(pair * bins + r_bin);
+                          }
+                      });
+}
+
+}; }; // end namespace freud::density
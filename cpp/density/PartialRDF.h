@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef PARTIAL_RDF_H
+#define PARTIAL_RDF_H
+
+#include <memory>
+#include <vector>
+
+#include "BondHistogramCompute.h"
+#include "Box.h"
+#include "Histogram.h"
+
+/*! \file PartialRDF.h
+    \brief Routines for computing the radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+//! Computes the partial RDFs of all pairs of types in a single neighbor traversal.
+/*! Each bond is binned by the type of its query point, the type of its point,
+    and its length, into a histogram of shape (num_types, num_types, bins). The
+    partial RDF g_ab(r) is normalized by the number of query points of type a
+    and the number density of points of type b, summed over all accumulated
+    frames, so the composition and the box may change between frames.
+*/
+class PartialRDF : public locality::BondHistogramCompute
+{
+public:
+    //! Constructor
+    PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min = 0,
+               bool normalize = false);
+
+    //! Destructor
+    ~PartialRDF() override = default;
+
+    //! Reset the histogram and the normalization to all zeros.
+    void reset() override;
+
+    //! Accumulate the bonds between the given points into the histogram.
+    /*! \param point_types The type of each point in neighbor_query.
+     *  \param query_point_types The type of each query point.
+     */
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const unsigned int* point_types,
+                    const unsigned int* query_point_types, const freud::locality::NeighborList* nlist,
+                    freud::locality::QueryArgs qargs);
+
+    //! Reduce thread-local arrays onto the primary data arrays.
+    void reduce() override;
+
+    //! Get the number of types.
+    unsigned int getNumTypes() const
+    {
+        return m_num_types;
+    }
+
+    //! Get the partial RDFs, with shape (num_types, num_types, bins).
+    const util::ManagedArray<float>& getRDF()
+    {
+        return reduceAndReturn(m_pcf);
+    }
+
+    //! Get the cumulative counts, with shape (num_types, num_types, bins).
+    /*! m_N_r[a, b, i] is the average number of points of type b contained
+     *  within a ball of radius getBinEdges()[2][i+1] centered at a query point
+     *  of type a.
+     */
+    const util::ManagedArray<float>& getNr()
+    {
+        return reduceAndReturn(m_N_r);
+    }
+
+private:
+    unsigned int m_num_types;                    //!< Number of types.
+    bool m_normalize;                            //!< Whether to exclude the query point itself from the
+                                                 //!< number density of its own type.
+    std::shared_ptr<util::RegularAxis> m_r_axis; //!< Axis binning the bond lengths.
+    std::vector<double> m_pair_normalization;    //!< Sum over frames of N_a * N_b / V for each type pair.
+    std::vector<double> m_query_point_counts;    //!< Sum over frames of the query points of each type.
+    util::ManagedArray<float> m_pcf;             //!< The computed partial pair correlation functions.
+    util::ManagedArray<float> m_N_r;             //!< Cumulative bin sums N_ab(r).
+};
+
+}; }; // end namespace freud::density
+
+#endif // PARTIAL_RDF_H
@@ -50,9 +50,10 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
 
 void RDF::reduce()
 {
-    m_pcf.prepare(getAxisSizes()[0]);
-    m_histogram.prepare(getAxisSizes()[0]);
-    m_N_r.prepare(getAxisSizes()[0]);
+    const std::vector<size_t> shape {getAxisSizes()[0]};
+    prepareOutput(m_pcf, m_pcf_spare, shape);
+    prepareOutput(m_histogram.getWritableBinCounts(), m_counts_spare, shape);
+    prepareOutput(m_N_r, m_N_r_spare, shape);
 
     // Define prefactors with appropriate types to simplify and speed later code.
     float number_density = float(m_n_query_points) / m_box.getVolume();
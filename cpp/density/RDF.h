@@ -6,6 +6,7 @@
 
 #include "BondHistogramCompute.h"
 #include "Box.h"
+#include "DoubleBufferedCompute.h"
 #include "Histogram.h"
 
 /*! \file RDF.h
@@ -13,7 +14,7 @@
 */
 
 namespace freud { namespace density {
-class RDF : public locality::BondHistogramCompute
+class RDF : public locality::BondHistogramCompute, public util::DoubleBufferedCompute
 {
 public:
     //! Constructor
@@ -56,6 +57,9 @@ private:
     util::ManagedArray<float> m_pcf; //!< The computed pair correlation function.
     util::ManagedArray<float>
         m_N_r; //!< Cumulative bin sum N(r) (the average number of points in a ball of radius r).
+    util::ManagedArray<float> m_pcf_spare;           //!< Second buffer of m_pcf if double buffered.
+    util::ManagedArray<float> m_N_r_spare;           //!< Second buffer of m_N_r if double buffered.
+    util::ManagedArray<unsigned int> m_counts_spare; //!< Second buffer of the bin counts if double buffered.
     util::ManagedArray<float>
         m_vol_array2D; //!< Areas of concentric rings corresponding to the histogram bins in 2D.
     util::ManagedArray<float>
@@ -1,9 +1,12 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <stdexcept>
 
+#include "SlabDeposition.h"
 #include "SphereVoxelization.h"
 
 /*! \file SphereVoxelization.cc
@@ -12,6 +15,86 @@
 
 namespace freud { namespace density {
 
+namespace {
+
+//! Range [first, last] of voxel indices along one axis, which is empty if first > last.
+struct VoxelSpan
+{
+    int first;
+    int last;
+};
+
+//! Find the voxels whose centers are strictly within half_width of a coordinate.
+/*! \param u Coordinate in units of voxels (voxel i spans [i, i + 1)).
+ *  \param half_width Half of the extent of the chord in units of voxels.
+ */
+VoxelSpan chordSpan(float u, float half_width)
+{
+    // Voxel i is inside if |i + 1/2 - u| < half_width.
+    const float center = u - float(0.5);
+    return {int(std::floor(center - half_width)) + 1, int(std::ceil(center + half_width)) - 1};
+}
+
+//! Map a voxel index along an axis onto the grid.
+/*! \returns The index in [0, width), or -1 if the index is outside of an aperiodic axis.
+ */
+int wrapVoxel(int i, unsigned int width, bool periodic)
+{
+    const int w = int(width);
+    if (periodic)
+    {
+        return ((i % w) + w) % w;
+    }
+    return (i >= 0 && i < w) ? i : -1;
+}
+
+//! Fill a span of consecutive voxels along the contiguous axis of a row.
+/*! Spans crossing a periodic boundary are split in two, and spans covering
+ *  the whole axis fill it once.
+ *
+ *  \param writer Writer with a fill(row, offset, value, count) method.
+ *  \param row Row of the grid.
+ *  \param offset Offset of the first voxel of the axis within the row.
+ *  \param span Voxels to fill, which may extend beyond the grid.
+ *  \param width Number of voxels along the axis.
+ *  \param periodic Whether the axis is periodic.
+ */
+template<typename Writer>
+void fillSpan(const Writer& writer, size_t row, size_t offset, VoxelSpan span, unsigned int width,
+              bool periodic)
+{
+    const int w = int(width);
+    if (span.first > span.last)
+    {
+        return;
+    }
+    if (!periodic)
+    {
+        const int first = std::max(span.first, 0);
+        const int last = std::min(span.last, w - 1);
+        if (first <= last)
+        {
+            writer.fill(row, offset + size_t(first), 1, size_t(last - first + 1));
+        }
+        return;
+    }
+    const int count = span.last - span.first + 1;
+    if (count >= w)
+    {
+        writer.fill(row, offset, 1, width);
+        return;
+    }
+    const int first = wrapVoxel(span.first, width, true);
+    const int head = std::min(count, w - first);
+    writer.fill(row, offset + size_t(first), 1, size_t(head));
+    if (head < count)
+    {
+        writer.fill(row, offset, 1, size_t(count - head));
+    }
+}
+
+} // namespace
+
 SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max)
     : m_box(), m_width(width), m_r_max(r_max), m_has_computed(false)
 {
@@ -65,80 +148,151 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
     const float Ly = m_box.getLy();
     const float Lz = m_box.getLz();
     const vec3<bool> periodic = m_box.getPeriodic();
+    const bool is2D = m_box.is2D();
 
     const float grid_size_x = Lx / m_width.x;
     const float grid_size_y = Ly / m_width.y;
-    const float grid_size_z = m_box.is2D() ? 0 : Lz / m_width.z;
+    const float grid_size_z = is2D ? 0 : Lz / m_width.z;
 
     // Find the number of bins within r_max
     const int bin_cut_x = int(m_r_max / grid_size_x);
     const int bin_cut_y = int(m_r_max / grid_size_y);
-    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const int bin_cut_z = is2D ? 0 : int(m_r_max / grid_size_z);
     const float r_max_sq = m_r_max * m_r_max;
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
+    // Voxel centers within r_max of a point are at most bin_cut_x + 1 rows
+    // away from the row containing the point.
+    const int halo = bin_cut_x + 1;
+    const size_t row_size = size_t(m_width.y) * m_width.z;
+
+    // Coordinates of a point in units of voxels.
+    const auto voxel_coordinates = [&](size_t idx) {
+        const vec3<float> point = (*nq)[idx];
+        return vec3<float>((point.x + Lx / float(2.0)) / grid_size_x,
+                           (point.y + Ly / float(2.0)) / grid_size_y,
+                           is2D ? float(0.0) : (point.z + Lz / float(2.0)) / grid_size_z);
+    };
+
+    // In an orthorhombic box the minimum image separates by axis, so the
+    // voxels of a sphere within each row of the grid are the contiguous span
+    // covered by its chord along the last axis (y in 2D, z in 3D). The spans
+    // are computed analytically and filled without testing every voxel.
+    const auto deposit_spans = [&](size_t idx, const auto& writer) {
+        const vec3<float> u = voxel_coordinates(idx);
+        const int bin_x = int(std::floor(u.x));
+        VoxelSpan x_span = chordSpan(u.x, m_r_max / grid_size_x);
+        x_span.first = std::max(x_span.first, bin_x - halo);
+        x_span.last = std::min(x_span.last, bin_x + halo);
+
+        for (int i = x_span.first; i <= x_span.last; ++i)
         {
-            const vec3<float> point = (*nq)[idx];
-            // Find which bin the particle is in
-            const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
-            const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
-            // In 2D, only loop over the z=0 plane
-            const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
-
-            // Only evaluate over bins that are within the cutoff, rejecting bins
-            // that are outside the box in aperiodic directions.
-            for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+            const int ni = wrapVoxel(i, m_width.x, periodic.x);
+            const float dx = (float(i) + float(0.5) - u.x) * grid_size_x;
+            const float r_sq_yz = r_max_sq - dx * dx;
+            if (ni < 0 || r_sq_yz <= 0)
             {
-                if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                continue;
+            }
+            const VoxelSpan y_span = chordSpan(u.y, std::sqrt(r_sq_yz) / grid_size_y);
+            if (is2D)
+            {
+                fillSpan(writer, size_t(ni), 0, y_span, m_width.y, periodic.y);
+                continue;
+            }
+
+            for (int j = y_span.first; j <= y_span.last; ++j)
+            {
+                const int nj = wrapVoxel(j, m_width.y, periodic.y);
+                const float dy = (float(j) + float(0.5) - u.y) * grid_size_y;
+                const float r_sq_z = r_sq_yz - dy * dy;
+                if (nj < 0 || r_sq_z <= 0)
                 {
                     continue;
                 }
-                const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
-                    - (Lz / float(2.0));
+                const VoxelSpan z_span = chordSpan(u.z, std::sqrt(r_sq_z) / grid_size_z);
+                fillSpan(writer, size_t(ni), size_t(nj) * m_width.z, z_span, m_width.z, periodic.z);
+            }
+        }
+    };
 
-                for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+    // Triclinic boxes test the wrapped distance to every voxel in the cutoff cube.
+    const auto deposit_exact = [&](size_t idx, const auto& writer) {
+        const vec3<float> point = (*nq)[idx];
+        // Find which bin the particle is in
+        const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+        // In 2D, only loop over the z=0 plane
+        const int bin_z = is2D ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+        // Only evaluate over bins that are within the cutoff, rejecting bins
+        // that are outside the box in aperiodic directions.
+        for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+        {
+            if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+            {
+                continue;
+            }
+            const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0)) - point.z
+                - (Lz / float(2.0));
+
+            for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+            {
+                if (!periodic.y && (j < 0 || j >= int(m_width.y)))
                 {
-                    if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                    continue;
+                }
+                const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0)) - point.y
+                    - (Ly / float(2.0));
+
+                for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                {
+                    if (!periodic.x && (i < 0 || i >= int(m_width.x)))
                     {
                         continue;
                     }
-                    const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
-                        - point.y - (Ly / float(2.0));
+                    const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f) - point.x
+                                      - (Lx / float(2.0)));
+
+                    // Calculate the distance from the particle to the grid cell
+                    const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
 
-                    for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                    const float r_sq = dot(delta, delta);
+
+                    // Check to see if this distance is within the specified r_max
+                    if (r_sq < r_max_sq)
                     {
-                        if (!periodic.x && (i < 0 || i >= int(m_width.x)))
-                        {
-                            continue;
-                        }
-                        const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f)
-                                          - point.x - (Lx / float(2.0)));
-
-                        // Calculate the distance from the particle to the grid cell
-                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
-
-                        const float r_sq = dot(delta, delta);
-
-                        // Check to see if this distance is within the specified r_max
-                        if (r_sq < r_max_sq)
-                        {
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
-                            const unsigned int nj = (j + m_width.y) % m_width.y;
-                            const unsigned int nk = (k + m_width.z) % m_width.z;
-
-                            // This array value could be written by multiple threads in parallel.
-                            // This is only safe because all threads are writing the same value (1).
-                            m_voxels_array(ni, nj, nk) = 1;
-                        }
+                        // Assure that out of range indices are corrected for storage
+                        // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                        const unsigned int ni = (i + m_width.x) % m_width.x;
+                        const unsigned int nj = (j + m_width.y) % m_width.y;
+                        const unsigned int nk = (k + m_width.z) % m_width.z;
+
+                        writer.deposit(ni, nj * m_width.z + nk, 1);
                     }
                 }
             }
         }
-    });
+    };
+
+    // Each slab of rows along x is filled by a single thread.
+    const auto row_of = [&](size_t idx) {
+        const int bin_x = int(std::floor(voxel_coordinates(idx).x));
+        return size_t(periodic.x ? wrapVoxel(bin_x, m_width.x, true)
+                                 : std::max(0, std::min(bin_x, int(m_width.x) - 1)));
+    };
+    const auto deposit_points = [&](const auto& deposit_point) {
+        util::depositOnGrid<unsigned int, std::bit_or<unsigned int>>(
+            m_voxels_array, m_width.x, row_size, size_t(halo), periodic.x, n_points, row_of, deposit_point);
+    };
+
+    if (m_box.isTriclinic())
+    {
+        deposit_points(deposit_exact);
+    }
+    else
+    {
+        deposit_points(deposit_spans);
+    }
 }
 
 }; }; // end namespace freud::density
@@ -0,0 +1,242 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "BinAccumulator.h"
+#include "DiffractionPattern.h"
+#include "FFT.h"
+#include "utils.h"
+
+/*! \file DiffractionPattern.cc
+    \brief Routines for computing 2D diffraction patterns.
+*/
+
+namespace freud { namespace diffraction {
+
+namespace {
+
+//! Row-major 2x2 matrix.
+struct Matrix2
+{
+    double m00, m01, m10, m11;
+
+    Matrix2 inverse() const
+    {
+        const double det = m00 * m11 - m01 * m10;
+        if (det == 0)
+        {
+            throw std::invalid_argument(
+                "The box has no projected area perpendicular to the view axis of DiffractionPattern.");
+        }
+        return {m11 / det, -m01 / det, -m10 / det, m00 / det};
+    }
+};
+
+//! Find the inverse shear mapping projected positions to fractional coordinates of the box face.
+/*! The rows of the box matrix are rotated by the view orientation, and the
+ *  face of the rotated box with the largest area perpendicular to the view
+ *  axis (z) is used for the projection.
+ */
+Matrix2 projectionInverseShear(const double box_matrix[3][3], const quat<double>& view_orientation)
+{
+    double rotated[3][3];
+    for (unsigned int row = 0; row < 3; ++row)
+    {
+        const vec3<double> v = rotate(
+            view_orientation, vec3<double>(box_matrix[row][0], box_matrix[row][1], box_matrix[row][2]));
+        rotated[row][0] = v.x;
+        rotated[row][1] = v.y;
+        rotated[row][2] = v.z;
+    }
+    const auto column = [&](unsigned int c) {
+        return vec3<double>(rotated[0][c], rotated[1][c], rotated[2][c]);
+    };
+
+    // The z component of the normal of each face is its area projected along the view axis.
+    unsigned int best_axis = 0;
+    double best_projection = -1;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        const double projection = std::abs(cross(column((axis + 2) % 3), column((axis + 1) % 3)).z);
+        if (projection > best_projection)
+        {
+            best_projection = projection;
+            best_axis = axis;
+        }
+    }
+    const unsigned int first = (best_axis + 1) % 3;
+    const unsigned int second = (best_axis + 2) % 3;
+    return Matrix2 {rotated[0][first], rotated[0][second], rotated[1][first], rotated[1][second]}.inverse();
+}
+
+//! Interpolate a square image bilinearly, returning zero outside of its extent.
+double bilinear(const std::vector<double>& image, unsigned int size, double row, double col)
+{
+    const double max_index = size - 1;
+    if (!(row >= 0 && row <= max_index && col >= 0 && col <= max_index))
+    {
+        return 0;
+    }
+    const auto row0 = static_cast<unsigned int>(row);
+    const auto col0 = static_cast<unsigned int>(col);
+    const unsigned int row1 = std::min(row0 + 1, size - 1);
+    const unsigned int col1 = std::min(col0 + 1, size - 1);
+    const double row_frac = row - row0;
+    const double col_frac = col - col0;
+    const double top = image[row0 * size + col0] * (1 - col_frac) + image[row0 * size + col1] * col_frac;
+    const double bottom = image[row1 * size + col0] * (1 - col_frac) + image[row1 * size + col1] * col_frac;
+    return top * (1 - row_frac) + bottom * row_frac;
+}
+
+} // end anonymous namespace
+
+DiffractionPattern::DiffractionPattern(unsigned int grid_size, unsigned int output_size)
+    : m_grid_size(grid_size), m_output_size(output_size)
+{
+    if (grid_size == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires a nonzero grid_size.");
+    }
+    if (output_size == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires a nonzero output_size.");
+    }
+}
+
+void DiffractionPattern::compute(const freud::locality::NeighborQuery* nq,
+                                 const quat<float>* view_orientations, unsigned int n_views, double zoom,
+                                 double peak_width)
+{
+    if (n_views == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires at least one view orientation.");
+    }
+    if (!(zoom > 0))
+    {
+        throw std::invalid_argument("DiffractionPattern requires a positive zoom.");
+    }
+    const auto grid_size = static_cast<unsigned int>(m_grid_size / zoom);
+    if (grid_size == 0)
+    {
+        throw std::invalid_argument("The zoom of DiffractionPattern must not exceed its grid_size.");
+    }
+    if (nq->getNPoints() == 0)
+    {
+        throw std::invalid_argument("DiffractionPattern requires at least one point.");
+    }
+    m_box = nq->getBox();
+
+    // Damping of each frequency of the grid by the transform of the Gaussian
+    // peaks, in the order of the FFT output.
+    const double sigma = peak_width / zoom;
+    std::vector<double> damping(grid_size);
+    for (unsigned int k = 0; k < grid_size; ++k)
+    {
+        const double frequency
+            = double(k < (grid_size + 1) / 2 ? int(k) : int(k) - int(grid_size)) / grid_size;
+        damping[k] = std::exp(-2 * M_PI * M_PI * sigma * sigma * frequency * frequency);
+    }
+
+    m_diffraction.prepare({m_output_size, m_output_size});
+    const double n_points = nq->getNPoints();
+    const double weight = 1.0 / (n_points * n_points * n_views);
+    for (unsigned int view = 0; view < n_views; ++view)
+    {
+        quat<double> view_orientation(view_orientations[view]);
+        const double norm = std::sqrt(norm2(view_orientation));
+        if (!(norm > 0))
+        {
+            throw std::invalid_argument("The view orientations of DiffractionPattern must be nonzero.");
+        }
+        view_orientation = view_orientation * (1.0 / norm);
+        accumulateView(nq, view_orientation, grid_size, zoom, damping, weight);
+    }
+}
+
+void DiffractionPattern::accumulateView(const freud::locality::NeighborQuery* nq,
+                                        const quat<double>& view_orientation, unsigned int grid_size,
+                                        double zoom, const std::vector<double>& damping, double weight)
+{
+    const vec3<double> L = m_box.getL();
+    const double box_matrix[3][3] = {
+        {L.x, m_box.getTiltFactorXY() * L.y, m_box.getTiltFactorXZ() * L.z},
+        {0, L.y, m_box.getTiltFactorYZ() * L.z},
+        {0, 0, L.z}};
+    const Matrix2 inv_shear = projectionInverseShear(box_matrix, view_orientation);
+
+    // Bin the fractional coordinates of the projected points, shifted to [0, 1).
+    const size_t n_grid = size_t(grid_size) * grid_size;
+    util::BinAccumulator<unsigned int> counts(n_grid);
+    util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
+        const auto bin = [&](double fraction) {
+            fraction -= std::floor(fraction);
+            return std::min(static_cast<unsigned int>(fraction * grid_size), grid_size - 1);
+        };
+        for (size_t i = begin; i < end; ++i)
+        {
+            const vec3<double> r = rotate(view_orientation, vec3<double>((*nq)[i]));
+            const unsigned int row = bin(inv_shear.m00 * r.x + inv_shear.m01 * r.y + 0.5);
+            const unsigned int col = bin(inv_shear.m10 * r.x + inv_shear.m11 * r.y + 0.5);
+            counts.add(size_t(row) * grid_size + col, 1);
+        }
+    });
+    util::ManagedArray<unsigned int> count_array(n_grid);
+    counts.reduceInto(count_array);
+
+    m_grid.resize(n_grid);
+    util::forLoopWrapper(0, n_grid, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_grid[i] = std::complex<double>(count_array[i], 0);
+        }
+    });
+    util::transformGrid(m_grid.data(), {grid_size, grid_size}, false);
+
+    // Damp and square the transform, moving k = 0 to bin (grid_size / 2, grid_size / 2).
+    const unsigned int roll = grid_size / 2;
+    m_intensity.resize(n_grid);
+    util::forLoopWrapper(0, grid_size, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row)
+        {
+            const size_t shifted_row = (row + roll) % grid_size;
+            for (size_t col = 0; col < grid_size; ++col)
+            {
+                const double damping_sq = damping[row] * damping[row] * damping[col] * damping[col];
+                m_intensity[shifted_row * grid_size + (col + roll) % grid_size]
+                    = std::norm(m_grid[row * grid_size + col]) * damping_sq;
+            }
+        }
+    });
+
+    // The output maps k = 0 to pixel (output_size / 2, output_size / 2),
+    // zooms the grid, and undoes the shear of the projected box scaled by
+    // its largest box matrix element.
+    double scale = 0;
+    for (const auto& row : box_matrix)
+    {
+        scale = std::max({scale, row[0], row[1], row[2]});
+    }
+    const Matrix2 output_to_grid = Matrix2 {scale * inv_shear.m10, scale * inv_shear.m00,
+                                            scale * inv_shear.m11, scale * inv_shear.m01}
+                                       .inverse();
+    const double center = m_output_size / 2;
+    util::forLoopWrapper(0, m_output_size, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row)
+        {
+            const double u = (double(row) - center) / zoom;
+            for (size_t col = 0; col < m_output_size; ++col)
+            {
+                const double v = (double(col) - center) / zoom;
+                const double grid_row = roll + output_to_grid.m00 * u + output_to_grid.m01 * v;
+                const double grid_col = roll + output_to_grid.m10 * u + output_to_grid.m11 * v;
+                m_diffraction[row * m_output_size + col]
+                    += weight * bilinear(m_intensity, grid_size, grid_row, grid_col);
+            }
+        }
+    });
+}
+
+}; }; // end namespace freud::diffraction
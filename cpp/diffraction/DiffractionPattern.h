@@ -0,0 +1,101 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DIFFRACTION_PATTERN_H
+#define DIFFRACTION_PATTERN_H
+
+#include <complex>
+#include <vector>
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file DiffractionPattern.h
+    \brief Routines for computing 2D diffraction patterns.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Computes the 2D diffraction pattern of a system seen along one or more view axes.
+/*! For each view orientation, the points are rotated, projected onto the
+    face of the rotated box with the largest area perpendicular to the view
+    axis, and binned in fractional coordinates of that face on a square grid
+    of int(grid_size / zoom) bins per side. The binned image is transformed
+    with a parallel FFT, damped by the transform of a Gaussian of width
+    peak_width / zoom bins evaluated analytically in k-space, shifted so that
+    k = 0 lies at the center, and squared. The squared magnitudes are
+    resampled with bilinear interpolation onto the output image, which maps
+    k = 0 to pixel (output_size / 2, output_size / 2) and undoes the shear of
+    the projected box, and are normalized by the square of the number of
+    points. Pixels that fall outside the transformed grid are zero.
+
+    The patterns of several view orientations are averaged, e.g. to compute
+    powder averages in a single call.
+*/
+class DiffractionPattern
+{
+public:
+    //! Constructor
+    /*! \param grid_size Number of bins per side of the grid at unit zoom.
+     *  \param output_size Number of pixels per side of the output image.
+     */
+    DiffractionPattern(unsigned int grid_size, unsigned int output_size);
+
+    //! Destructor
+    ~DiffractionPattern() = default;
+
+    //! Compute the diffraction pattern averaged over the view orientations.
+    /*! \param nq NeighborQuery containing the points and the box.
+     *  \param view_orientations Quaternions of the view orientations, which are normalized.
+     *  \param n_views Number of view orientations.
+     *  \param zoom Scaling factor of the incident wavevectors.
+     *  \param peak_width Width of the Gaussian convolved with the points, in units of grid bins at unit zoom.
+     */
+    void compute(const freud::locality::NeighborQuery* nq, const quat<float>* view_orientations,
+                 unsigned int n_views, double zoom, double peak_width);
+
+    //! Get the last computed diffraction pattern.
+    const util::ManagedArray<double>& getDiffraction() const
+    {
+        return m_diffraction;
+    }
+
+    //! Get the number of bins per side of the grid at unit zoom.
+    unsigned int getGridSize() const
+    {
+        return m_grid_size;
+    }
+
+    //! Get the number of pixels per side of the output image.
+    unsigned int getOutputSize() const
+    {
+        return m_output_size;
+    }
+
+    //! Get the box of the last computation.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+private:
+    //! Add the diffraction pattern of one view orientation, multiplied by weight, to the output.
+    void accumulateView(const freud::locality::NeighborQuery* nq, const quat<double>& view_orientation,
+                        unsigned int grid_size, double zoom, const std::vector<double>& damping,
+                        double weight);
+
+    unsigned int m_grid_size;   //!< Number of bins per side of the grid at unit zoom.
+    unsigned int m_output_size; //!< Number of pixels per side of the output image.
+    box::Box m_box;             //!< Box of the last computation.
+
+    std::vector<std::complex<double>> m_grid; //!< Scratch grid of the Fourier transform.
+    std::vector<double> m_intensity;          //!< Scratch grid of the shifted squared magnitudes.
+
+    util::ManagedArray<double> m_diffraction; //!< The computed diffraction pattern.
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // DIFFRACTION_PATTERN_H
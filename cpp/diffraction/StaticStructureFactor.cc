@@ -0,0 +1,376 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "BoxBatch.h"
+#include "StaticStructureFactor.h"
+#include "utils.h"
+
+/*! \file StaticStructureFactor.cc
+    \brief Routines for computing static structure factors.
+*/
+
+namespace freud { namespace diffraction {
+
+namespace {
+
+//! Largest phase difference k_max * dr across a bond distance bin of the Debye method.
+/*! Evaluating sin(k r) / (k r) at the bin centers then deviates from its
+ *  average over the bin by less than a part in 10^4.
+ */
+constexpr float DEBYE_MAX_PHASE_STEP = 0.05;
+
+//! Fractional coordinates of points in structure-of-arrays layout.
+struct FractionalPoints
+{
+    FractionalPoints(const box::Box& box, const vec3<float>* points, unsigned int n)
+        : x(n), y(n), z(n), size(n)
+    {
+        std::vector<vec3<float>> fractions(points, points + n);
+        box.makeFractional(fractions.data(), n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            x[i] = fractions[i].x;
+            y[i] = fractions[i].y;
+            z[i] = fractions[i].z;
+        }
+    }
+
+    std::vector<double> x; //!< Fractional x coordinates
+    std::vector<double> y; //!< Fractional y coordinates
+    std::vector<double> z; //!< Fractional z coordinates
+    unsigned int size;     //!< Number of points
+};
+
+//! Sum exp(i k.r) over points for the k-vector with Miller indices (h, k, l).
+/*! The phase k.r is 2 pi (h x + k y + l z) in fractional coordinates, so it
+ *  is computed in turns, reduced to [0, 1) in double precision, and passed to
+ *  the vectorized sine and cosine in batches.
+ *
+ *  \param points Fractional coordinates of the points.
+ *  \param h Miller index along the first lattice vector.
+ *  \param k Miller index along the second lattice vector.
+ *  \param l Miller index along the third lattice vector.
+ *  \param cos_sum Output sum of the cosines of the phases.
+ *  \param sin_sum Output sum of the sines of the phases.
+ */
+void sumPhases(const FractionalPoints& points, int h, int k, int l, double& cos_sum, double& sin_sum)
+{
+    alignas(32) float turns[box::BOX_BATCH_SIZE] = {};
+    alignas(32) float sines[box::BOX_BATCH_SIZE];
+    alignas(32) float cosines[box::BOX_BATCH_SIZE];
+    cos_sum = 0;
+    sin_sum = 0;
+    for (size_t begin = 0; begin < points.size; begin += box::BOX_BATCH_SIZE)
+    {
+        const unsigned int n
+            = static_cast<unsigned int>(std::min<size_t>(box::BOX_BATCH_SIZE, points.size - begin));
+        const double* x = points.x.data() + begin;
+        const double* y = points.y.data() + begin;
+        const double* z = points.z.data() + begin;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            const double t = h * x[i] + k * y[i] + l * z[i];
+            turns[i] = static_cast<float>(t - std::floor(t));
+        }
+        box::sinCosTurns(turns, sines, cosines, n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            cos_sum += cosines[i];
+            sin_sum += sines[i];
+        }
+    }
+}
+
+//! Volume of a sphere of radius r weighted by sin(k r) / (k r).
+double sincBallVolume(double k, double r)
+{
+    const double kr = k * r;
+    if (kr < 1e-2)
+    {
+        // Avoid the cancellation of the closed form for small k r.
+        return 4.0 / 3.0 * M_PI * r * r * r * (1.0 - kr * kr / 10.0);
+    }
+    return 4.0 * M_PI * (std::sin(kr) - kr * std::cos(kr)) / (k * k * k);
+}
+
+} // namespace
+
+StaticStructureFactor::StaticStructureFactor(unsigned int bins, float k_max, float k_min,
+                                             StaticStructureFactorMethod method, float r_max,
+                                             unsigned int max_k_points)
+    : BondHistogramCompute(), m_method(method), m_r_max(r_max), m_max_k_points(max_k_points),
+      m_k_sums(bins, 0)
+{
+    if (bins == 0)
+    {
+        throw std::invalid_argument("StaticStructureFactor requires a nonzero number of bins.");
+    }
+    if (k_max <= 0)
+    {
+        throw std::invalid_argument("StaticStructureFactor requires k_max to be positive.");
+    }
+    if (k_min < 0)
+    {
+        throw std::invalid_argument("StaticStructureFactor requires k_min to be nonnegative.");
+    }
+    if (k_max <= k_min)
+    {
+        throw std::invalid_argument("StaticStructureFactor requires that k_max must be greater than k_min.");
+    }
+    if (method != structure_factor_debye && method != structure_factor_direct)
+    {
+        throw std::invalid_argument("StaticStructureFactor requires a valid method.");
+    }
+
+    m_k_axis = std::make_shared<util::RegularAxis>(bins, k_min, k_max);
+    m_histogram = BondHistogram(BHAxes {m_k_axis});
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    if (method == structure_factor_debye)
+    {
+        if (r_max <= 0)
+        {
+            throw std::invalid_argument(
+                "The Debye method of StaticStructureFactor requires r_max to be positive.");
+        }
+        const auto r_bins = static_cast<size_t>(std::ceil(r_max * k_max / DEBYE_MAX_PHASE_STEP));
+        m_r_axis = std::make_shared<util::RegularAxis>(std::max<size_t>(r_bins, 1), 0, r_max);
+        m_distance_histogram = BondHistogram(BHAxes {m_r_axis});
+        m_local_distance_histograms = BondHistogram::ThreadLocalHistogram(m_distance_histogram);
+    }
+}
+
+void StaticStructureFactor::reset()
+{
+    BondHistogramCompute::reset();
+    m_local_distance_histograms.reset();
+    m_query_point_sum = 0;
+    m_density_sum = 0;
+    std::fill(m_k_sums.begin(), m_k_sums.end(), 0);
+}
+
+void StaticStructureFactor::setAccumulationStrategy(util::AccumulationStrategy strategy)
+{
+    if (m_r_axis)
+    {
+        m_local_distance_histograms = BondHistogram::ThreadLocalHistogram(m_distance_histogram, strategy);
+    }
+    BondHistogramCompute::setAccumulationStrategy(strategy);
+}
+
+void StaticStructureFactor::accumulate(const freud::locality::NeighborQuery* neighbor_query,
+                                       const vec3<float>* query_points, unsigned int n_query_points,
+                                       const freud::locality::NeighborList* nlist,
+                                       freud::locality::QueryArgs qargs)
+{
+    if (m_method == structure_factor_debye)
+    {
+        accumulateDebye(neighbor_query, query_points, n_query_points, nlist, qargs);
+    }
+    else
+    {
+        if (nlist != nullptr)
+        {
+            throw std::invalid_argument(
+                "The direct method of StaticStructureFactor does not support neighbor lists.");
+        }
+        accumulateDirect(neighbor_query, query_points, n_query_points);
+    }
+}
+
+void StaticStructureFactor::accumulateDebye(const freud::locality::NeighborQuery* neighbor_query,
+                                            const vec3<float>* query_points, unsigned int n_query_points,
+                                            const freud::locality::NeighborList* nlist,
+                                            freud::locality::QueryArgs qargs)
+{
+    const box::Box& box = neighbor_query->getBox();
+    if (box.is2D())
+    {
+        throw std::invalid_argument("The Debye method of StaticStructureFactor requires a 3D box.");
+    }
+
+    // The uniform density beyond r_max is only well defined in periodic boxes.
+    const vec3<bool> periodic = box.getPeriodic();
+    if (periodic.x && periodic.y && periodic.z)
+    {
+        m_density_sum += double(n_query_points) * double(neighbor_query->getNPoints()) / box.getVolume();
+    }
+    m_query_point_sum += n_query_points;
+
+    const util::RegularAxis& r_axis = *m_r_axis;
+    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
+                      [&](const freud::locality::NeighborBond& neighbor_bond) {
+                          m_local_distance_histograms.increment(r_axis.bin(neighbor_bond.distance));
+                      });
+}
+
+void StaticStructureFactor::accumulateDirect(const freud::locality::NeighborQuery* neighbor_query,
+                                             const vec3<float>* query_points, unsigned int n_query_points)
+{
+    const box::Box& box = neighbor_query->getBox();
+    const unsigned int n_points = neighbor_query->getNPoints();
+    const bool is2D = box.is2D();
+
+    // Reciprocal lattice vectors b_i, with a_i . b_j = 2 pi delta_ij.
+    const vec3<double> a0(box.getLatticeVector(0));
+    const vec3<double> a1(box.getLatticeVector(1));
+    vec3<double> b0;
+    vec3<double> b1;
+    vec3<double> b2;
+    double a2_length = 0;
+    if (is2D)
+    {
+        const double area = a0.x * a1.y - a0.y * a1.x;
+        b0 = vec3<double>(a1.y, -a1.x, 0) * (constants::TWO_PI / area);
+        b1 = vec3<double>(-a0.y, a0.x, 0) * (constants::TWO_PI / area);
+    }
+    else
+    {
+        const vec3<double> a2(box.getLatticeVector(2));
+        const double volume = dot(a0, cross(a1, a2));
+        b0 = cross(a1, a2) * (constants::TWO_PI / volume);
+        b1 = cross(a2, a0) * (constants::TWO_PI / volume);
+        b2 = cross(a0, a1) * (constants::TWO_PI / volume);
+        a2_length = std::sqrt(dot(a2, a2));
+    }
+
+    // The Miller index h of a k-vector is k . a_0 / (2 pi), so it is bounded
+    // by k_max |a_0| / (2 pi), and similarly for the other indices.
+    const double k_max = m_k_axis->getMax();
+    const int h_max = static_cast<int>(k_max * std::sqrt(dot(a0, a0)) / constants::TWO_PI);
+    const int k_max_index = static_cast<int>(k_max * std::sqrt(dot(a1, a1)) / constants::TWO_PI);
+    const int l_max = static_cast<int>(k_max * a2_length / constants::TWO_PI);
+
+    // Visit the k-vectors in the half space (h, k, l) > 0 in lexicographic
+    // order, with the bins of their magnitudes.
+    const util::RegularAxis& k_axis = *m_k_axis;
+    auto for_each_k_vector = [&](const auto& visit) {
+        for (int h = 0; h <= h_max; ++h)
+        {
+            for (int k = (h == 0) ? 0 : -k_max_index; k <= k_max_index; ++k)
+            {
+                for (int l = (h == 0 && k == 0) ? 1 : -l_max; l <= l_max; ++l)
+                {
+                    const vec3<double> k_vector = double(h) * b0 + double(k) * b1 + double(l) * b2;
+                    const size_t bin = k_axis.bin(static_cast<float>(std::sqrt(dot(k_vector, k_vector))));
+                    if (bin != util::Axis::OVERFLOW_BIN)
+                    {
+                        visit(h, k, l, bin);
+                    }
+                }
+            }
+        }
+    };
+
+    // Bins with more k-vectors than the limit keep an evenly spaced subset.
+    const size_t bins = k_axis.size();
+    std::vector<size_t> bin_sizes(bins, 0);
+    for_each_k_vector([&](int, int, int, size_t bin) { ++bin_sizes[bin]; });
+    const size_t bin_limit = (m_max_k_points == 0) ? std::numeric_limits<size_t>::max()
+                                                   : (m_max_k_points + bins - 1) / bins;
+
+    std::vector<vec3<int>> miller_indices;
+    std::vector<size_t> k_bins;
+    std::vector<size_t> bin_positions(bins, 0);
+    for_each_k_vector([&](int h, int k, int l, size_t bin) {
+        const size_t j = bin_positions[bin]++;
+        const size_t n = bin_sizes[bin];
+        if (n <= bin_limit || (j + 1) * bin_limit / n > j * bin_limit / n)
+        {
+            miller_indices.emplace_back(h, k, l);
+            k_bins.push_back(bin);
+        }
+    });
+
+    const FractionalPoints points(box, neighbor_query->getPoints(), n_points);
+    const bool same_points = (query_points == neighbor_query->getPoints()) && (n_query_points == n_points);
+    const FractionalPoints query(box, same_points ? nullptr : query_points, same_points ? 0 : n_query_points);
+
+    std::vector<double> structure_factors(miller_indices.size());
+    util::forLoopWrapper(0, miller_indices.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const vec3<int>& index = miller_indices[i];
+            double cos_sum;
+            double sin_sum;
+            sumPhases(points, index.x, index.y, index.z, cos_sum, sin_sum);
+            double query_cos_sum = cos_sum;
+            double query_sin_sum = sin_sum;
+            if (!same_points)
+            {
+                sumPhases(query, index.x, index.y, index.z, query_cos_sum, query_sin_sum);
+            }
+            structure_factors[i] = (cos_sum * query_cos_sum + sin_sum * query_sin_sum) / n_query_points;
+        }
+    });
+
+    for (size_t i = 0; i < miller_indices.size(); ++i)
+    {
+        m_k_sums[k_bins[i]] += structure_factors[i];
+        m_local_histograms.increment(k_bins[i]);
+    }
+
+    m_box = box;
+    m_frame_counter++;
+    m_n_points = n_points;
+    m_n_query_points = n_query_points;
+    m_reduce = true;
+}
+
+void StaticStructureFactor::reduce()
+{
+    const size_t bins = m_k_axis->size();
+    m_structure_factor.prepare(bins);
+
+    if (m_method == structure_factor_direct)
+    {
+        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+            m_structure_factor[i] = (m_histogram[i] > 0) ? float(m_k_sums[i] / m_histogram[i])
+                                                         : std::numeric_limits<float>::quiet_NaN();
+        });
+        return;
+    }
+
+    m_distance_histogram.reduceOverThreads(m_local_distance_histograms);
+
+    // Only the occupied distance bins contribute to the Debye sums.
+    const std::vector<float> r_centers = m_r_axis->getBinCenters();
+    std::vector<double> distances;
+    std::vector<double> counts;
+    for (size_t i = 0; i < r_centers.size(); ++i)
+    {
+        if (m_distance_histogram[i] != 0)
+        {
+            distances.push_back(r_centers[i]);
+            counts.push_back(m_distance_histogram[i]);
+        }
+    }
+
+    const std::vector<float> k_centers = m_k_axis->getBinCenters();
+    util::forLoopWrapper(0, bins, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (m_query_point_sum == 0)
+            {
+                m_structure_factor[i] = std::numeric_limits<float>::quiet_NaN();
+                continue;
+            }
+            const double k = k_centers[i];
+            double sum = 0;
+            for (size_t j = 0; j < distances.size(); ++j)
+            {
+                const double kr = k * distances[j];
+                sum += counts[j] * std::sin(kr) / kr;
+            }
+            m_structure_factor[i] = float(1.0 + (sum - m_density_sum * sincBallVolume(k, m_r_max))
+                                                    / m_query_point_sum);
+        }
+    });
+}
+
+}; }; // end namespace freud::diffraction
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef STATIC_STRUCTURE_FACTOR_H
+#define STATIC_STRUCTURE_FACTOR_H
+
+#include <memory>
+#include <vector>
+
+#include "BondHistogramCompute.h"
+#include "Box.h"
+#include "Histogram.h"
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file StaticStructureFactor.h
+    \brief Routines for computing static structure factors.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Methods for computing static structure factors.
+typedef enum
+{
+    structure_factor_debye = 1, //!< Transform the histogram of the distances between points.
+    structure_factor_direct = 2 //!< Sum the phases of the points for the periodic k-vectors of the box.
+} StaticStructureFactorMethod;
+
+//! Computes the static structure factor S(k) binned by the magnitude of k.
+/*! <b>Debye method:</b><br>
+    The distances of all bonds shorter than r_max are histogrammed in parallel
+    with a bin width small compared to 1/k_max, and the structure factor is
+    evaluated at the k bin centers with the Debye formula
+
+    S(k) = 1 + 1/N sum_bonds sin(k r) / (k r) - rho V_r(k),
+
+    where V_r(k) = 4 pi (sin(k r_max) - k r_max cos(k r_max)) / k^3 removes
+    the contribution of a uniform density rho beyond the cutoff in boxes
+    that are periodic in all dimensions. The self term 1 assumes that the
+    query points are the points, and that the bond of each point with itself
+    is excluded. The Debye method requires a 3D box.
+
+    <b>Direct method:</b><br>
+    The structure factor is evaluated at the k-vectors allowed by the
+    periodic box, k = h b_1 + k b_2 + l b_3 for integers h, k, l and the
+    reciprocal lattice vectors b_i, as
+
+    S(k) = 1/N_query Re(conj(sum_p exp(i k.r_p)) sum_q exp(i k.r_q))
+
+    and averaged over the k-vectors in each bin. The phases are computed from
+    fractional coordinates with vectorized sines and cosines, and the
+    k-vectors are distributed among threads. Since S(-k) = S(k), only half of
+    the k-vectors are evaluated. If max_k_points is nonzero, each bin uses at
+    most ceil(max_k_points / bins) of its k-vectors, spread evenly through
+    the enumeration of the lattice. Bins without any allowed k-vectors are NaN.
+
+    Both methods accumulate over frames, whose boxes and numbers of points
+    may differ. The bin counts of the histogram are the numbers of k-vectors
+    averaged in each bin by the direct method.
+*/
+class StaticStructureFactor : public locality::BondHistogramCompute
+{
+public:
+    //! Constructor
+    /*! \param bins Number of bins in k.
+     *  \param k_max Maximum magnitude of k.
+     *  \param k_min Minimum magnitude of k.
+     *  \param method Method computing the structure factor.
+     *  \param r_max Maximum bond distance of the Debye method (ignored by the direct method).
+     *  \param max_k_points Maximum number of k-vectors of the direct method, or 0 to use all of them.
+     */
+    StaticStructureFactor(unsigned int bins, float k_max, float k_min = 0,
+                          StaticStructureFactorMethod method = structure_factor_debye, float r_max = 0,
+                          unsigned int max_k_points = 10000);
+
+    //! Destructor
+    ~StaticStructureFactor() override = default;
+
+    //! Reset the accumulated structure factor to all zeros.
+    void reset() override;
+
+    //! Set the strategy for accumulating the k and distance histograms across threads.
+    void setAccumulationStrategy(util::AccumulationStrategy strategy) override;
+
+    //! Accumulate the structure factor of the given points.
+    /*! The direct method does not use neighbors, so nlist must be null.
+     */
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                    freud::locality::QueryArgs qargs);
+
+    //! Reduce thread-local arrays onto the primary data arrays.
+    void reduce() override;
+
+    //! Get the structure factor at the k bin centers.
+    const util::ManagedArray<float>& getStructureFactor()
+    {
+        return reduceAndReturn(m_structure_factor);
+    }
+
+    //! Get the method computing the structure factor.
+    StaticStructureFactorMethod getMethod() const
+    {
+        return m_method;
+    }
+
+    //! Get the maximum bond distance of the Debye method.
+    float getRMax() const
+    {
+        return m_r_max;
+    }
+
+    //! Get the maximum number of k-vectors of the direct method.
+    unsigned int getMaxKPoints() const
+    {
+        return m_max_k_points;
+    }
+
+private:
+    //! Accumulate the structure factor with the Debye method.
+    void accumulateDebye(const freud::locality::NeighborQuery* neighbor_query,
+                         const vec3<float>* query_points, unsigned int n_query_points,
+                         const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
+
+    //! Accumulate the structure factor with the direct method.
+    void accumulateDirect(const freud::locality::NeighborQuery* neighbor_query,
+                          const vec3<float>* query_points, unsigned int n_query_points);
+
+    StaticStructureFactorMethod m_method;        //!< Method computing the structure factor.
+    float m_r_max;                               //!< Maximum bond distance of the Debye method.
+    unsigned int m_max_k_points;                 //!< Maximum number of k-vectors of the direct method.
+    std::shared_ptr<util::RegularAxis> m_k_axis; //!< Axis binning the magnitudes of k.
+    std::shared_ptr<util::RegularAxis> m_r_axis; //!< Axis binning the bond distances (Debye).
+
+    BondHistogram m_distance_histogram; //!< Histogram of the bond distances (Debye).
+    BondHistogram::ThreadLocalHistogram
+        m_local_distance_histograms; //!< Thread local bond distance counts (Debye).
+    double m_query_point_sum {0};    //!< Sum over frames of the number of query points (Debye).
+    double m_density_sum {0};        //!< Sum over frames of N_query * N_points / V (Debye).
+
+    std::vector<double> m_k_sums; //!< Sum over frames and k-vectors of S(k) in each bin (direct).
+
+    util::ManagedArray<float> m_structure_factor; //!< The computed structure factor.
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // STATIC_STRUCTURE_FACTOR_H
@@ -129,75 +129,87 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     }
 }
 
-NeighborBond AABBQueryBallIterator::next()
+void AABBQueryBallIterator::scanLeaf(unsigned int node_idx, const vec3<float>& query_point_image)
 {
-    float r_max_sq = m_r_max * m_r_max;
-    float r_min_sq = m_r_min * m_r_min;
+    static_assert(NODE_CAPACITY <= util::DISTANCE_BATCH_SIZE, "AABB leaves must fit in a distance batch.");
+
+    util::DistanceBatch batch;
+    const vec3<float>* points = m_neighbor_query->getPoints();
+    const unsigned int num_particles = m_aabb_query->m_aabb_tree.getNodeNumParticles(node_idx);
+    for (unsigned int p = 0; p < num_particles; ++p)
+    {
+        // Neighbor j
+        const unsigned int j = m_aabb_query->m_aabb_tree.getNodeParticleTag(node_idx, p);
+
+        // Skip ii matches immediately if requested.
+        if (m_exclude_ii && m_query_point_idx == j)
+        {
+            continue;
+        }
+        batch.push(j, points[j]);
+    }
+
+    m_cur_hit = 0;
+    m_num_hits = util::ballDistanceBatch(query_point_image, batch, m_r_min * m_r_min, m_r_max * m_r_max,
+                                         !m_is2D, m_hit_indices, m_hit_r_sq);
+}
 
+NeighborBond AABBQueryBallIterator::next()
+{
     // Read in the position of current point
     vec3<float> pos_i(m_query_point);
-    if (m_neighbor_query->getBox().is2D())
+    if (m_is2D)
     {
         pos_i.z = 0;
     }
 
-    // Loop over image vectors
-    while (cur_image < m_n_images)
+    while (true)
     {
+        // Return the neighbors found in the last leaf before searching further.
+        if (m_cur_hit < m_num_hits)
+        {
+            const unsigned int j = m_hit_indices[m_cur_hit];
+            const float r_sq = m_hit_r_sq[m_cur_hit];
+            ++m_cur_hit;
+            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+        }
+
+        m_num_hits = 0;
+
+        // Loop over image vectors
+        if (cur_image >= m_n_images)
+        {
+            break;
+        }
+
         // Make an AABB for the image of this point
         vec3<float> pos_i_image = pos_i + m_image_list[cur_image];
         AABBSphere asphere = AABBSphere(pos_i_image, m_r_max);
 
-        // Stackless traversal of the tree
-        while (cur_node_idx < m_aabb_query->m_aabb_tree.getNumNodes())
+        // Stackless traversal of the tree, stopping at the first leaf with neighbors
+        while (cur_node_idx < m_aabb_query->m_aabb_tree.getNumNodes() && m_num_hits == 0)
         {
-            if (overlap(m_aabb_query->m_aabb_tree.getNodeAABB(cur_node_idx), asphere))
+            const unsigned int node_idx = cur_node_idx;
+            if (overlap(m_aabb_query->m_aabb_tree.getNodeAABB(node_idx), asphere))
             {
-                if (m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                if (m_aabb_query->m_aabb_tree.isNodeLeaf(node_idx))
                 {
-                    while (cur_ref_p < m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx))
-                    {
-                        // Neighbor j
-                        const unsigned int j
-                            = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
-                        // Increment before possible return.
-                        cur_ref_p++;
-
-                        // Skip ii matches immediately if requested.
-                        if (m_exclude_ii && m_query_point_idx == j)
-                        {
-                            continue;
-                        }
-
-                        // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
-                        if (m_neighbor_query->getBox().is2D())
-                        {
-                            pos_j.z = 0;
-                        }
-
-                        // Compute distance
-                        const vec3<float> r_ij = pos_j - pos_i_image;
-                        const float r_sq = dot(r_ij, r_ij);
-
-                        // Check ii exclusion before including the pair.
-                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                        {
-                            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
-                        }
-                    }
+                    scanLeaf(node_idx, pos_i_image);
                 }
             }
             else
             {
                 // Skip ahead
-                cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(cur_node_idx);
+                cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(node_idx);
             }
             cur_node_idx++;
-            cur_ref_p = 0;
         } // end stackless search
-        cur_image++;
-        cur_node_idx = 0;
+
+        if (cur_node_idx >= m_aabb_query->m_aabb_tree.getNumNodes())
+        {
+            cur_image++;
+            cur_node_idx = 0;
+        }
     } // end loop over images
 
     m_finished = true;
@@ -12,6 +12,7 @@
 
 #include "AABBTree.h"
 #include "Box.h"
+#include "DistanceBatch.h"
 #include "NeighborQuery.h"
 
 /*! \file AABBQuery.h
@@ -174,6 +175,10 @@ protected:
 };
 
 //! Iterator that gets neighbors in a ball of size r_max using AABB tree structures.
+/*! Each overlapping leaf of the tree is scanned as a single batch with
+ *  util::ballDistanceBatch against the current periodic image of the query
+ *  point. Neighbors found in a leaf are buffered and returned one by one.
+ */
 class AABBQueryBallIterator : public AABBIterator
 {
 public:
@@ -182,7 +187,7 @@ public:
                           unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
                           bool _check_r_max = true)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), cur_image(0),
-          cur_node_idx(0), cur_ref_p(0)
+          cur_node_idx(0), m_is2D(neighbor_query->getBox().is2D())
     {
         updateImageVectors(m_r_max, _check_r_max);
     }
@@ -193,11 +198,23 @@ public:
     //! Get the next element.
     NeighborBond next() override;
 
+    //! Get the squared distance of the bond last returned by next().
+    float getLastDistanceSquared(const NeighborBond& /*bond*/) const override
+    {
+        return m_hit_r_sq[m_cur_hit - 1];
+    }
+
 private:
+    //! Find the distances of all particles in a leaf node to an image of the query point.
+    void scanLeaf(unsigned int node_idx, const vec3<float>& query_point_image);
+
     unsigned int cur_image;    //!< The current node in the tree.
     unsigned int cur_node_idx; //!< The current node in the tree.
-    unsigned int
-        cur_ref_p; //!< The current index into the reference particles in the current node of the tree.
+    bool m_is2D;               //!< Whether the box is 2D.
+    unsigned int m_hit_indices[util::DISTANCE_BATCH_SIZE]; //!< Neighbors found in the last leaf.
+    float m_hit_r_sq[util::DISTANCE_BATCH_SIZE];           //!< Squared distances of the neighbors found.
+    unsigned int m_num_hits {0}; //!< Number of neighbors found in the last leaf.
+    unsigned int m_cur_hit {0};  //!< Index of the next buffered neighbor to return.
 };
 }; }; // end namespace freud::locality
 
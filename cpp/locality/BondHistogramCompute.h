@@ -87,6 +87,23 @@ public:
         return m_histogram.getAxisSizes();
     }
 
+    //! Get the requested strategy for accumulating bin counts across threads.
+    util::AccumulationStrategy getAccumulationStrategy() const
+    {
+        return m_accumulation_strategy;
+    }
+
+    //! Set the strategy for accumulating bin counts across threads.
+    /*! The thread local bins are rebuilt, so all accumulated data is reset.
+     *  By default the strategy is chosen automatically (see BinAccumulator).
+     */
+    virtual void setAccumulationStrategy(util::AccumulationStrategy strategy)
+    {
+        m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, strategy);
+        m_accumulation_strategy = strategy;
+        reset();
+    }
+
     //! \internal
     // Wrapper to do accumulation.
     /*! \param neighbor_query NeighborQuery object to iterate over
@@ -116,6 +133,8 @@ protected:
     unsigned int m_n_points {0};       //!< The number of points.
     unsigned int m_n_query_points {0}; //!< The number of query points.
     bool m_reduce {true};              //!< Whether or not the histogram needs to be reduced.
+    util::AccumulationStrategy m_accumulation_strategy {
+        util::AccumulationStrategy::automatic}; //!< Strategy for accumulating bin counts.
 
     util::Histogram<unsigned int> m_histogram; //!< Histogram of interparticle distances (bond lengths).
     util::Histogram<unsigned int>::ThreadLocalHistogram
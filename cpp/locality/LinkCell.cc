@@ -3,9 +3,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <numeric>
 #include <stdexcept>
 
 #include "LinkCell.h"
+#include "utils.h"
 
 /*! \file LinkCell.cc
     \brief Build a cell list from a set of points.
@@ -248,23 +251,25 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
         throw std::runtime_error("At least one cell must be present.");
     }
 
+    m_lattice_a = box.getLatticeVector(0);
+    m_lattice_b = box.getLatticeVector(1);
+    if (!box.is2D())
+    {
+        m_lattice_c = box.getLatticeVector(2);
+    }
+
+    m_wrap_x = CellAxisWrap(m_celldim.x);
+    m_wrap_y = CellAxisWrap(m_celldim.y);
+    m_wrap_z = CellAxisWrap(m_celldim.z);
+
+    computeCellStencil();
+    computeCellNeighbors();
     computeCellList(points, n_points);
 }
 
 unsigned int LinkCell::getCellIndex(const vec3<int> cellCoord) const
 {
-    int w = static_cast<int>(m_celldim.x);
-    int h = static_cast<int>(m_celldim.y);
-    int d = static_cast<int>(m_celldim.z);
-
-    int x = cellCoord.x % w;
-    x += (x < 0 ? w : 0);
-    int y = cellCoord.y % h;
-    y += (y < 0 ? h : 0);
-    int z = cellCoord.z % d;
-    z += (z < 0 ? d : 0);
-
-    return coordToIndex(x, y, z);
+    return coordToIndex(m_wrap_x.wrap(cellCoord.x), m_wrap_y.wrap(cellCoord.y), m_wrap_z.wrap(cellCoord.z));
 }
 
 vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, float cell_width)
@@ -318,10 +323,18 @@ void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
         m_cell_list[n_points + cell] = LINK_CELL_TERMINATOR;
     }
 
-    // Generate the cell list.
+    // Generate the cell list, keeping track of whether every point lies in
+    // the cell grid without wrapping (required to use image shifts).
+    m_points_in_box = true;
     for (unsigned int i = n_points - 1; i != static_cast<unsigned int>(-1); --i)
     {
-        unsigned int cell = getCell(points[i]);
+        const vec3<int> c = getUnwrappedCellCoord(points[i]);
+        if (c.x < 0 || c.x >= static_cast<int>(m_celldim.x) || c.y < 0
+            || c.y >= static_cast<int>(m_celldim.y) || c.z < 0 || c.z >= static_cast<int>(m_celldim.z))
+        {
+            m_points_in_box = false;
+        }
+        unsigned int cell = getCellIndex(c);
         m_cell_list[i] = m_cell_list[n_points + cell];
         m_cell_list[n_points + cell] = i;
     }
@@ -329,145 +342,121 @@ void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
 
 vec3<unsigned int> LinkCell::indexToCoord(unsigned int x) const
 {
-    std::vector<size_t> coord
-        = util::ManagedArray<unsigned int>::getMultiIndex({m_celldim.x, m_celldim.y, m_celldim.z}, x);
-    // For backwards compatibility with the Index1D layout, the indices and
-    // the dimensions are passed in reverse to the indexer. Changing this would
-    // also require updating the logic in IteratorCellShell.
-    return vec3<unsigned int>(coord[2], coord[1], coord[0]);
+    // For backwards compatibility with the Index1D layout, x is the fastest
+    // varying index. Changing this would also require updating the logic in
+    // IteratorCellShell.
+    return vec3<unsigned int>(x % m_celldim.x, (x / m_celldim.x) % m_celldim.y,
+                              x / (m_celldim.x * m_celldim.y));
 }
 
 unsigned int LinkCell::coordToIndex(unsigned int x, unsigned int y, unsigned int z) const
 {
-    // For backwards compatibility with the Index1D layout, the indices and
-    // the dimensions are passed in reverse to the indexer. Changing this would
-    // also require updating the logic in IteratorCellShell.
-    return util::ManagedArray<unsigned int>::getIndex(
-        {m_celldim.z, m_celldim.y, m_celldim.x},
-        {static_cast<unsigned int>(z), static_cast<unsigned int>(y), static_cast<unsigned int>(x)});
+    // For backwards compatibility with the Index1D layout, x is the fastest
+    // varying index. Changing this would also require updating the logic in
+    // IteratorCellShell.
+    return x + m_celldim.x * (y + m_celldim.y * z);
 }
 
 vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
+{
+    // Wrap with a positive modulus so that points outside the box are placed
+    // in the cell of their periodic image.
+    const vec3<int> c = getUnwrappedCellCoord(p);
+    return {m_wrap_x.wrap(c.x), m_wrap_y.wrap(c.y), m_wrap_z.wrap(c.z)};
+}
+
+vec3<int> LinkCell::getUnwrappedCellCoord(const vec3<float>& p) const
 {
     vec3<float> alpha = m_box.makeFractional(p);
-    vec3<unsigned int> c;
-    c.x = (unsigned int) std::floor(alpha.x * float(m_celldim.x));
-    c.x %= m_celldim.x;
-    c.y = (unsigned int) std::floor(alpha.y * float(m_celldim.y));
-    c.y %= m_celldim.y;
-    c.z = (unsigned int) std::floor(alpha.z * float(m_celldim.z));
-    c.z %= m_celldim.z;
-    return c;
+    return {static_cast<int>(std::floor(alpha.x * float(m_celldim.x))),
+            static_cast<int>(std::floor(alpha.y * float(m_celldim.y))),
+            static_cast<int>(std::floor(alpha.z * float(m_celldim.z)))};
 }
 
-const std::vector<unsigned int>& LinkCell::getCellNeighbors(unsigned int cell) const
+vec3<float> LinkCell::getCellImageShift(const vec3<int>& cellCoord) const
 {
-    // check if the list of neighbors has been already computed
-    // return the list if it has
-    // otherwise, compute it and return
-    CellNeighbors::const_accessor a;
-    if (m_cell_neighbors.find(a, cell))
-    {
-        return a->second;
-    }
-    return computeCellNeighbors(cell);
+    return static_cast<float>(m_wrap_x.periods(cellCoord.x)) * m_lattice_a
+        + static_cast<float>(m_wrap_y.periods(cellCoord.y)) * m_lattice_b
+        + static_cast<float>(m_wrap_z.periods(cellCoord.z)) * m_lattice_c;
 }
 
-const std::vector<unsigned int>& LinkCell::computeCellNeighbors(unsigned int cur_cell) const
+bool LinkCell::supportsImageShifts(unsigned int range) const
 {
-    std::vector<unsigned int> neighbor_cells;
-    vec3<unsigned int> l_idx = indexToCoord(cur_cell);
-    const int i = static_cast<int>(l_idx.x);
-    const int j = static_cast<int>(l_idx.y);
-    const int k = static_cast<int>(l_idx.z);
-
-    // loop over the neighbor cells
-    int starti;
-    int startj;
-    int startk;
-    int endi;
-    int endj;
-    int endk;
-    if (m_celldim.x < 3)
-    {
-        starti = i;
-    }
-    else
-    {
-        starti = i - 1;
-    }
-    if (m_celldim.y < 3)
-    {
-        startj = j;
-    }
-    else
-    {
-        startj = j - 1;
-    }
-    if (m_celldim.z < 3)
-    {
-        startk = k;
-    }
-    else
-    {
-        startk = k - 1;
-    }
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const unsigned int stencil_width = 2 * range + 1;
+    return m_points_in_box && periodic.x && periodic.y && m_celldim.x >= stencil_width
+        && m_celldim.y >= stencil_width && (m_box.is2D() || (periodic.z && m_celldim.z >= stencil_width));
+}
 
-    if (m_celldim.x < 2)
-    {
-        endi = i;
-    }
-    else
-    {
-        endi = i + 1;
-    }
-    if (m_celldim.y < 2)
-    {
-        endj = j;
-    }
-    else
-    {
-        endj = j + 1;
-    }
-    if (m_celldim.z < 2)
-    {
-        endk = k;
-    }
-    else
-    {
-        endk = k + 1;
-    }
-    if (m_box.is2D())
-    {
-        startk = endk = k;
+void LinkCell::computeCellStencil()
+{
+    // Along each axis, the offsets in [-(n - 1) / 2, n / 2] reach every cell
+    // exactly once, and each offset is as close to the cell itself as any of
+    // its periodic images. The stencil of a given range is therefore the set
+    // of offsets of at most that range, and grids narrower than the stencil
+    // never alias a cell twice. Cells are defined in fractional coordinates,
+    // so the same stencil covers the adjacent cells in triclinic boxes.
+    const auto first_offset = [](unsigned int n) { return -static_cast<int>((n - 1) / 2); };
+    const auto last_offset = [](unsigned int n) { return static_cast<int>(n / 2); };
+    const auto shell = [](const vec3<int>& offset) {
+        return static_cast<unsigned int>(
+            std::max(std::abs(offset.x), std::max(std::abs(offset.y), std::abs(offset.z))));
+    };
+    const bool is2D = m_box.is2D();
+    const int startk = is2D ? 0 : first_offset(m_celldim.z);
+    const int endk = is2D ? 0 : last_offset(m_celldim.z);
+    const auto max_shell = static_cast<unsigned int>(
+        std::max(last_offset(m_celldim.x), std::max(last_offset(m_celldim.y), endk)));
+
+    // Order the offsets by shell with a counting sort, which also gives the
+    // end of each shell in the stencil.
+    m_shell_ends.assign(max_shell + 1, 0);
+    for (int k = startk; k <= endk; ++k)
+    {
+        for (int j = first_offset(m_celldim.y); j <= last_offset(m_celldim.y); ++j)
+        {
+            for (int i = first_offset(m_celldim.x); i <= last_offset(m_celldim.x); ++i)
+            {
+                ++m_shell_ends[shell(vec3<int>(i, j, k))];
+            }
+        }
     }
+    std::partial_sum(m_shell_ends.begin(), m_shell_ends.end(), m_shell_ends.begin());
 
-    for (int neighk = startk; neighk <= endk; neighk++)
+    std::vector<size_t> next_index(max_shell + 1, 0);
+    std::copy(m_shell_ends.begin(), m_shell_ends.end() - 1, next_index.begin() + 1);
+    m_stencil.resize(m_shell_ends.back());
+    for (int k = startk; k <= endk; ++k)
     {
-        for (int neighj = startj; neighj <= endj; neighj++)
+        for (int j = first_offset(m_celldim.y); j <= last_offset(m_celldim.y); ++j)
         {
-            for (int neighi = starti; neighi <= endi; neighi++)
+            for (int i = first_offset(m_celldim.x); i <= last_offset(m_celldim.x); ++i)
             {
-                // wrap back into the box
-                unsigned int wrapi = (m_celldim.x + neighi) % m_celldim.x;
-                unsigned int wrapj = (m_celldim.y + neighj) % m_celldim.y;
-                unsigned int wrapk = (m_celldim.z + neighk) % m_celldim.z;
-
-                unsigned int neigh_cell = coordToIndex(wrapi, wrapj, wrapk);
-                // add to the list
-                neighbor_cells.push_back(neigh_cell);
+                const vec3<int> offset(i, j, k);
+                m_stencil[next_index[shell(offset)]++] = offset;
             }
         }
     }
+}
 
-    // sort the list
-    std::sort(neighbor_cells.begin(), neighbor_cells.end());
-
-    // add the vector of neighbor cells to the hash table
-    CellNeighbors::accessor a;
-    m_cell_neighbors.insert(a, cur_cell);
-    a->second = neighbor_cells;
-    return a->second;
+void LinkCell::computeCellNeighbors()
+{
+    m_num_cell_neighbors = static_cast<unsigned int>(getCellStencilSize(1));
+    m_cell_neighbors.resize(static_cast<size_t>(m_size) * m_num_cell_neighbors);
+    util::forLoopWrapper(0, m_size, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            const vec3<unsigned int> coord = indexToCoord(cell);
+            const vec3<int> cell_coord(static_cast<int>(coord.x), static_cast<int>(coord.y),
+                                       static_cast<int>(coord.z));
+            unsigned int* neighbor_cells = m_cell_neighbors.data() + cell * m_num_cell_neighbors;
+            for (unsigned int n = 0; n < m_num_cell_neighbors; ++n)
+            {
+                neighbor_cells[n] = getCellIndex(cell_coord + m_stencil[n]);
+            }
+            std::sort(neighbor_cells, neighbor_cells + m_num_cell_neighbors);
+        }
+    });
 }
 
 std::shared_ptr<NeighborQueryPerPointIterator>
@@ -487,74 +476,117 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     throw std::runtime_error("Invalid query mode provided to generic query function.");
 }
 
-NeighborBond LinkCellQueryBallIterator::next()
+LinkCellQueryBallIterator::LinkCellQueryBallIterator(const LinkCell* neighbor_query,
+                                                     const vec3<float>& query_point,
+                                                     unsigned int query_point_idx, float r_max, float r_min,
+                                                     bool exclude_ii)
+    : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
+      m_query_cell(neighbor_query->getUnwrappedCellCoord(query_point))
 {
-    float r_max_sq = m_r_max * m_r_max;
-    float r_min_sq = m_r_min * m_r_min;
+    // Upon querying, if the search radius is equal to the cell width, we
+    // can guarantee that we don't need to search the cell shell past the
+    // query radius. For simplicity, we store this value as an integer.
+    const unsigned int extra_search_width = (m_r_max == neighbor_query->getCellWidth()) ? 0 : 1;
 
-    vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
+    // The last shell searched is the largest one whose closest point of
+    // approach is within r_max.
+    const auto max_range = static_cast<unsigned int>(std::floor(m_r_max / neighbor_query->getCellWidth()))
+        + extra_search_width;
+    m_use_image_shifts = neighbor_query->supportsImageShifts(max_range);
 
-    // Loop over cell list neighbor shells relative to this point's cell.
-    while (true)
+    // The first offset of the stencil is always the query point's own cell.
+    m_stencil_end = neighbor_query->getCellStencilSize(max_range);
+    m_stencil_idx = 1;
+    m_cell_iter = m_linkcell->itercell(m_linkcell->getCellIndex(m_query_cell));
+    if (m_use_image_shifts)
     {
-        // Iterate over the particles in that cell. Using a local counter
-        // variable is safe, because the IteratorLinkCell object is keeping
-        // track between calls to next.
-        for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
-        {
-            // Skip ii matches immediately if requested.
-            if (m_exclude_ii && m_query_point_idx == j)
-            {
-                continue;
-            }
+        m_query_point_image = m_query_point - m_linkcell->getCellImageShift(m_query_cell);
+    }
+}
 
-            const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-            const float r_sq(dot(r_ij, r_ij));
+void LinkCellQueryBallIterator::scanBatch()
+{
+    // Gather the next batch of particles in the current cell. Using a member
+    // iterator is safe, because the IteratorLinkCell object is keeping track
+    // between calls to next.
+    util::DistanceBatch batch;
+    const vec3<float>* points = m_linkcell->getPoints();
+    while (!batch.full())
+    {
+        const unsigned int j = m_cell_iter.next();
+        if (m_cell_iter.atEnd())
+        {
+            break;
+        }
+        // Skip ii matches immediately if requested.
+        if (m_exclude_ii && m_query_point_idx == j)
+        {
+            continue;
+        }
+        batch.push(j, points[j]);
+    }
 
-            if (r_sq < r_max_sq && r_sq >= r_min_sq)
+    const float r_max_sq = m_r_max * m_r_max;
+    const float r_min_sq = m_r_min * m_r_min;
+    m_cur_hit = 0;
+    if (m_use_image_shifts)
+    {
+        m_num_hits = util::ballDistanceBatch(m_query_point_image, batch, r_min_sq, r_max_sq, true,
+                                             m_hit_indices, m_hit_r_sq);
+    }
+    else
+    {
+        m_num_hits = 0;
+        m_neighbor_query->getBox().dispatchKernel([&](const auto& kernel) {
+            for (unsigned int i = 0; i < batch.size; ++i)
             {
-                return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+                const vec3<float> r_ij(
+                    kernel.wrap(vec3<float>(batch.x[i], batch.y[i], batch.z[i]) - m_query_point));
+                const float r_sq(dot(r_ij, r_ij));
+                if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                {
+                    m_hit_indices[m_num_hits] = batch.indices[i];
+                    m_hit_r_sq[m_num_hits] = r_sq;
+                    ++m_num_hits;
+                }
             }
-        }
-
-        bool out_of_range = false;
+        });
+    }
+}
 
-        while (true)
+NeighborBond LinkCellQueryBallIterator::next()
+{
+    // Loop over cell list neighbor shells relative to this point's cell.
+    while (true)
+    {
+        // Return the neighbors found in the last batch before scanning more.
+        if (m_cur_hit < m_num_hits)
         {
-            // Determine the next neighbor cell to consider. We're done if we
-            // reach a new shell and the closest point of approach to the new
-            // shell is greater than our r_max.
-            ++m_neigh_cell_iter;
-
-            if (static_cast<float>(m_neigh_cell_iter.getRange() - m_extra_search_width)
-                    * m_linkcell->getCellWidth()
-                > m_r_max)
-            {
-                out_of_range = true;
-                break;
-            }
+            const unsigned int j = m_hit_indices[m_cur_hit];
+            const float r_sq = m_hit_r_sq[m_cur_hit];
+            ++m_cur_hit;
+            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+        }
 
-            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-            // Insertion to an unordered set returns a pair, the second
-            // element indicates insertion success or failure (if it
-            // already exists)
-            if (m_searched_cells.insert(neighbor_cell_index).second)
-            {
-                // This cell has not been searched yet, so we will iterate
-                // over its contents. Otherwise, we loop back, increment
-                // the cell shell iterator, and try the next one.
-                m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
-                break;
-            }
+        if (!m_cell_iter.atEnd())
+        {
+            scanBatch();
+            continue;
         }
-        if (out_of_range)
+
+        // Move on to the next cell in the stencil, which lists every cell in
+        // range exactly once.
+        if (m_stencil_idx == m_stencil_end)
         {
             break;
         }
+        const vec3<int> neighbor_cell = m_query_cell + m_linkcell->getCellStencil()[m_stencil_idx];
+        ++m_stencil_idx;
+        m_cell_iter = m_linkcell->itercell(m_linkcell->getCellIndex(neighbor_cell));
+        if (m_use_image_shifts)
+        {
+            m_query_point_image = m_query_point - m_linkcell->getCellImageShift(neighbor_cell);
+        }
     }
 
     m_finished = true;
@@ -593,20 +625,22 @@ NeighborBond LinkCellQueryIterator::next()
             // previous calls to next that have not yet reset the iterator.
             if (!m_cell_iter.atEnd())
             {
-                for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
-                {
-                    // Skip ii matches immediately if requested.
-                    if (m_exclude_ii && m_query_point_idx == j)
+                m_neighbor_query->getBox().dispatchKernel([&](const auto& kernel) {
+                    for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
                     {
-                        continue;
+                        // Skip ii matches immediately if requested.
+                        if (m_exclude_ii && m_query_point_idx == j)
+                        {
+                            continue;
+                        }
+                        const vec3<float> r_ij(kernel.wrap((*m_linkcell)[j] - m_query_point));
+                        const float r_sq(dot(r_ij, r_ij));
+                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                        {
+                            m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq));
+                        }
                     }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-                    const float r_sq(dot(r_ij, r_ij));
-                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                    {
-                        m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq));
-                    }
-                }
+                });
             }
 
             while (true)
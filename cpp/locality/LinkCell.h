@@ -4,12 +4,13 @@
 #ifndef LINKCELL_H
 #define LINKCELL_H
 
+#include <algorithm>
 #include <memory>
-#include <tbb/concurrent_hash_map.h>
 #include <unordered_set>
 #include <vector>
 
 #include "Box.h"
+#include "DistanceBatch.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
 
@@ -147,6 +148,59 @@ private:
     bool m_is2D;     //!< true if the cell list is 2D
 };
 
+//! Lookup table that wraps cell coordinates along one axis of a periodic cell grid
+/*! Unwrapped coordinates within one period of the grid, i.e. in [-n, 2n),
+ *  are resolved with a single table lookup. Coordinates further away are
+ *  only reached by searches whose stencil wraps around the grid more than
+ *  once, and fall back to integer division.
+ */
+class CellAxisWrap
+{
+public:
+    //! Null Constructor
+    CellAxisWrap() = default;
+
+    //! Constructor
+    /*! \param n The number of cells along the axis.
+     */
+    explicit CellAxisWrap(unsigned int n) : m_n(static_cast<int>(n)), m_wrapped(3 * n), m_periods(3 * n)
+    {
+        for (int i = 0; i < 3 * m_n; ++i)
+        {
+            m_wrapped[i] = static_cast<unsigned int>(i % m_n);
+            m_periods[i] = i / m_n - 1;
+        }
+    }
+
+    //! Get the coordinate of the cell in the grid that is an image of cell c
+    unsigned int wrap(int c) const
+    {
+        const int i = c + m_n;
+        if (i >= 0 && i < 3 * m_n)
+        {
+            return m_wrapped[i];
+        }
+        const int w = c % m_n;
+        return static_cast<unsigned int>(w < 0 ? w + m_n : w);
+    }
+
+    //! Get the number of grid periods by which cell c is displaced, rounded towards negative infinity
+    int periods(int c) const
+    {
+        const int i = c + m_n;
+        if (i >= 0 && i < 3 * m_n)
+        {
+            return m_periods[i];
+        }
+        return (c >= 0) ? c / m_n : -((-c + m_n - 1) / m_n);
+    }
+
+private:
+    int m_n {0};                         //!< Number of cells along the axis
+    std::vector<unsigned int> m_wrapped; //!< Wrapped coordinate for each unwrapped coordinate in [-n, 2n)
+    std::vector<int> m_periods;          //!< Period count for each unwrapped coordinate in [-n, 2n)
+};
+
 //! Computes a cell id for each particle and a link cell data structure for iterating through it
 /*! For simplicity in only needing a small number of arrays, the link cell
  *  algorithm is used to generate and store the cell list data for particles.
@@ -218,14 +272,59 @@ public:
     //! Compute cell coordinates for a given position
     vec3<unsigned int> getCellCoord(const vec3<float>& p) const;
 
+    //! Compute cell coordinates for a given position without wrapping them into the cell grid
+    vec3<int> getUnwrappedCellCoord(const vec3<float>& p) const;
+
+    //! Compute the lattice translation that maps a cell back into the cell grid
+    /*! A cell coordinate outside the grid refers to a periodic image of a
+     *  cell inside the grid. The returned vector is the translation that must
+     *  be added to the positions of the points stored in the wrapped cell to
+     *  place them in the requested image.
+     */
+    vec3<float> getCellImageShift(const vec3<int>& cellCoord) const;
+
+    //! Whether queries searching up to range cells away may use precomputed image shifts
+    /*! Image shifts can only be used instead of wrapping every bond vector
+     *  if all points lie inside the box and no two cells within the search
+     *  range are periodic images of each other.
+     */
+    bool supportsImageShifts(unsigned int range) const;
+
     //! Iterate over particles in a cell
     IteratorLinkCell itercell(unsigned int cell) const
     {
         return IteratorLinkCell(m_cell_list, m_n_points, getNumCells(), cell);
     }
 
-    //! Get a list of neighbors to a cell
-    const std::vector<unsigned int>& getCellNeighbors(unsigned int cell) const;
+    //! Get the relative coordinates of all cells of the grid with respect to any cell
+    /*! The stencil is computed once per cell grid. It lists every cell of the
+     *  grid exactly once, ordered by shell starting with the cell itself, so
+     *  the cells up to range cells away from a cell are given by the first
+     *  getCellStencilSize(range) offsets. Since the cells are defined in
+     *  fractional coordinates, the same stencil applies to triclinic boxes.
+     */
+    const std::vector<vec3<int>>& getCellStencil() const
+    {
+        return m_stencil;
+    }
+
+    //! Get the number of leading stencil offsets that are at most range cells away
+    size_t getCellStencilSize(unsigned int range) const
+    {
+        return m_shell_ends[std::min<size_t>(range, m_shell_ends.size() - 1)];
+    }
+
+    //! Get the number of neighbors of each cell (including the cell itself)
+    unsigned int getNumCellNeighbors() const
+    {
+        return m_num_cell_neighbors;
+    }
+
+    //! Get a sorted list of the getNumCellNeighbors() neighbors to a cell
+    const unsigned int* getCellNeighbors(unsigned int cell) const
+    {
+        return m_cell_neighbors.data() + static_cast<size_t>(cell) * m_num_cell_neighbors;
+    }
 
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
@@ -239,16 +338,29 @@ public:
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
 private:
-    //! Helper function to compute cell neighbors
-    const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
+    //! Helper function to compute the cell stencil
+    void computeCellStencil();
+
+    //! Helper function to compute the cell neighbors of every cell
+    void computeCellNeighbors();
 
     float m_cell_width {0};                 //!< Minimum necessary cell width cutoff
     vec3<unsigned int> m_celldim {0, 0, 0}; //!< Cell dimensions
     unsigned int m_size {0};                //!< The size of cell list.
+    bool m_points_in_box {false};           //!< Whether all points lie inside the primary box image.
+    vec3<float> m_lattice_a {0, 0, 0};      //!< First lattice vector of the box.
+    vec3<float> m_lattice_b {0, 0, 0};      //!< Second lattice vector of the box.
+    vec3<float> m_lattice_c {0, 0, 0};      //!< Third lattice vector of the box (zero in 2D).
+
+    CellAxisWrap m_wrap_x;                  //!< Periodic wrap table along the first lattice vector.
+    CellAxisWrap m_wrap_y;                  //!< Periodic wrap table along the second lattice vector.
+    CellAxisWrap m_wrap_z;                  //!< Periodic wrap table along the third lattice vector.
 
     util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
-    using CellNeighbors = tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>>;
-    mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
+    std::vector<vec3<int>> m_stencil;           //!< Relative coordinates of all cells, ordered by shell.
+    std::vector<size_t> m_shell_ends;           //!< End of each shell in the stencil, indexed by range.
+    unsigned int m_num_cell_neighbors {0};      //!< Number of neighbors of each cell.
+    std::vector<unsigned int> m_cell_neighbors; //!< Sorted neighbors of each cell, one row per cell.
 };
 
 //! Parent class of LinkCell iterators that knows how to traverse general cell-linked list structures.
@@ -263,20 +375,15 @@ public:
                      unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
                                         exclude_ii),
-          m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->getBox().is2D()),
-          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
+          m_linkcell(neighbor_query), m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
     {}
 
     //! Empty Destructor
     ~LinkCellIterator() override = default;
 
 protected:
-    const LinkCell* m_linkcell; //!< Link to the LinkCell object
-    IteratorCellShell
-        m_neigh_cell_iter;        //!< The shell iterator indicating how far out we're currently searching.
+    const LinkCell* m_linkcell;   //!< Link to the LinkCell object
     IteratorLinkCell m_cell_iter; //!< The cell iterator indicating which cell we're currently searching.
-    std::unordered_set<unsigned int>
-        m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
 };
 
 //! Iterator that gets specified numbers of nearest neighbors from LinkCell tree structures.
@@ -288,7 +395,7 @@ public:
                           unsigned int query_point_idx, unsigned int num_neighbors, float r_max, float r_min,
                           bool exclude_ii)
         : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
-          m_count(0), m_num_neighbors(num_neighbors)
+          m_neigh_cell_iter(0, neighbor_query->getBox().is2D()), m_count(0), m_num_neighbors(num_neighbors)
     {}
 
     //! Empty Destructor
@@ -298,32 +405,30 @@ public:
     NeighborBond next() override;
 
 protected:
+    IteratorCellShell
+        m_neigh_cell_iter; //!< The shell iterator indicating how far out we're currently searching.
+    std::unordered_set<unsigned int>
+        m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
     std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
 };
 
 //! Iterator that gets neighbors in a ball of size r using LinkCell tree structures.
+/*! The cells within range of the query point are visited in the order of
+ *  the cell stencil of LinkCell, which lists every cell exactly once. Their
+ *  particles are scanned one batch of cell contents at a time using
+ *  util::ballDistanceBatch. When the cell list allows it (see
+ *  LinkCell::supportsImageShifts), the query point is translated once per
+ *  cell by the periodic image shift of that cell, so no per-bond wrapping is
+ *  required. Neighbors found in a batch are buffered and returned one by one.
+ */
 class LinkCellQueryBallIterator : public LinkCellIterator
 {
 public:
     //! Constructor
     LinkCellQueryBallIterator(const LinkCell* neighbor_query, const vec3<float>& query_point,
-                              unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
-        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
-    {
-        // Upon querying, if the search radius is equal to the cell width, we
-        // can guarantee that we don't need to search the cell shell past the
-        // query radius. For simplicity, we store this value as an integer.
-        if (m_r_max == neighbor_query->getCellWidth())
-        {
-            m_extra_search_width = 0;
-        }
-        else
-        {
-            m_extra_search_width = 1;
-        }
-    }
+                              unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii);
 
     //! Empty Destructor
     ~LinkCellQueryBallIterator() override = default;
@@ -331,8 +436,25 @@ public:
     //! Get the next element.
     NeighborBond next() override;
 
+    //! Get the squared distance of the bond last returned by next().
+    float getLastDistanceSquared(const NeighborBond& /*bond*/) const override
+    {
+        return m_hit_r_sq[m_cur_hit - 1];
+    }
+
 protected:
-    int m_extra_search_width; //!< The extra shell distance to search, always 0 or 1.
+    //! Find the distances of the next batch of particles in the current cell.
+    void scanBatch();
+
+    vec3<int> m_query_cell;         //!< Unwrapped cell coordinates of the query point.
+    size_t m_stencil_idx {0};       //!< Index of the next cell to search in the stencil.
+    size_t m_stencil_end {0};       //!< Number of stencil cells to search.
+    bool m_use_image_shifts;        //!< Whether cells are searched with precomputed image shifts.
+    vec3<float> m_query_point_image; //!< Query point translated by the image shift of the current cell.
+    unsigned int m_hit_indices[util::DISTANCE_BATCH_SIZE]; //!< Neighbors found in the last batch.
+    float m_hit_r_sq[util::DISTANCE_BATCH_SIZE];           //!< Squared distances of the neighbors found.
+    unsigned int m_num_hits {0}; //!< Number of neighbors found in the last batch.
+    unsigned int m_cur_hit {0};  //!< Index of the next buffered neighbor to return.
 };
 }; }; // end namespace freud::locality
 
@@ -119,38 +119,7 @@ void NeighborList::updateSegmentCounts() const
 // accept an "end" parameter as well.
 template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
 {
-    const unsigned int old_size(getNumBonds());
-    const auto end = begin + old_size;
-
-    // new_size is the number of good (unfiltered-out) elements
-    const unsigned int new_size(std::count(begin, end, true));
-
-    // Arrays to hold filtered data - we use new arrays instead of writing over
-    // existing data to avoid requiring a second pass in resize().
-    auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
-    auto new_distances = util::ManagedArray<float>(new_size);
-    auto new_weights = util::ManagedArray<float>(new_size);
-
-    auto current_element = begin;
-    unsigned int num_good(0);
-    for (unsigned int i(0); i < old_size; ++i)
-    {
-        if (*current_element)
-        {
-            new_neighbors(num_good, 0) = m_neighbors(i, 0);
-            new_neighbors(num_good, 1) = m_neighbors(i, 1);
-            new_weights[num_good] = m_weights[i];
-            new_distances[num_good] = m_distances[i];
-            ++num_good;
-        }
-        ++current_element;
-    }
-
-    m_neighbors = new_neighbors;
-    m_distances = new_distances;
-    m_weights = new_weights;
-    m_segments_counts_updated = false;
-    return old_size - new_size;
+    return filter_if([begin](unsigned int i) { return static_cast<bool>(*(begin + i)); });
 }
 
 // Explicit template instantiation required for usage in dynamically linked
@@ -162,12 +131,103 @@ template unsigned int NeighborList::filter(bool*);
 
 unsigned int NeighborList::filter_r(float r_max, float r_min)
 {
-    std::vector<bool> dist_filter(getNumBonds());
-    for (unsigned int i(0); i < getNumBonds(); ++i)
-    {
-        dist_filter[i] = (m_distances[i] >= r_min && m_distances[i] < r_max);
-    }
-    return filter(dist_filter.cbegin());
+    return filter_if([this, r_max, r_min](unsigned int i) {
+        return m_distances[i] >= r_min && m_distances[i] < r_max;
+    });
+}
+
+NeighborList* NeighborList::setUnion(const NeighborList& other) const
+{
+    return mergeBonds(other, true, true, true);
+}
+
+NeighborList* NeighborList::setIntersection(const NeighborList& other) const
+{
+    return mergeBonds(other, false, true, false);
+}
+
+NeighborList* NeighborList::setDifference(const NeighborList& other) const
+{
+    return mergeBonds(other, true, false, false);
+}
+
+NeighborList* NeighborList::mergeBonds(const NeighborList& other, bool keep_this_only, bool keep_both,
+                                       bool keep_other_only) const
+{
+    other.validate(m_num_query_points, m_num_points);
+    const util::ManagedArray<unsigned int>& segments = getSegments();
+    const util::ManagedArray<unsigned int>& counts = getCounts();
+    const util::ManagedArray<unsigned int>& other_segments = other.getSegments();
+    const util::ManagedArray<unsigned int>& other_counts = other.getCounts();
+
+    // Merge the bonds of query point i, which are sorted by point index in
+    // both lists, calling emit(list, bond) for each bond of the result.
+    // Bonds present in both lists are taken from this object.
+    const auto merge_query_point = [&](unsigned int i, const auto& emit) {
+        unsigned int bond(segments[i]);
+        unsigned int other_bond(other_segments[i]);
+        const unsigned int bond_end(bond + counts[i]);
+        const unsigned int other_bond_end(other_bond + other_counts[i]);
+        while (bond < bond_end || other_bond < other_bond_end)
+        {
+            if (other_bond == other_bond_end
+                || (bond < bond_end && m_neighbors(bond, 1) < other.m_neighbors(other_bond, 1)))
+            {
+                if (keep_this_only)
+                {
+                    emit(*this, bond);
+                }
+                ++bond;
+            }
+            else if (bond == bond_end || other.m_neighbors(other_bond, 1) < m_neighbors(bond, 1))
+            {
+                if (keep_other_only)
+                {
+                    emit(other, other_bond);
+                }
+                ++other_bond;
+            }
+            else
+            {
+                if (keep_both)
+                {
+                    emit(*this, bond);
+                }
+                ++bond;
+                ++other_bond;
+            }
+        }
+    };
+
+    // Count the bonds of each query point in the result, then scan the
+    // counts to find the offset at which each query point writes its bonds.
+    std::vector<unsigned int> offsets(m_num_query_points + 1, 0);
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        for (auto i = static_cast<unsigned int>(begin); i < end; ++i)
+        {
+            unsigned int num_bonds(0);
+            merge_query_point(i, [&num_bonds](const NeighborList&, unsigned int) { ++num_bonds; });
+            offsets[i + 1] = num_bonds;
+        }
+    });
+    std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+
+    auto* result = new NeighborList();
+    result->setNumBonds(offsets[m_num_query_points], m_num_query_points, m_num_points);
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        for (auto i = static_cast<unsigned int>(begin); i < end; ++i)
+        {
+            unsigned int result_bond(offsets[i]);
+            merge_query_point(i, [&](const NeighborList& source, unsigned int bond) {
+                result->m_neighbors(result_bond, 0) = source.m_neighbors(bond, 0);
+                result->m_neighbors(result_bond, 1) = source.m_neighbors(bond, 1);
+                result->m_distances[result_bond] = source.m_distances[bond];
+                result->m_weights[result_bond] = source.m_weights[bond];
+                ++result_bond;
+            });
+        }
+    });
+    return result;
 }
 
 unsigned int NeighborList::find_first_index(unsigned int i) const
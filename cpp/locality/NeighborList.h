@@ -4,12 +4,15 @@
 #ifndef NEIGHBOR_LIST_H
 #define NEIGHBOR_LIST_H
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborBond.h"
 #include "VectorMath.h"
+#include "utils.h"
 
 namespace freud { namespace locality {
 
@@ -113,6 +116,17 @@ public:
     //! Remove bonds in this object based on minimum and maximum distance
     //  constraints. Returns the number of bonds removed.
     unsigned int filter_r(float r_max, float r_min = 0);
+    //! Remove bonds in this object for which keep(bond_index) is false.
+    //  The bonds are compacted in parallel and keep may be called more than
+    //  once per bond. Returns the number of bonds removed.
+    template<typename Predicate> unsigned int filter_if(const Predicate& keep);
+
+    //! Return a new NeighborList with the bonds in either this object or other
+    NeighborList* setUnion(const NeighborList& other) const;
+    //! Return a new NeighborList with the bonds in both this object and other
+    NeighborList* setIntersection(const NeighborList& other) const;
+    //! Return a new NeighborList with the bonds in this object that are not in other
+    NeighborList* setDifference(const NeighborList& other) const;
 
     //! Return the first bond index corresponding to point i
     unsigned int find_first_index(unsigned int i) const;
@@ -130,6 +144,10 @@ private:
     //! Helper method for bisection search of the neighbor list, used in find_first_index
     unsigned int bisection_search(unsigned int val, unsigned int left, unsigned int right) const;
 
+    //! Helper method for the set operations, merging the bonds of each query point in parallel
+    NeighborList* mergeBonds(const NeighborList& other, bool keep_this_only, bool keep_both,
+                             bool keep_other_only) const;
+
     //! Number of query points
     unsigned int m_num_query_points;
     //! Number of points
@@ -149,6 +167,64 @@ private:
     mutable util::ManagedArray<unsigned int> m_segments;
 };
 
+//! Number of bonds processed by each task when filtering bonds in parallel.
+constexpr unsigned int FILTER_BLOCK_SIZE = 4096;
+
+template<typename Predicate> unsigned int NeighborList::filter_if(const Predicate& keep)
+{
+    const unsigned int old_size(getNumBonds());
+    const unsigned int num_blocks((old_size + FILTER_BLOCK_SIZE - 1) / FILTER_BLOCK_SIZE);
+    const auto block_end
+        = [old_size](unsigned int block) { return std::min(old_size, (block + 1) * FILTER_BLOCK_SIZE); };
+
+    // Count the bonds kept in each block, then scan the counts to find the
+    // offset at which each block writes its bonds.
+    std::vector<unsigned int> block_offsets(num_blocks + 1, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (auto block = static_cast<unsigned int>(begin); block < end; ++block)
+        {
+            unsigned int num_good(0);
+            for (unsigned int i(block * FILTER_BLOCK_SIZE); i < block_end(block); ++i)
+            {
+                num_good += static_cast<unsigned int>(static_cast<bool>(keep(i)));
+            }
+            block_offsets[block + 1] = num_good;
+        }
+    });
+    std::partial_sum(block_offsets.cbegin(), block_offsets.cend(), block_offsets.begin());
+    const unsigned int new_size(block_offsets[num_blocks]);
+
+    // Arrays to hold filtered data - we use new arrays instead of writing over
+    // existing data so that blocks can be scattered independently.
+    auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
+    auto new_distances = util::ManagedArray<float>(new_size);
+    auto new_weights = util::ManagedArray<float>(new_size);
+
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (auto block = static_cast<unsigned int>(begin); block < end; ++block)
+        {
+            unsigned int num_good(block_offsets[block]);
+            for (unsigned int i(block * FILTER_BLOCK_SIZE); i < block_end(block); ++i)
+            {
+                if (keep(i))
+                {
+                    new_neighbors(num_good, 0) = m_neighbors(i, 0);
+                    new_neighbors(num_good, 1) = m_neighbors(i, 1);
+                    new_weights[num_good] = m_weights[i];
+                    new_distances[num_good] = m_distances[i];
+                    ++num_good;
+                }
+            }
+        }
+    });
+
+    m_neighbors = new_neighbors;
+    m_distances = new_distances;
+    m_weights = new_weights;
+    m_segments_counts_updated = false;
+    return old_size - new_size;
+}
+
 bool compareNeighborBond(const NeighborBond& left, const NeighborBond& right);
 bool compareNeighborDistance(const NeighborBond& left, const NeighborBond& right);
 bool compareFirstNeighborPairs(const std::vector<NeighborBond>& left, const std::vector<NeighborBond>& right);
@@ -4,11 +4,14 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
 #include <utility>
+#include <vector>
 
 #include "Box.h"
 #include "NeighborBond.h"
@@ -60,6 +63,14 @@ struct QueryArgs
     float scale {DEFAULT_SCALE};          //! The scale factor to use when performing repeated ball queries
                                           //! to find a specified number of nearest neighbors.
     bool exclude_ii {DEFAULT_EXCLUDE_II}; //! If true, exclude self-neighbors.
+    std::vector<float> r_shells;          //! Sorted cutoff distances of nested neighbor shells. If set,
+                                          //! the query is performed up to the largest cutoff.
+    unsigned int num_types {0};           //! The number of types with per-type-pair cutoffs.
+    const float* r_max_pairs {nullptr};   //! Row-major (num_types, num_types) matrix of cutoff distances
+                                          //! indexed by query point type and point type. If set, the
+                                          //! query is performed up to the largest cutoff.
+    const unsigned int* point_types {nullptr};       //! The type of each point (used with r_max_pairs).
+    const unsigned int* query_point_types {nullptr}; //! The type of each query point (used with r_max_pairs).
 };
 
 // Forward declare the iterators
@@ -184,6 +195,8 @@ protected:
      */
     virtual void validateQueryArgs(QueryArgs& args) const
     {
+        validateShells(args);
+        validatePairCutoffs(args);
         inferMode(args);
         // Validate remaining arguments.
         if (args.mode == QueryType::ball)
@@ -201,6 +214,11 @@ protected:
         }
         else if (args.mode == QueryType::nearest)
         {
+            if (args.r_max_pairs != nullptr)
+            {
+                throw std::runtime_error(
+                    "Per-type-pair cutoffs can only be used when performing ball queries.");
+            }
             if (args.num_neighbors == DEFAULT_NUM_NEIGHBORS)
             {
                 throw std::runtime_error("You must set num_neighbors in the query arguments when performing "
@@ -217,6 +235,70 @@ protected:
         }
     }
 
+    //! Validate the shell cutoffs and use the largest one as r_max.
+    void validateShells(QueryArgs& args) const
+    {
+        if (args.r_shells.empty())
+        {
+            return;
+        }
+        if (std::adjacent_find(args.r_shells.cbegin(), args.r_shells.cend(), std::greater_equal<float>())
+            != args.r_shells.cend())
+        {
+            throw std::invalid_argument("The shell cutoffs r_shells must be strictly increasing.");
+        }
+        if (args.r_shells.front() <= args.r_min)
+        {
+            throw std::invalid_argument("The shell cutoffs r_shells must be greater than r_min.");
+        }
+        if (args.r_max == DEFAULT_R_MAX)
+        {
+            args.r_max = args.r_shells.back();
+        }
+        else if (args.r_max != args.r_shells.back())
+        {
+            throw std::invalid_argument("If r_max is set along with r_shells, it must be equal to the "
+                                        "largest shell cutoff.");
+        }
+    }
+
+    //! Validate the per-type-pair cutoffs and use the largest one as r_max.
+    /*! The types themselves are validated once per query by the
+     *  NeighborQueryIterator, since checking them scales with the number of
+     *  points.
+     */
+    void validatePairCutoffs(QueryArgs& args) const
+    {
+        if (args.r_max_pairs == nullptr)
+        {
+            return;
+        }
+        if (args.num_types == 0 || args.point_types == nullptr || args.query_point_types == nullptr)
+        {
+            throw std::invalid_argument("Per-type-pair cutoffs require the number of types and the types of "
+                                        "the points and query points.");
+        }
+        if (!args.r_shells.empty())
+        {
+            throw std::invalid_argument("Per-type-pair cutoffs cannot be combined with r_shells.");
+        }
+        const float* r_max_pairs_end = args.r_max_pairs + args.num_types * args.num_types;
+        if (*std::min_element(args.r_max_pairs, r_max_pairs_end) <= args.r_min)
+        {
+            throw std::invalid_argument("The per-type-pair cutoffs must be greater than r_min.");
+        }
+        const float r_max_pair = *std::max_element(args.r_max_pairs, r_max_pairs_end);
+        if (args.r_max == DEFAULT_R_MAX)
+        {
+            args.r_max = r_max_pair;
+        }
+        else if (args.r_max != r_max_pair)
+        {
+            throw std::invalid_argument("If r_max is set along with per-type-pair cutoffs, it must be equal "
+                                        "to the largest pair cutoff.");
+        }
+    }
+
     //! Try to determine the query mode if one is not specified.
     /*! If no mode is specified and a number of neighbors is specified, the
      *  query mode must be a nearest neighbors query (all other arguments can
@@ -279,6 +361,16 @@ public:
     //! Get the next element.
     NeighborBond next() override = 0;
 
+    //! Get the squared distance of the bond last returned by next().
+    /*! Ball queries accept bonds by comparing squared distances, which cannot
+     *  be recovered exactly from the rounded distance of the bond, so
+     *  iterators that keep them override this.
+     */
+    virtual float getLastDistanceSquared(const NeighborBond& bond) const
+    {
+        return bond.distance * bond.distance;
+    }
+
 protected:
     const NeighborQuery* m_neighbor_query;       //!< Link to the NeighborQuery object.
     const vec3<float> m_query_point = {0, 0, 0}; //!< Coordinates of the query point.
@@ -288,6 +380,65 @@ protected:
     bool m_exclude_ii; //!< Flag to indicate whether or not to include self bonds.
 };
 
+//! Per-point iterator that applies per-type-pair cutoffs to the bonds found by another iterator.
+/*! The wrapped iterator searches up to the largest pair cutoff, so it only
+ *  prunes candidates that cannot be neighbors for any pair of types. Bonds
+ *  are then accepted if they are shorter than the cutoff for the types of
+ *  their query point and point. As in the ball query itself, the squared
+ *  distance each bond was accepted with is compared against the squared
+ *  cutoff, so every bond is kept exactly when a ball query with its pair
+ *  cutoff would find it.
+ */
+class TypePairCutoffIterator : public NeighborQueryPerPointIterator
+{
+public:
+    //! Constructor
+    /*! \param r_max_sq_row The squared cutoffs between the type of the query point and each point type.
+     */
+    TypePairCutoffIterator(std::shared_ptr<NeighborQueryPerPointIterator> iter,
+                           const NeighborQuery* neighbor_query, const vec3<float>& query_point,
+                           unsigned int query_point_idx, const QueryArgs& qargs, const float* r_max_sq_row)
+        : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, qargs.r_max,
+                                        qargs.r_min, qargs.exclude_ii),
+          m_iter(std::move(iter)), m_point_types(qargs.point_types), m_r_max_sq_row(r_max_sq_row)
+    {}
+
+    //! Empty Destructor
+    ~TypePairCutoffIterator() override = default;
+
+    //! Indicate when done.
+    bool end() const override
+    {
+        return m_iter->end();
+    }
+
+    //! Get the next element.
+    NeighborBond next() override
+    {
+        while (!m_iter->end())
+        {
+            const NeighborBond nb = m_iter->next();
+            if (nb != ITERATOR_TERMINATOR
+                && m_iter->getLastDistanceSquared(nb) < m_r_max_sq_row[m_point_types[nb.point_idx]])
+            {
+                return nb;
+            }
+        }
+        return ITERATOR_TERMINATOR;
+    }
+
+    //! Get the squared distance of the bond last returned by next().
+    float getLastDistanceSquared(const NeighborBond& bond) const override
+    {
+        return m_iter->getLastDistanceSquared(bond);
+    }
+
+private:
+    std::shared_ptr<NeighborQueryPerPointIterator> m_iter; //!< Iterator searching up to the largest cutoff.
+    const unsigned int* m_point_types;                     //!< The type of each point.
+    const float* m_r_max_sq_row; //!< The squared cutoffs between the query point's type and each point type.
+};
+
 //! The iterator class for neighbor queries on NeighborQuery objects.
 /*! All queries to a NeighborQuery return instances of this class. The
  *  NeighborQueryIterator is capable of either iterating over all neighbors of
@@ -309,6 +460,16 @@ public:
         : m_neighbor_query(neighbor_query), m_query_points(query_points),
           m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0)
     {
+        if (m_qargs.r_max_pairs != nullptr)
+        {
+            validateTypes(m_qargs.point_types, m_neighbor_query->getNPoints());
+            validateTypes(m_qargs.query_point_types, m_num_query_points);
+            // Square the cutoffs once, in the same precision the ball query
+            // squares r_max with.
+            m_r_max_pairs_sq.resize(m_qargs.num_types * m_qargs.num_types);
+            std::transform(m_qargs.r_max_pairs, m_qargs.r_max_pairs + m_r_max_pairs_sq.size(),
+                           m_r_max_pairs_sq.begin(), [](float r) { return r * r; });
+        }
         m_iter = this->query(m_cur_p);
     }
 
@@ -324,7 +485,15 @@ public:
     //! Get an iterator for a specific query point by index.
     std::shared_ptr<NeighborQueryPerPointIterator> query(unsigned int i)
     {
-        return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
+        std::shared_ptr<NeighborQueryPerPointIterator> iter
+            = m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
+        if (m_qargs.r_max_pairs != nullptr)
+        {
+            return std::make_shared<TypePairCutoffIterator>(
+                std::move(iter), m_neighbor_query, m_query_points[i], i, m_qargs,
+                m_r_max_pairs_sq.data() + m_qargs.query_point_types[i] * m_qargs.num_types);
+        }
+        return iter;
     }
 
     //! Get the next element.
@@ -372,10 +541,129 @@ public:
      */
     NeighborList* toNeighborList(bool sort_by_distance = false)
     {
-        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+        return makeNeighborList(findBonds<NeighborBond>(sort_by_distance));
+    }
+
+    //! Generate one NeighborList per shell cutoff from a single query.
+    /*! The neighbors are found once, up to the largest cutoff in
+     *  QueryArgs::r_shells, and each bond is then assigned to the
+     *  innermost shell that contains it. The lists are nested: the list for
+     *  shell k contains all bonds with distances less than r_shells[k]. If
+     *  no shells were requested, a single list containing all neighbors is
+     *  returned.
+     *
+     *  Shells are assigned by comparing the squared distance each bond was
+     *  accepted with against the squared cutoffs, exactly as the query
+     *  itself applies r_max, so every bond lands in the same shell as in a
+     *  separate query with that shell's cutoff.
+     *
+     *  As with toNeighborList, the caller is responsible for deleting the
+     *  returned NeighborList objects.
+     */
+    std::vector<NeighborList*> toNeighborLists(bool sort_by_distance = false)
+    {
+        const std::vector<float>& shells = m_qargs.r_shells;
+        if (shells.empty())
+        {
+            return {makeNeighborList(findBonds<NeighborBond>(sort_by_distance))};
+        }
+        const std::vector<ShellBond> linear_bonds = findBonds<ShellBond>(sort_by_distance);
+
+        const size_t num_shells = shells.size();
+        std::vector<float> shells_sq(num_shells);
+        std::transform(shells.cbegin(), shells.cend(), shells_sq.begin(), [](float r) { return r * r; });
+
+        // The query already applied the largest cutoff, so bonds beyond every
+        // other shell belong to the last one.
+        const size_t num_bonds = linear_bonds.size();
+        std::vector<unsigned int> bond_shells(num_bonds);
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                bond_shells[bond] = static_cast<unsigned int>(
+                    std::upper_bound(shells_sq.cbegin(), shells_sq.cend() - 1, linear_bonds[bond].distance_sq)
+                    - shells_sq.cbegin());
+            }
+        });
+
+        // Bonds are kept in the order of the full list, so that every
+        // shell's list has the same sorting as toNeighborList would produce.
+        std::vector<NeighborList*> nlists(num_shells);
+        util::forLoopWrapper(0, num_shells, [&](size_t begin, size_t end) {
+            for (size_t shell = begin; shell < end; ++shell)
+            {
+                const auto num_shell_bonds = static_cast<unsigned int>(
+                    std::count_if(bond_shells.cbegin(), bond_shells.cend(),
+                                  [shell](unsigned int bond_shell) { return bond_shell <= shell; }));
+                auto* nl = new NeighborList();
+                nl->setNumBonds(num_shell_bonds, m_num_query_points, m_neighbor_query->getNPoints());
+                unsigned int shell_bond = 0;
+                for (size_t bond = 0; bond < num_bonds; ++bond)
+                {
+                    if (bond_shells[bond] <= shell)
+                    {
+                        const NeighborBond& nb = linear_bonds[bond].bond;
+                        nl->getNeighbors()(shell_bond, 0) = nb.query_point_idx;
+                        nl->getNeighbors()(shell_bond, 1) = nb.point_idx;
+                        nl->getDistances()[shell_bond] = nb.distance;
+                        nl->getWeights()[shell_bond] = float(1.0);
+                        ++shell_bond;
+                    }
+                }
+                nlists[shell] = nl;
+            }
+        });
+        return nlists;
+    }
+
+private:
+    //! Check that all types are valid indices into the per-type-pair cutoffs.
+    void validateTypes(const unsigned int* types, unsigned int n) const
+    {
+        if (std::any_of(types, types + n, [this](unsigned int type) { return type >= m_qargs.num_types; }))
+        {
+            throw std::invalid_argument("All types must be less than the number of types with per-type-pair "
+                                        "cutoffs.");
+        }
+    }
+
+    //! A bond along with the squared distance it was accepted with.
+    struct ShellBond
+    {
+        NeighborBond bond;
+        float distance_sq;
+    };
+
+    static void addBond(std::vector<NeighborBond>& bonds, const NeighborBond& nb,
+                        const NeighborQueryPerPointIterator& /*it*/)
+    {
+        bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+    }
+
+    static void addBond(std::vector<ShellBond>& bonds, const NeighborBond& nb,
+                        const NeighborQueryPerPointIterator& it)
+    {
+        bonds.push_back({NeighborBond(nb.query_point_idx, nb.point_idx, nb.distance),
+                         it.getLastDistanceSquared(nb)});
+    }
+
+    static const NeighborBond& bondOf(const NeighborBond& bond)
+    {
+        return bond;
+    }
+
+    static const NeighborBond& bondOf(const ShellBond& bond)
+    {
+        return bond.bond;
+    }
+
+    //! Find the neighbors of all query points in parallel and sort them.
+    template<typename Bond> std::vector<Bond> findBonds(bool sort_by_distance)
+    {
+        using BondVector = tbb::enumerable_thread_specific<std::vector<Bond>>;
         BondVector bonds;
         util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
-            BondVector::reference local_bonds(bonds.local());
+            typename BondVector::reference local_bonds(bonds.local());
             NeighborBond nb;
             for (size_t i = begin; i < end; ++i)
             {
@@ -386,23 +674,37 @@ public:
                     // If we're excluding ii bonds, we have to check before adding.
                     if (nb != ITERATOR_TERMINATOR)
                     {
-                        local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+                        addBond(local_bonds, nb, *it);
                     }
                 }
             }
         });
 
         tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
-        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
-        if (sort_by_distance)
-        {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborDistance);
-        }
-        else
-        {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
-        }
+        std::vector<Bond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
+        util::executeInActiveContext([&]() {
+            if (sort_by_distance)
+            {
+                tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(),
+                                   [](const Bond& left, const Bond& right) {
+                                       return compareNeighborDistance(bondOf(left), bondOf(right));
+                                   });
+            }
+            else
+            {
+                tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(),
+                                   [](const Bond& left, const Bond& right) {
+                                       return compareNeighborBond(bondOf(left), bondOf(right));
+                                   });
+            }
+        });
 
+        return linear_bonds;
+    }
+
+    //! Create a NeighborList from a sorted vector of bonds.
+    NeighborList* makeNeighborList(const std::vector<NeighborBond>& linear_bonds) const
+    {
         unsigned int num_bonds = linear_bonds.size();
 
         auto* nl = new NeighborList();
@@ -426,6 +728,7 @@ protected:
     const vec3<float>* m_query_points;                     //!< Coordinates of the query points.
     unsigned int m_num_query_points;                       //!< The number of query points.
     const QueryArgs m_qargs;                               //!< The query arguments
+    std::vector<float> m_r_max_pairs_sq;                   //!< Squared per-type-pair cutoffs, if any.
     std::shared_ptr<NeighborQueryPerPointIterator> m_iter; //!< The per-point iterator being used.
 
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next on termination).
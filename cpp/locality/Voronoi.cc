@@ -8,6 +8,7 @@
 
 #include "NeighborBond.h"
 #include "Voronoi.h"
+#include "utils.h"
 
 /*! \file Voronoi.cc
     \brief Computes Voronoi neighbors for a set of points.
@@ -160,8 +161,10 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
         } while (voronoi_loop.inc());
     }
 
-    tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
-        return n1.less_id_ref_weight(n2);
+    util::executeInActiveContext([&]() {
+        tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
+            return n1.less_id_ref_weight(n2);
+        });
     });
 
     unsigned int num_bonds = bonds.size();
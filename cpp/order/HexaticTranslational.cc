@@ -17,7 +17,7 @@ void HexaticTranslational<T>::computeGeneral(Func func, const freud::locality::N
 
     const unsigned int Np = points->getNPoints();
 
-    m_psi_array.prepare(Np);
+    prepareOutput(m_psi_array, m_psi_array_spare, {Np});
 
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), Np, qargs, nlist,
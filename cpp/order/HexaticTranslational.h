@@ -7,6 +7,7 @@
 #include <complex>
 
 #include "Box.h"
+#include "DoubleBufferedCompute.h"
 #include "ManagedArray.h"
 #include "NeighborComputeFunctional.h"
 #include "NeighborList.h"
@@ -22,14 +23,14 @@ namespace freud { namespace order {
 //! Parent class for Hexatic and Translational
 /*!
  */
-template<typename T> class HexaticTranslational
+template<typename T> class HexaticTranslational : public util::DoubleBufferedCompute
 {
 public:
     //! Constructor
     explicit HexaticTranslational(T k, bool weighted = false) : m_k(k), m_weighted(weighted) {}
 
     //! Destructor
-    virtual ~HexaticTranslational() = default;
+    ~HexaticTranslational() override = default;
 
     T getK() const
     {
@@ -57,7 +58,8 @@ protected:
     const T m_k; //!< The symmetry order for Hexatic, or normalization for Translational
     const bool
         m_weighted; //!< Whether to use neighbor weights in computing the order parameter (default false)
-    util::ManagedArray<std::complex<float>> m_psi_array; //!< psi array computed
+    util::ManagedArray<std::complex<float>> m_psi_array;       //!< psi array computed
+    util::ManagedArray<std::complex<float>> m_psi_array_spare; //!< Second buffer of m_psi_array
 };
 
 //! Compute the hexatic order parameter for a set of points
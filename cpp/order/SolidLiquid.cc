@@ -67,13 +67,8 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
         true);
 
     // Filter neighbors to contain only solid-like bonds
-    std::vector<bool> solid_filter(num_bonds);
-    for (unsigned int bond(0); bond < num_bonds; bond++)
-    {
-        solid_filter[bond] = (m_ql_ij[bond] > m_q_threshold);
-    }
     freud::locality::NeighborList solid_nlist(m_nlist);
-    solid_nlist.filter(solid_filter.cbegin());
+    solid_nlist.filter_if([this](unsigned int bond) { return m_ql_ij[bond] > m_q_threshold; });
 
     // Save the neighbor counts of solid-like bonds for each query point
     m_number_of_connections.prepare(num_query_points);
@@ -84,17 +79,12 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Filter nlist to only bonds between solid-like particles
     // (particles with more than solid_threshold solid-like bonds)
-    const unsigned int num_solid_bonds(solid_nlist.getNumBonds());
-    std::vector<bool> neighbor_count_filter(num_solid_bonds);
-    for (unsigned int bond(0); bond < num_solid_bonds; bond++)
-    {
-        const unsigned int i(solid_nlist.getNeighbors()(bond, 0));
-        const unsigned int j(solid_nlist.getNeighbors()(bond, 1));
-        neighbor_count_filter[bond] = (m_number_of_connections[i] >= m_solid_threshold
-                                       && m_number_of_connections[j] >= m_solid_threshold);
-    }
+    const auto& solid_neighbors = solid_nlist.getNeighbors();
     freud::locality::NeighborList solid_neighbor_nlist(solid_nlist);
-    solid_neighbor_nlist.filter(neighbor_count_filter.cbegin());
+    solid_neighbor_nlist.filter_if([&](unsigned int bond) {
+        return m_number_of_connections[solid_neighbors(bond, 0)] >= m_solid_threshold
+            && m_number_of_connections[solid_neighbors(bond, 1)] >= m_solid_threshold;
+    });
 
     // Find clusters of solid-like particles
     m_cluster.compute(points, &solid_neighbor_nlist, qargs);
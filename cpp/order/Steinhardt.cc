@@ -42,17 +42,17 @@ void Steinhardt::computeYlm(const float theta, const float phi, std::vector<std:
 void Steinhardt::reallocateArrays(unsigned int Np)
 {
     m_Np = Np;
-    m_qlmi.prepare({Np, m_num_ms});
+    prepareOutput(m_qlmi, m_qlmi_spare, {Np, m_num_ms});
     m_qlm.prepare(m_num_ms);
-    m_qli.prepare(Np);
+    prepareOutput(m_qli, m_qli_spare, {Np});
     if (m_average)
     {
         m_qlmiAve.prepare({Np, m_num_ms});
-        m_qliAve.prepare(Np);
+        prepareOutput(m_qliAve, m_qliAve_spare, {Np});
     }
     if (m_wl)
     {
-        m_wli.prepare(Np);
+        prepareOutput(m_wli, m_wli_spare, {Np});
     }
 }
 
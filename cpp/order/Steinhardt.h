@@ -7,6 +7,7 @@
 #include <complex>
 
 #include "Box.h"
+#include "DoubleBufferedCompute.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
@@ -53,7 +54,7 @@ namespace freud { namespace order {
  * - Wolfgang Lechner (2008) (DOI: 10.1063/Journal of Chemical Physics 129.114707)
  */
 
-class Steinhardt
+class Steinhardt : public util::DoubleBufferedCompute
 {
 public:
     //! Steinhardt Class Constructor
@@ -69,7 +70,7 @@ public:
     {}
 
     //! Empty destructor
-    ~Steinhardt() = default;
+    ~Steinhardt() override = default;
 
     //! Get the number of particles used in the last compute
     unsigned int getNP() const
@@ -193,6 +194,12 @@ private:
     float m_norm {0};                                 //!< System normalized order parameter
     util::ManagedArray<float>
         m_wli; //!< wl order parameter for each particle i, also used for wl averaged data
+
+    // Second buffers of the outputs, only used if double buffered
+    util::ManagedArray<std::complex<float>> m_qlmi_spare; //!< Second buffer of m_qlmi
+    util::ManagedArray<float> m_qli_spare;                //!< Second buffer of m_qli
+    util::ManagedArray<float> m_qliAve_spare;             //!< Second buffer of m_qliAve
+    util::ManagedArray<float> m_wli_spare;                //!< Second buffer of m_wli
 };
 
 }; };  // end namespace freud::order
@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <memory>
+#include <tbb/global_control.h>
+
 #include "tbb_config.h"
 
 /*! \file tbb_config.cc
@@ -9,28 +12,28 @@
 
 namespace freud { namespace parallel {
 
-tbb::task_scheduler_init* ts = nullptr;
+std::unique_ptr<tbb::global_control> control;
 
 /*! \param N Number of threads to use for TBB computations
 
     You do not need to call setTBBNumThreads. The default is to use the number of threads in the system. Use
    \a N=0 to set back to the default.
 
+    This limits the total number of threads used by freud in the process. To limit the threads used by
+    individual computations, e.g. when running several analyses concurrently, use util::ExecutionContext.
+
     \note setTBBNumThreads should only be called from the main thread.
 */
 void setNumThreads(unsigned int N)
 {
-    tbb::task_scheduler_init* old_ts(ts);
+    // Destroy the old control first, since only the most restrictive of
+    // simultaneously active controls takes effect.
+    control.reset();
 
-    if (N == 0)
+    if (N != 0)
     {
-        N = tbb::task_scheduler_init::automatic;
+        control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, N);
     }
-
-    delete old_ts;
-
-    // then recreate it
-    ts = new tbb::task_scheduler_init(static_cast<int>(N));
 }
 
 }; }; // end namespace freud::parallel
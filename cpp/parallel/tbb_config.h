@@ -4,8 +4,6 @@
 #ifndef TBB_CONFIG_H
 #define TBB_CONFIG_H
 
-#include <tbb/task_scheduler_init.h>
-
 /*! \file tbb_config.h
     \brief Helper functions to configure tbb
 */
@@ -0,0 +1,216 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "ArrayPool.h"
+
+/*! \file ArrayPool.cc
+    \brief Aligned allocation of array storage with an optional recycling pool.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+
+//! Shared state of the pool.
+struct PoolState
+{
+    std::atomic<bool> enabled {false};
+    std::atomic<bool> huge_pages {false};
+    std::atomic<size_t> max_cached_bytes {size_t(1) << 30};
+    std::mutex mutex;                                          //!< Guards the free lists.
+    std::unordered_map<size_t, std::vector<void*>> free_lists; //!< Cached buffers by capacity.
+    size_t cached_bytes {0};                                   //!< Total capacity of cached buffers.
+};
+
+//! Get the pool state.
+/*! The state is intentionally never destroyed, since arrays may still be
+ *  released during static destruction at interpreter shutdown.
+ */
+PoolState& getState()
+{
+    static auto* state = new PoolState();
+    return *state;
+}
+
+void* alignedAllocate(size_t alignment, size_t bytes)
+{
+    void* ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, bytes) != 0)
+    {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void alignedFree(void* ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+//! Release cached buffers (with the mutex held) until at most max_bytes remain.
+void trimLocked(PoolState& state, size_t max_bytes)
+{
+    for (auto& free_list : state.free_lists)
+    {
+        while (state.cached_bytes > max_bytes && !free_list.second.empty())
+        {
+            alignedFree(free_list.second.back());
+            free_list.second.pop_back();
+            state.cached_bytes -= free_list.first;
+        }
+    }
+}
+
+} // namespace
+
+constexpr size_t ArrayPool::ALIGNMENT;
+constexpr size_t ArrayPool::HUGE_PAGE_SIZE;
+
+size_t ArrayPool::sizeClass(size_t bytes)
+{
+    if (bytes <= ALIGNMENT)
+    {
+        return ALIGNMENT;
+    }
+    size_t power = 1;
+    while (power <= bytes / 2)
+    {
+        power *= 2;
+    }
+    const size_t step = (power / 4 > ALIGNMENT) ? power / 4 : ALIGNMENT;
+    return (bytes + step - 1) / step * step;
+}
+
+void* ArrayPool::allocate(size_t& bytes)
+{
+    PoolState& state = getState();
+    if (state.enabled)
+    {
+        bytes = sizeClass(bytes);
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto free_list = state.free_lists.find(bytes);
+        if (free_list != state.free_lists.end() && !free_list->second.empty())
+        {
+            void* ptr = free_list->second.back();
+            free_list->second.pop_back();
+            state.cached_bytes -= bytes;
+            return ptr;
+        }
+    }
+    else
+    {
+        bytes = (bytes == 0) ? ALIGNMENT : (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    if (state.huge_pages && bytes >= HUGE_PAGE_SIZE)
+    {
+        void* ptr = alignedAllocate(HUGE_PAGE_SIZE, bytes);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // This is only a hint, so failures are ignored.
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+        return ptr;
+    }
+    return alignedAllocate(ALIGNMENT, bytes);
+}
+
+void ArrayPool::deallocate(void* ptr, size_t bytes)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    PoolState& state = getState();
+    // Buffers allocated while the pool was disabled are only recycled if
+    // their capacity happens to be a size class.
+    if (state.enabled && sizeClass(bytes) == bytes)
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.cached_bytes + bytes <= state.max_cached_bytes)
+        {
+            state.free_lists[bytes].push_back(ptr);
+            state.cached_bytes += bytes;
+            return;
+        }
+    }
+    alignedFree(ptr);
+}
+
+void ArrayPool::setEnabled(bool enabled)
+{
+    getState().enabled = enabled;
+    if (!enabled)
+    {
+        clear();
+    }
+}
+
+bool ArrayPool::isEnabled()
+{
+    return getState().enabled;
+}
+
+void ArrayPool::setHugePages(bool huge_pages)
+{
+    getState().huge_pages = huge_pages;
+}
+
+bool ArrayPool::getHugePages()
+{
+    return getState().huge_pages;
+}
+
+void ArrayPool::setMaxCachedBytes(size_t max_cached_bytes)
+{
+    PoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.max_cached_bytes = max_cached_bytes;
+    trimLocked(state, max_cached_bytes);
+}
+
+size_t ArrayPool::getMaxCachedBytes()
+{
+    return getState().max_cached_bytes;
+}
+
+size_t ArrayPool::getCachedBytes()
+{
+    PoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.cached_bytes;
+}
+
+void ArrayPool::clear()
+{
+    PoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    trimLocked(state, 0);
+    state.free_lists.clear();
+}
+
+}; }; // end namespace freud::util
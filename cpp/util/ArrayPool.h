@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef ARRAY_POOL_H
+#define ARRAY_POOL_H
+
+#include <cstddef>
+
+/*! \file ArrayPool.h
+    \brief Aligned allocation of array storage with an optional recycling pool.
+*/
+
+namespace freud { namespace util {
+
+//! Allocator for the storage of ManagedArrays.
+/*! All storage is aligned to and padded up to a multiple of ALIGNMENT bytes.
+ *
+ *  When the pool is enabled, allocations are rounded up to a size class (four
+ *  classes per power of two) and freed buffers are kept in per-class free
+ *  lists instead of being returned to the system, as long as the total cached
+ *  memory stays below a limit. Repeated computations producing arrays of the
+ *  same shapes (for instance, analyzing many frames of a trajectory while
+ *  keeping references to previous results in Python) then reuse the buffers
+ *  released when the previous results are dropped, rather than calling the
+ *  system allocator on every compute.
+ *
+ *  Optionally, buffers of at least HUGE_PAGE_SIZE bytes are aligned to huge
+ *  page boundaries and marked as eligible for transparent huge pages (on
+ *  Linux only).
+ *
+ *  The pool is disabled by default.
+ */
+class ArrayPool
+{
+public:
+    //! Alignment of all buffers, in bytes.
+    static constexpr size_t ALIGNMENT = 64;
+
+    //! Size of a transparent huge page, in bytes.
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    //! Allocate a buffer of at least the requested size.
+    /*! \param bytes Requested size in bytes, updated to the capacity of the returned buffer.
+     *  \return The buffer, which must be released with deallocate.
+     */
+    static void* allocate(size_t& bytes);
+
+    //! Release a buffer, recycling it if the pool is enabled.
+    /*! \param ptr Buffer returned by allocate.
+     *  \param bytes Capacity of the buffer as returned by allocate.
+     */
+    static void deallocate(void* ptr, size_t bytes);
+
+    //! Enable or disable recycling of buffers. Disabling the pool releases all cached buffers.
+    static void setEnabled(bool enabled);
+
+    //! Whether recycling of buffers is enabled.
+    static bool isEnabled();
+
+    //! Enable or disable transparent huge pages for large buffers.
+    static void setHugePages(bool huge_pages);
+
+    //! Whether transparent huge pages are requested for large buffers.
+    static bool getHugePages();
+
+    //! Set the maximum number of bytes kept in the pool, releasing buffers if needed.
+    static void setMaxCachedBytes(size_t max_cached_bytes);
+
+    //! Get the maximum number of bytes kept in the pool.
+    static size_t getMaxCachedBytes();
+
+    //! Get the number of bytes currently kept in the pool.
+    static size_t getCachedBytes();
+
+    //! Release all cached buffers.
+    static void clear();
+
+    //! Get the size class of an allocation.
+    static size_t sizeClass(size_t bytes);
+};
+
+//! Standard allocator drawing small objects from ArrayPool.
+/*! This allocator is used for the bookkeeping that accompanies each array
+ *  buffer (shared pointer control blocks and the array shape), so that it is
+ *  recycled together with the buffers when the pool is enabled. Requests are
+ *  always rounded up to a size class, so the capacity of a block does not
+ *  depend on whether the pool was enabled when it was allocated.
+ */
+template<typename T> class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U> PoolAllocator(const PoolAllocator<U>& /*other*/) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        size_t bytes = ArrayPool::sizeClass(n * sizeof(T));
+        return static_cast<T*>(ArrayPool::allocate(bytes));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        ArrayPool::deallocate(ptr, ArrayPool::sizeClass(n * sizeof(T)));
+    }
+
+    template<typename U> bool operator==(const PoolAllocator<U>& /*other*/) const
+    {
+        return true;
+    }
+
+    template<typename U> bool operator!=(const PoolAllocator<U>& /*other*/) const
+    {
+        return false;
+    }
+};
+
+}; }; // end namespace freud::util
+
+#endif // ARRAY_POOL_H
@@ -0,0 +1,390 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BIN_ACCUMULATOR_H
+#define BIN_ACCUMULATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "ThreadStorage.h"
+#include "utils.h"
+
+/*! \file BinAccumulator.h
+    \brief Parallel accumulation into large arrays of bins with bounded memory.
+*/
+
+namespace freud { namespace util {
+
+//! Strategies for accumulating into shared bins from many threads.
+enum AccumulationStrategy
+{
+    automatic, //!< Choose a strategy from the number of bins and threads.
+    dense,     //!< A full private copy of the bins on each thread.
+    atomic,    //!< A single shared array of bins updated with atomic adds.
+    cache,     //!< Small per-thread tile caches that spill into shared atomic bins.
+    sparse     //!< Per-thread hash maps of the bins that were touched.
+};
+
+//! Shared array of bins updated atomically.
+/*! Only arithmetic types support lock-free atomic addition. The
+ *  specialization for other types (e.g. std::complex) cannot be constructed,
+ *  and strategies relying on it are never chosen for those types.
+ */
+template<typename T, bool Arithmetic = std::is_arithmetic<T>::value> class AtomicBins
+{
+public:
+    AtomicBins() = default;
+
+    explicit AtomicBins(size_t size) : m_size(size), m_bins(new std::atomic<T>[size])
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            m_bins[i].store(T(0), std::memory_order_relaxed);
+        }
+    }
+
+    void add(size_t i, T value)
+    {
+        addImpl(m_bins[i], value, std::is_integral<T>());
+    }
+
+    T operator[](size_t i) const
+    {
+        return m_bins[i].load(std::memory_order_relaxed);
+    }
+
+private:
+    static void addImpl(std::atomic<T>& bin, T value, std::true_type /*is_integral*/)
+    {
+        bin.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static void addImpl(std::atomic<T>& bin, T value, std::false_type /*is_integral*/)
+    {
+        T current = bin.load(std::memory_order_relaxed);
+        while (!bin.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    size_t m_size {0};
+    std::unique_ptr<std::atomic<T>[]> m_bins;
+};
+
+template<typename T> class AtomicBins<T, false>
+{
+public:
+    AtomicBins() = default;
+
+    explicit AtomicBins(size_t /*size*/)
+    {
+        throw std::invalid_argument("Atomic accumulation is only supported for arithmetic types.");
+    }
+
+    void reset() {}
+
+    void add(size_t /*i*/, T /*value*/) {}
+
+    T operator[](size_t /*i*/) const
+    {
+        return T(0);
+    }
+};
+
+//! Accumulate values into a flat array of bins from many threads.
+/*! Keeping a dense copy of every bin on every thread is the fastest way to
+ *  accumulate, but its memory use grows with the number of threads. For large
+ *  grids on many cores this is prohibitive, so this class offers several
+ *  strategies:
+ *
+ *  - dense: a full private copy of the bins on each thread (ThreadStorage).
+ *  - atomic: one shared array of bins, updated with atomic adds.
+ *  - cache: each thread keeps a small direct-mapped cache of contiguous tiles
+ *    of bins. Tiles evicted from the cache are added atomically into one
+ *    shared array, and all caches are flushed on reduction.
+ *  - sparse: each thread keeps a hash map of the bins it touched, which are
+ *    merged on reduction.
+ *
+ *  By default the strategy is chosen automatically: the dense strategy is used
+ *  whenever the private copies fit in DENSE_MEMORY_LIMIT bytes, otherwise the
+ *  tile cache (or the sparse strategy for non-arithmetic types) bounds the
+ *  memory to a single grid plus a small fixed amount per thread. Any strategy
+ *  can be forced through the constructor, which BondHistogramCompute and
+ *  GaussianDensity expose as setAccumulationStrategy.
+ *
+ *  All strategies produce the same result up to floating point rounding
+ *  order, and add may be called concurrently from any thread.
+ */
+template<typename T> class BinAccumulator
+{
+public:
+    //! Maximum total size in bytes of the thread-private copies used by the dense strategy.
+    static constexpr size_t DENSE_MEMORY_LIMIT = size_t(1) << 30;
+
+    //! Number of contiguous bins in one cached tile.
+    static constexpr size_t TILE_SIZE = 64;
+
+    //! Number of tiles held in each thread's cache.
+    static constexpr size_t CACHE_TILES = 256;
+
+    //! Default constructor
+    BinAccumulator() = default;
+
+    //! Constructor
+    /*! \param size Number of bins.
+     *  \param strategy Accumulation strategy to use.
+     */
+    explicit BinAccumulator(size_t size, AccumulationStrategy strategy = AccumulationStrategy::automatic)
+        : m_size(size), m_strategy(strategy)
+    {
+        if (m_strategy == AccumulationStrategy::automatic)
+        {
+            m_strategy = chooseStrategy(m_size, getMaxConcurrency());
+        }
+        if (!std::is_arithmetic<T>::value
+            && (m_strategy == AccumulationStrategy::atomic || m_strategy == AccumulationStrategy::cache))
+        {
+            throw std::invalid_argument("Atomic accumulation is only supported for arithmetic types.");
+        }
+
+        switch (m_strategy)
+        {
+        case AccumulationStrategy::dense:
+            m_dense = ThreadStorage<T>(m_size);
+            break;
+        case AccumulationStrategy::cache:
+            m_caches = tbb::enumerable_thread_specific<TileCache>([]() { return TileCache(); });
+            // fall through
+        case AccumulationStrategy::atomic:
+            m_shared = std::make_shared<AtomicBins<T>>(m_size);
+            break;
+        default:
+            break;
+        }
+    }
+
+    //! Choose the strategy used for a given number of bins and threads.
+    static AccumulationStrategy chooseStrategy(size_t size, size_t num_threads)
+    {
+        if (num_threads <= 1 || size * num_threads <= DENSE_MEMORY_LIMIT / sizeof(T))
+        {
+            return AccumulationStrategy::dense;
+        }
+        return std::is_arithmetic<T>::value ? AccumulationStrategy::cache : AccumulationStrategy::sparse;
+    }
+
+    //! Get the strategy in use.
+    AccumulationStrategy getStrategy() const
+    {
+        return m_strategy;
+    }
+
+    //! Get the number of bins.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //! Add a value to a bin. Safe to call concurrently from multiple threads.
+    void add(size_t bin, T value)
+    {
+        switch (m_strategy)
+        {
+        case AccumulationStrategy::dense:
+            m_dense.local()[bin] += value;
+            break;
+        case AccumulationStrategy::atomic:
+            m_shared->add(bin, value);
+            break;
+        case AccumulationStrategy::cache:
+            addCached(m_caches.local(), bin, value);
+            break;
+        case AccumulationStrategy::sparse:
+            m_sparse.local()[bin] += value;
+            break;
+        default:
+            break;
+        }
+    }
+
+    //! Add values to a run of consecutive bins. Safe to call concurrently from multiple threads.
+    /*! \param first_bin Index of the first bin.
+     *  \param values Values to add to bins first_bin, first_bin + 1, ...
+     *  \param count Number of values.
+     */
+    void add(size_t first_bin, const T* values, size_t count)
+    {
+        if (m_strategy == AccumulationStrategy::dense)
+        {
+            // Contiguous updates of the private bins can be vectorized.
+            T* bins = m_dense.local().get() + first_bin;
+            for (size_t i = 0; i < count; ++i)
+            {
+                bins[i] += values[i];
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            add(first_bin + i, values[i]);
+        }
+    }
+
+    //! Reset all bins to zero.
+    void reset()
+    {
+        switch (m_strategy)
+        {
+        case AccumulationStrategy::dense:
+            m_dense.reset();
+            break;
+        case AccumulationStrategy::cache:
+            for (auto cache = m_caches.begin(); cache != m_caches.end(); ++cache)
+            {
+                cache->clear();
+            }
+            // fall through
+        case AccumulationStrategy::atomic:
+            m_shared->reset();
+            break;
+        case AccumulationStrategy::sparse:
+            for (auto map = m_sparse.begin(); map != m_sparse.end(); ++map)
+            {
+                map->clear();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    //! Sum the accumulated values into the result array.
+    /*! The result is reset before the reduction and must hold size() bins.
+     *  This must not be called concurrently with add.
+     */
+    void reduceInto(ManagedArray<T>& result)
+    {
+        result.reset();
+        switch (m_strategy)
+        {
+        case AccumulationStrategy::dense:
+            m_dense.reduceInto(result);
+            break;
+        case AccumulationStrategy::cache:
+            for (auto cache = m_caches.begin(); cache != m_caches.end(); ++cache)
+            {
+                flushCache(*cache);
+            }
+            // fall through
+        case AccumulationStrategy::atomic:
+            util::forLoopWrapper(0, m_size, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    result[i] = (*m_shared)[i];
+                }
+            });
+            break;
+        case AccumulationStrategy::sparse:
+            for (auto map = m_sparse.begin(); map != m_sparse.end(); ++map)
+            {
+                for (const auto& entry : *map)
+                {
+                    result[entry.first] += entry.second;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    //! Direct-mapped cache of tiles of contiguous bins.
+    struct TileCache
+    {
+        TileCache() : tiles(CACHE_TILES, EMPTY_TILE), values(CACHE_TILES * TILE_SIZE, T(0)) {}
+
+        void clear()
+        {
+            std::fill(tiles.begin(), tiles.end(), EMPTY_TILE);
+            std::fill(values.begin(), values.end(), T(0));
+        }
+
+        std::vector<size_t> tiles; //!< The tile held in each slot.
+        std::vector<T> values;     //!< The cached values of each slot.
+    };
+
+    static constexpr size_t EMPTY_TILE = std::numeric_limits<size_t>::max();
+
+    void addCached(TileCache& cache, size_t bin, T value)
+    {
+        const size_t tile = bin / TILE_SIZE;
+        const size_t slot = tile % CACHE_TILES;
+        if (cache.tiles[slot] != tile)
+        {
+            spillSlot(cache, slot);
+            cache.tiles[slot] = tile;
+        }
+        cache.values[slot * TILE_SIZE + bin % TILE_SIZE] += value;
+    }
+
+    //! Add the values of a cache slot to the shared bins and empty it.
+    void spillSlot(TileCache& cache, size_t slot)
+    {
+        const size_t tile = cache.tiles[slot];
+        if (tile == EMPTY_TILE)
+        {
+            return;
+        }
+        T* values = &cache.values[slot * TILE_SIZE];
+        const size_t first_bin = tile * TILE_SIZE;
+        const size_t num_bins = std::min(TILE_SIZE, m_size - first_bin);
+        for (size_t i = 0; i < num_bins; ++i)
+        {
+            if (values[i] != T(0))
+            {
+                m_shared->add(first_bin + i, values[i]);
+                values[i] = T(0);
+            }
+        }
+        cache.tiles[slot] = EMPTY_TILE;
+    }
+
+    void flushCache(TileCache& cache)
+    {
+        for (size_t slot = 0; slot < CACHE_TILES; ++slot)
+        {
+            spillSlot(cache, slot);
+        }
+    }
+
+    size_t m_size {0};                                             //!< Number of bins.
+    AccumulationStrategy m_strategy {AccumulationStrategy::dense}; //!< Strategy in use.
+    ThreadStorage<T> m_dense;                                      //!< Dense per-thread bins.
+    std::shared_ptr<AtomicBins<T>> m_shared;                       //!< Shared atomic bins.
+    tbb::enumerable_thread_specific<TileCache> m_caches;           //!< Per-thread tile caches.
+    tbb::enumerable_thread_specific<std::unordered_map<size_t, T>> m_sparse; //!< Per-thread sparse bins.
+};
+
+template<typename T> constexpr size_t BinAccumulator<T>::DENSE_MEMORY_LIMIT;
+template<typename T> constexpr size_t BinAccumulator<T>::TILE_SIZE;
+template<typename T> constexpr size_t BinAccumulator<T>::CACHE_TILES;
+template<typename T> constexpr size_t BinAccumulator<T>::EMPTY_TILE;
+
+}; }; // end namespace freud::util
+
+#endif // BIN_ACCUMULATOR_H
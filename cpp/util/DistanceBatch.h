@@ -0,0 +1,165 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DISTANCE_BATCH_H
+#define DISTANCE_BATCH_H
+
+#include <bitset>
+
+#include "VectorMath.h"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/*! \file DistanceBatch.h
+    \brief Vectorized distance tests of a query point against a batch of candidate points.
+*/
+
+namespace freud { namespace util {
+
+//! Maximum number of candidates that callers should stage for one call to ballDistanceBatch.
+/*! This is the size of the buffers used by the neighbor query iterators. It
+ *  matches the AVX-512 lane width and the capacity of an AABB tree leaf.
+ */
+constexpr unsigned int DISTANCE_BATCH_SIZE = 16;
+
+//! Structure-of-arrays staging buffer for a batch of candidate points.
+/*! Points are stored in AoS layout throughout freud. Candidates are copied
+ *  into this buffer (along with their indices) while walking a cell list or a
+ *  tree leaf so that the distance test can operate on contiguous lanes.
+ */
+struct DistanceBatch
+{
+    //! Append a candidate point to the batch.
+    void push(unsigned int index, const vec3<float>& point)
+    {
+        indices[size] = index;
+        x[size] = point.x;
+        y[size] = point.y;
+        z[size] = point.z;
+        ++size;
+    }
+
+    //! Whether no more candidates can be appended.
+    bool full() const
+    {
+        return size == DISTANCE_BATCH_SIZE;
+    }
+
+    float x[DISTANCE_BATCH_SIZE];              //!< x coordinates of the candidates
+    float y[DISTANCE_BATCH_SIZE];              //!< y coordinates of the candidates
+    float z[DISTANCE_BATCH_SIZE];              //!< z coordinates of the candidates
+    unsigned int indices[DISTANCE_BATCH_SIZE]; //!< Point indices of the candidates
+    unsigned int size {0};                     //!< Number of staged candidates
+};
+
+//! Find the candidates in a batch whose squared distance lies in [r_min_sq, r_max_sq).
+/*! Periodicity is not handled here: the caller is responsible for translating
+ *  the query point by the periodic image shift that applies to the whole
+ *  batch, so that only subtractions and multiplications are needed per
+ *  candidate. Accepted candidates are compressed into the output arrays in
+ *  the order in which they appear in the batch.
+ *
+ *  The AVX-512 and AVX2 implementations are selected at compile time when the
+ *  corresponding instruction sets are enabled (e.g. with -march=native);
+ *  otherwise a scalar loop is used.
+ *
+ *  \param query_point Query point, already shifted to the periodic image of the batch.
+ *  \param batch The staged candidates.
+ *  \param r_min_sq Squared minimum distance (inclusive).
+ *  \param r_max_sq Squared maximum distance (exclusive).
+ *  \param include_z If false, the z components are ignored (2D systems).
+ *  \param hit_indices Output array of accepted indices, at least batch.size long.
+ *  \param hit_r_sq Output array of accepted squared distances, at least batch.size long.
+ *
+ *  \returns The number of accepted candidates.
+ */
+inline unsigned int ballDistanceBatch(const vec3<float>& query_point, const DistanceBatch& batch,
+                                      float r_min_sq, float r_max_sq, bool include_z,
+                                      unsigned int* hit_indices, float* hit_r_sq)
+{
+    const float z_weight = include_z ? float(1.0) : float(0.0);
+    unsigned int num_hits = 0;
+#if defined(__AVX512F__)
+    const __m512 qx = _mm512_set1_ps(query_point.x);
+    const __m512 qy = _mm512_set1_ps(query_point.y);
+    const __m512 qz = _mm512_set1_ps(query_point.z);
+    const __m512 zw = _mm512_set1_ps(z_weight);
+    const __m512 lo = _mm512_set1_ps(r_min_sq);
+    const __m512 hi = _mm512_set1_ps(r_max_sq);
+
+    const __mmask16 lanes = static_cast<__mmask16>((1u << batch.size) - 1u);
+    const __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, batch.x), qx);
+    const __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, batch.y), qy);
+    const __m512 dz = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, batch.z), qz), zw);
+    const __m512 r_sq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                      _mm512_mul_ps(dz, dz));
+    const __mmask16 hits = _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(r_sq, hi, _CMP_LT_OQ) & lanes, r_sq, lo,
+                                                   _CMP_GE_OQ);
+    const __m512i idx = _mm512_maskz_loadu_epi32(lanes, batch.indices);
+    _mm512_mask_compressstoreu_epi32(hit_indices, hits, idx);
+    _mm512_mask_compressstoreu_ps(hit_r_sq, hits, r_sq);
+    num_hits = static_cast<unsigned int>(std::bitset<16>(hits).count());
+#elif defined(__AVX2__)
+    const __m256 qx = _mm256_set1_ps(query_point.x);
+    const __m256 qy = _mm256_set1_ps(query_point.y);
+    const __m256 qz = _mm256_set1_ps(query_point.z);
+    const __m256 zw = _mm256_set1_ps(z_weight);
+    const __m256 lo = _mm256_set1_ps(r_min_sq);
+    const __m256 hi = _mm256_set1_ps(r_max_sq);
+    alignas(32) float r_sq_lanes[8];
+
+    for (unsigned int i = 0; i < batch.size; i += 8)
+    {
+        // Lanes past the end of the batch hold stale data, so they are masked
+        // out of the comparison below.
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(batch.x + i), qx);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(batch.y + i), qy);
+        const __m256 dz = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(batch.z + i), qz), zw);
+        const __m256 r_sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                          _mm256_mul_ps(dz, dz));
+        const __m256 accept
+            = _mm256_and_ps(_mm256_cmp_ps(r_sq, hi, _CMP_LT_OQ), _mm256_cmp_ps(r_sq, lo, _CMP_GE_OQ));
+        const unsigned int remaining = batch.size - i;
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(accept));
+        if (remaining < 8)
+        {
+            mask &= (1u << remaining) - 1u;
+        }
+        if (mask == 0)
+        {
+            continue;
+        }
+        _mm256_store_ps(r_sq_lanes, r_sq);
+        for (unsigned int lane = 0; mask != 0; ++lane, mask >>= 1)
+        {
+            if ((mask & 1u) != 0)
+            {
+                hit_indices[num_hits] = batch.indices[i + lane];
+                hit_r_sq[num_hits] = r_sq_lanes[lane];
+                ++num_hits;
+            }
+        }
+    }
+#else
+    for (unsigned int i = 0; i < batch.size; ++i)
+    {
+        const float dx = batch.x[i] - query_point.x;
+        const float dy = batch.y[i] - query_point.y;
+        const float dz = (batch.z[i] - query_point.z) * z_weight;
+        const float r_sq = dx * dx + dy * dy + dz * dz;
+        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+        {
+            hit_indices[num_hits] = batch.indices[i];
+            hit_r_sq[num_hits] = r_sq;
+            ++num_hits;
+        }
+    }
+#endif
+    return num_hits;
+}
+
+}; }; // end namespace freud::util
+
+#endif // DISTANCE_BATCH_H
@@ -0,0 +1,79 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DOUBLE_BUFFERED_COMPUTE_H
+#define DOUBLE_BUFFERED_COMPUTE_H
+
+#include <utility>
+#include <vector>
+
+#include "ManagedArray.h"
+
+/*! \file DoubleBufferedCompute.h
+    \brief Parent class for computes whose outputs can alternate between two buffers.
+*/
+
+namespace freud { namespace util {
+
+//! Parent class for computes whose outputs can alternate between two buffers.
+/*! By default, preparing an output array that is still referenced elsewhere
+ *  (for example, by a NumPy array holding the result of the previous compute)
+ *  allocates new memory so that the old result stays valid. Callers that keep
+ *  the previous result while computing the next one then pay for an
+ *  allocation on every compute.
+ *
+ *  In double-buffered mode, each output instead alternates between two
+ *  retained buffers: every compute overwrites the buffer holding the result
+ *  from two computes ago, even if it is still referenced. The results of the
+ *  current and the previous compute remain valid, and steady-state computes
+ *  of the same size do not allocate.
+ */
+class DoubleBufferedCompute
+{
+public:
+    //! Destructor
+    virtual ~DoubleBufferedCompute() = default;
+
+    //! Set whether outputs alternate between two retained buffers.
+    void setDoubleBuffered(bool double_buffered)
+    {
+        m_double_buffered = double_buffered;
+    }
+
+    //! Whether outputs alternate between two retained buffers.
+    bool isDoubleBuffered() const
+    {
+        return m_double_buffered;
+    }
+
+protected:
+    //! Prepare an output array for writing.
+    /*! \param output The output array to prepare.
+     *  \param spare The second buffer of the output, only used in double-buffered mode.
+     *  \param shape The shape of the output.
+     */
+    template<typename T>
+    void prepareOutput(ManagedArray<T>& output, ManagedArray<T>& spare,
+                       const std::vector<size_t>& shape) const
+    {
+        if (m_double_buffered)
+        {
+            std::swap(output, spare);
+            output.prepareInPlace(shape);
+        }
+        else
+        {
+            if (spare.size() != 0)
+            {
+                spare = ManagedArray<T>();
+            }
+            output.prepare(shape);
+        }
+    }
+
+    bool m_double_buffered {false}; //!< Whether outputs alternate between two buffers.
+};
+
+}; }; // end namespace freud::util
+
+#endif // DOUBLE_BUFFERED_COMPUTE_H
@@ -0,0 +1,92 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "ExecutionContext.h"
+
+// TBB_INTERFACE_VERSION is defined by the TBB headers included above.
+#if TBB_INTERFACE_VERSION >= 12000
+#include <tbb/info.h>
+#endif
+
+/*! \file ExecutionContext.cc
+    \brief Isolated TBB arenas for running computations.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+
+//! Stack of the contexts activated by each thread.
+thread_local std::vector<ExecutionContext*> active_contexts;
+
+} // namespace
+
+ExecutionContext::ExecutionContext(unsigned int num_threads, int numa_node)
+    : m_num_threads(num_threads), m_numa_node(numa_node)
+{
+    const int max_concurrency
+        = (num_threads == 0) ? int(tbb::task_arena::automatic) : static_cast<int>(num_threads);
+    if (numa_node < 0)
+    {
+        m_arena = std::make_unique<tbb::task_arena>(max_concurrency);
+        return;
+    }
+
+    const std::vector<int> nodes = getNumaNodes();
+    if (std::find(nodes.begin(), nodes.end(), numa_node) == nodes.end())
+    {
+        std::ostringstream msg;
+        msg << "NUMA node " << numa_node << " is not available";
+        if (nodes.empty())
+        {
+            msg << " (NUMA support requires oneTBB with hwloc)";
+        }
+        msg << "." << std::endl;
+        throw std::invalid_argument(msg.str());
+    }
+#if TBB_INTERFACE_VERSION >= 12000
+    m_arena = std::make_unique<tbb::task_arena>(tbb::task_arena::constraints(numa_node, max_concurrency));
+#endif
+}
+
+void ExecutionContext::activate()
+{
+    active_contexts.push_back(this);
+}
+
+void ExecutionContext::deactivate()
+{
+    if (active_contexts.empty() || active_contexts.back() != this)
+    {
+        throw std::runtime_error("Execution contexts must be deactivated in the reverse order of "
+                                 "activation, from the thread that activated them.");
+    }
+    active_contexts.pop_back();
+}
+
+ExecutionContext* ExecutionContext::getActive()
+{
+    return active_contexts.empty() ? nullptr : active_contexts.back();
+}
+
+std::vector<int> ExecutionContext::getNumaNodes()
+{
+    std::vector<int> nodes;
+#if TBB_INTERFACE_VERSION >= 12000
+    for (const auto node : tbb::info::numa_nodes())
+    {
+        // A single node with an automatic id means that the topology is unknown.
+        if (node >= 0)
+        {
+            nodes.push_back(node);
+        }
+    }
+#endif
+    return nodes;
+}
+
+}; }; // end namespace freud::util
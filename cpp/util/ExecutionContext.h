@@ -0,0 +1,107 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef EXECUTION_CONTEXT_H
+#define EXECUTION_CONTEXT_H
+
+#include <memory>
+#include <tbb/task_arena.h>
+#include <vector>
+
+/*! \file ExecutionContext.h
+    \brief Isolated TBB arenas for running computations.
+*/
+
+namespace freud { namespace util {
+
+//! An isolated pool of threads for running computations.
+/*! Each ExecutionContext owns a tbb::task_arena with its own concurrency
+ *  limit, optionally pinned to the cores of a single NUMA node. Computations
+ *  running in different contexts (e.g. analyses of several trajectories run
+ *  concurrently from different threads) then share the machine without
+ *  oversubscribing cores.
+ *
+ *  A context is activated for the calling thread with activate(). While it is
+ *  active, all parallel loops of freud started from that thread (see
+ *  forLoopWrapper) run in its arena. Contexts may be nested, in which case
+ *  the most recently activated context is used.
+ */
+class ExecutionContext
+{
+public:
+    //! Constructor
+    /*! \param num_threads Maximum number of threads, or 0 to use all available threads.
+     *  \param numa_node NUMA node to pin the threads to, or -1 to not pin them.
+     */
+    explicit ExecutionContext(unsigned int num_threads = 0, int numa_node = -1);
+
+    //! Get the maximum number of threads (0 if all available threads are used).
+    unsigned int getNumThreads() const
+    {
+        return m_num_threads;
+    }
+
+    //! Get the NUMA node the threads are pinned to (-1 if not pinned).
+    int getNumaNode() const
+    {
+        return m_numa_node;
+    }
+
+    //! Get the number of threads that computations in this context can use.
+    int getMaxConcurrency() const
+    {
+        return m_arena->max_concurrency();
+    }
+
+    //! Run a function in the arena of this context.
+    template<typename Function> void execute(const Function& f)
+    {
+        m_arena->execute(f);
+    }
+
+    //! Make this the active context of the calling thread.
+    void activate();
+
+    //! Restore the context that was active before the matching call to activate.
+    void deactivate();
+
+    //! Get the active context of the calling thread (nullptr if there is none).
+    static ExecutionContext* getActive();
+
+    //! Get the NUMA nodes that contexts can be pinned to (empty if unknown).
+    static std::vector<int> getNumaNodes();
+
+private:
+    unsigned int m_num_threads;               //!< Maximum number of threads.
+    int m_numa_node;                          //!< NUMA node, or -1.
+    std::unique_ptr<tbb::task_arena> m_arena; //!< The arena running computations.
+};
+
+//! Run a function in the active execution context of the calling thread, if any.
+template<typename Function> inline void executeInActiveContext(const Function& f)
+{
+    ExecutionContext* context = ExecutionContext::getActive();
+    if (context != nullptr)
+    {
+        context->execute(f);
+    }
+    else
+    {
+        f();
+    }
+}
+
+//! Get the number of threads available to computations started from the calling thread.
+inline int getMaxConcurrency()
+{
+    ExecutionContext* context = ExecutionContext::getActive();
+    if (context != nullptr)
+    {
+        return context->getMaxConcurrency();
+    }
+    return tbb::this_task_arena::max_concurrency();
+}
+
+}; }; // end namespace freud::util
+
+#endif // EXECUTION_CONTEXT_H
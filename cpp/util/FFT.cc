@@ -0,0 +1,267 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cmath>
+#include <stdexcept>
+
+#include "FFT.h"
+#include "utils.h"
+
+/*! \file FFT.cc
+    \brief Fast Fourier transforms of arbitrary length and of grids.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+
+bool isPowerOfTwo(size_t n)
+{
+    return (n & (n - 1)) == 0;
+}
+
+size_t log2Floor(size_t n)
+{
+    size_t log = 0;
+    while (n > 1)
+    {
+        n >>= 1;
+        ++log;
+    }
+    return log;
+}
+
+//! Transform a grid of single or double precision values, see transformGrid.
+template<typename Complex>
+void transformGridImpl(Complex* data, const std::vector<size_t>& shape, bool inverse)
+{
+    size_t total = 1;
+    for (const size_t n : shape)
+    {
+        total *= n;
+    }
+
+    size_t stride = total;
+    for (const size_t n : shape)
+    {
+        // Values along this axis are stride / n apart.
+        stride /= n;
+        if (n <= 1)
+        {
+            continue;
+        }
+        const FFT fft(n);
+        const size_t axis_stride = stride;
+        forLoopWrapper(0, total / n, [&](size_t begin, size_t end) {
+            std::vector<std::complex<double>> line(n);
+            for (size_t l = begin; l < end; ++l)
+            {
+                Complex* first = data + (l / axis_stride) * n * axis_stride + l % axis_stride;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    line[i] = std::complex<double>(first[i * axis_stride]);
+                }
+                if (inverse)
+                {
+                    fft.inverse(line.data());
+                }
+                else
+                {
+                    fft.forward(line.data());
+                }
+                for (size_t i = 0; i < n; ++i)
+                {
+                    first[i * axis_stride] = Complex(line[i]);
+                }
+            }
+        });
+    }
+}
+
+} // namespace
+
+FFT::FFT(size_t n) : m_n(n)
+{
+    if (n == 0)
+    {
+        throw std::invalid_argument("FFT requires a positive length.");
+    }
+    m_m = isPowerOfTwo(n) ? n : nextPowerOfTwo(2 * n - 1);
+
+    const size_t log_m = log2Floor(m_m);
+    m_bit_reverse.resize(m_m);
+    for (size_t i = 0; i < m_m; ++i)
+    {
+        size_t reversed = 0;
+        for (size_t bit = 0; bit < log_m; ++bit)
+        {
+            reversed |= ((i >> bit) & 1) << (log_m - 1 - bit);
+        }
+        m_bit_reverse[i] = reversed;
+    }
+
+    const double two_pi = 2.0 * M_PI;
+    m_twiddle.resize(m_m / 2);
+    for (size_t k = 0; k < m_m / 2; ++k)
+    {
+        m_twiddle[k] = std::polar(1.0, -two_pi * double(k) / double(m_m));
+    }
+
+    if (m_m != m_n)
+    {
+        // Reduce k^2 modulo 2n before scaling to keep the chirp phases accurate.
+        m_chirp.resize(m_n);
+        for (size_t k = 0; k < m_n; ++k)
+        {
+            const size_t k_sq = (k * k) % (2 * m_n);
+            m_chirp[k] = std::polar(1.0, -M_PI * double(k_sq) / double(m_n));
+        }
+        m_filter.assign(m_m, std::complex<double>(0));
+        m_filter[0] = std::conj(m_chirp[0]);
+        for (size_t k = 1; k < m_n; ++k)
+        {
+            m_filter[k] = std::conj(m_chirp[k]);
+            m_filter[m_m - k] = std::conj(m_chirp[k]);
+        }
+        transformPowerOfTwo(m_filter.data(), false);
+    }
+}
+
+size_t FFT::nextPowerOfTwo(size_t n)
+{
+    size_t power = 1;
+    while (power < n)
+    {
+        power *= 2;
+    }
+    return power;
+}
+
+double FFT::cost(size_t n)
+{
+    if (n <= 1)
+    {
+        return 0;
+    }
+    if (isPowerOfTwo(n))
+    {
+        return 0.5 * double(n) * double(log2Floor(n));
+    }
+    // Two radix-2 transforms of length m per call, plus the chirp products.
+    const size_t m = nextPowerOfTwo(2 * n - 1);
+    return double(m) * double(log2Floor(m)) + 3.0 * double(m);
+}
+
+void FFT::transformPowerOfTwo(std::complex<double>* data, bool inverse) const
+{
+    for (size_t i = 0; i < m_m; ++i)
+    {
+        const size_t j = m_bit_reverse[i];
+        if (i < j)
+        {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (size_t len = 2; len <= m_m; len *= 2)
+    {
+        const size_t half = len / 2;
+        const size_t step = m_m / len;
+        for (size_t start = 0; start < m_m; start += len)
+        {
+            for (size_t j = 0; j < half; ++j)
+            {
+                const std::complex<double> w
+                    = inverse ? std::conj(m_twiddle[j * step]) : m_twiddle[j * step];
+                const std::complex<double> odd = w * data[start + j + half];
+                data[start + j + half] = data[start + j] - odd;
+                data[start + j] += odd;
+            }
+        }
+    }
+}
+
+void FFT::bluestein(std::complex<double>* data) const
+{
+    thread_local std::vector<std::complex<double>> work;
+    work.assign(m_m, std::complex<double>(0));
+    for (size_t k = 0; k < m_n; ++k)
+    {
+        work[k] = data[k] * m_chirp[k];
+    }
+    transformPowerOfTwo(work.data(), false);
+    for (size_t k = 0; k < m_m; ++k)
+    {
+        work[k] *= m_filter[k];
+    }
+    transformPowerOfTwo(work.data(), true);
+    const double scale = 1.0 / double(m_m);
+    for (size_t k = 0; k < m_n; ++k)
+    {
+        data[k] = work[k] * m_chirp[k] * scale;
+    }
+}
+
+void FFT::forward(std::complex<double>* data) const
+{
+    if (m_m == m_n)
+    {
+        transformPowerOfTwo(data, false);
+    }
+    else
+    {
+        bluestein(data);
+    }
+}
+
+void FFT::inverse(std::complex<double>* data) const
+{
+    if (m_m == m_n)
+    {
+        transformPowerOfTwo(data, true);
+    }
+    else
+    {
+        // The inverse transform is the conjugate of the forward transform of the conjugate.
+        for (size_t k = 0; k < m_n; ++k)
+        {
+            data[k] = std::conj(data[k]);
+        }
+        bluestein(data);
+        for (size_t k = 0; k < m_n; ++k)
+        {
+            data[k] = std::conj(data[k]);
+        }
+    }
+    const double scale = 1.0 / double(m_n);
+    for (size_t k = 0; k < m_n; ++k)
+    {
+        data[k] *= scale;
+    }
+}
+
+void transformGrid(std::complex<float>* data, const std::vector<size_t>& shape, bool inverse)
+{
+    transformGridImpl(data, shape, inverse);
+}
+
+void transformGrid(std::complex<double>* data, const std::vector<size_t>& shape, bool inverse)
+{
+    transformGridImpl(data, shape, inverse);
+}
+
+double transformGridCost(const std::vector<size_t>& shape)
+{
+    double total = 1;
+    for (const size_t n : shape)
+    {
+        total *= double(n);
+    }
+    double cost = 0;
+    for (const size_t n : shape)
+    {
+        cost += total / double(n) * FFT::cost(n);
+    }
+    return cost;
+}
+
+}; }; // end namespace freud::util
@@ -0,0 +1,88 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/*! \file FFT.h
+    \brief Fast Fourier transforms of arbitrary length and of grids.
+*/
+
+namespace freud { namespace util {
+
+//! One-dimensional complex fast Fourier transform of a fixed length.
+/*! Lengths that are powers of two use an iterative radix-2 transform. Other
+ *  lengths are computed with Bluestein's algorithm, which expresses the
+ *  transform as a convolution evaluated with radix-2 transforms of at least
+ *  twice the length, so every length costs O(n log n).
+ *
+ *  The forward transform computes X_k = sum_j x_j exp(-2 pi i j k / n), and
+ *  the inverse transform is normalized by 1 / n so that it exactly undoes the
+ *  forward transform. A plan is immutable once constructed and may be shared
+ *  by many threads.
+ */
+class FFT
+{
+public:
+    //! Constructor
+    /*! \param n Length of the transform.
+     */
+    explicit FFT(size_t n);
+
+    //! Get the length of the transform.
+    size_t size() const
+    {
+        return m_n;
+    }
+
+    //! Compute the forward transform of n values in place.
+    void forward(std::complex<double>* data) const;
+
+    //! Compute the normalized inverse transform of n values in place.
+    void inverse(std::complex<double>* data) const;
+
+    //! Estimate the cost of a transform of length n, in units of radix-2 butterflies.
+    static double cost(size_t n);
+
+    //! Get the smallest power of two that is at least n.
+    static size_t nextPowerOfTwo(size_t n);
+
+private:
+    //! Radix-2 transform of m_m values in place (unnormalized in both directions).
+    void transformPowerOfTwo(std::complex<double>* data, bool inverse) const;
+
+    //! Forward transform of n values with Bluestein's algorithm.
+    void bluestein(std::complex<double>* data) const;
+
+    size_t m_n;                                  //!< Length of the transform.
+    size_t m_m;                                  //!< Length of the radix-2 transforms.
+    std::vector<size_t> m_bit_reverse;           //!< Bit-reversal permutation of length m_m.
+    std::vector<std::complex<double>> m_twiddle; //!< exp(-2 pi i k / m_m) for k < m_m / 2.
+    std::vector<std::complex<double>> m_chirp;   //!< Bluestein chirp exp(-pi i k^2 / n).
+    std::vector<std::complex<double>> m_filter;  //!< Transformed Bluestein filter.
+};
+
+//! Transform a row-major grid along each of its axes in place.
+/*! The transform along each axis is parallelized over the lines of the grid
+ *  along that axis, and computed in double precision for grids of either
+ *  precision.
+ *
+ *  \param data Grid values, with the last axis contiguous in memory.
+ *  \param shape Number of values along each axis.
+ *  \param inverse If true, compute the normalized inverse transform.
+ */
+void transformGrid(std::complex<float>* data, const std::vector<size_t>& shape, bool inverse);
+
+//! Transform a row-major grid of double precision values along each of its axes in place.
+void transformGrid(std::complex<double>* data, const std::vector<size_t>& shape, bool inverse);
+
+//! Estimate the cost of transformGrid for a grid, in units of radix-2 butterflies.
+double transformGridCost(const std::vector<size_t>& shape);
+
+}; }; // end namespace freud::util
+
+#endif // FFT_H
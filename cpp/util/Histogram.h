@@ -1,16 +1,18 @@
 #ifndef HISTOGRAM_H
 #define HISTOGRAM_H
 
+#include <array>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 #include <sstream>
-#include <tbb/enumerable_thread_specific.h>
 #include <utility>
 
+#include "BinAccumulator.h"
 #include "ManagedArray.h"
 #include "utils.h"
 
@@ -185,93 +187,70 @@ protected:
 template<typename T> class Histogram
 {
 public:
-    //! A container for thread-local copies of a provided histogram.
-    /*! This container implements the simplest method of enabling parallel-safe
-     * accumulation, namely the creation of separate instances on each thread.
-     * Thread local histograms can be accumulated later using the
-     * reduceOverThreads functions in the Histogram class.
-     *
-     * To simplify the implementation and avoid unnecessary copies, the thread
-     * local copies all share the same axes (because the axes are stored as
-     * arrays of shared_ptrs in the Histogram class). This should cause no
-     * problems, but can be refactored if needed.
+    //! A container for parallel-safe accumulation into a provided histogram.
+    /*! Values are binned using the axes of the provided histogram and the
+     * counts are accumulated with a BinAccumulator, which keeps a separate
+     * copy of the bins on each thread unless that would exceed its memory
+     * limit, in which case a memory-bounded strategy is used instead (see
+     * BinAccumulator for details). The accumulated counts can be collected
+     * later using the reduceOverThreads functions in the Histogram class.
      */
     class ThreadLocalHistogram
     {
     public:
         ThreadLocalHistogram() = default;
 
-        explicit ThreadLocalHistogram(const Histogram& histogram)
-            : m_local_histograms([histogram]() { return Histogram(histogram.m_axes); })
-        {}
-
-        using const_iterator = typename tbb::enumerable_thread_specific<Histogram<T>>::const_iterator;
-        using iterator = typename tbb::enumerable_thread_specific<Histogram>::iterator;
-        using reference = typename tbb::enumerable_thread_specific<Histogram>::reference;
-
-        const_iterator begin() const
-        {
-            return m_local_histograms.begin();
-        }
-
-        iterator begin()
-        {
-            return m_local_histograms.begin();
-        }
-
-        const_iterator end() const
+        //! Constructor
+        /*! \param histogram The histogram whose axes are used for binning.
+         *  \param strategy The strategy used to accumulate counts.
+         */
+        explicit ThreadLocalHistogram(const Histogram& histogram,
+                                      AccumulationStrategy strategy = AccumulationStrategy::automatic)
+            : m_histogram(histogram), m_bins(histogram.size(), strategy)
         {
-            return m_local_histograms.end();
+            // Only the axes are needed, so drop the shared reference to the counts.
+            m_histogram.m_bin_counts = ManagedArray<T>();
         }
 
-        iterator end()
+        //! Get the strategy used to accumulate counts.
+        AccumulationStrategy getStrategy() const
         {
-            return m_local_histograms.end();
-        }
-
-        reference local()
-        {
-            return m_local_histograms.local();
+            return m_bins.getStrategy();
         }
 
         void reset()
         {
-            for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
-            {
-                hist->reset();
-            }
+            m_bins.reset();
         }
 
-        //! Dispatch to thread local histogram.
+        //! Bin values and add them to the counts of the calling thread.
         template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
         {
-            m_local_histograms.local()(values...);
+            std::array<float, countValues<FloatsOrWeight...>()> value_array;
+            Weight<T> weight;
+            getValueArray(value_array.data(), weight, values...);
+            increment(m_histogram.bin(value_array), weight.value);
         }
 
-        //! Dispatch to thread local histogram.
+        //! Increment specified linear bin (with a specified weight if desired).
         void increment(size_t value_bin, T weight = 1)
         {
-            m_local_histograms.local().increment(value_bin, weight);
+            // Check for sentinel to avoid overflow.
+            if (value_bin != Axis::OVERFLOW_BIN)
+            {
+                m_bins.add(value_bin, weight);
+            }
         }
 
-        // Reduce over histograms into the result array.
+        // Reduce over threads into the result array.
         void reduceInto(ManagedArray<T>& result)
         {
-            result.reset();
-            util::forLoopWrapper(0, result.size(), [=, &result](size_t begin, size_t end) {
-                for (size_t i = begin; i < end; ++i)
-                {
-                    for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
-                    {
-                        result[i] += hist->m_bin_counts[i];
-                    }
-                }
-            });
+            m_bins.reduceInto(result);
         }
 
     protected:
-        tbb::enumerable_thread_specific<Histogram<T>>
-            m_local_histograms; //!< The thread-local copies of m_histogram.
+        Histogram m_histogram;    //!< Histogram providing the axes used for binning.
+        BinAccumulator<T> m_bins; //!< The accumulated counts.
     };
 
     using Axes = std::vector<std::shared_ptr<Axis>>;
@@ -287,6 +266,21 @@ public:
         std::transform(m_axes.begin(), m_axes.end(), sizes.begin(),
                        [](const auto& ax) { return ax->size(); });
         m_bin_counts = ManagedArray<T>(sizes);
+
+        // Keep copies of regular axes so that they can be binned without
+        // virtual function calls.
+        m_all_regular = true;
+        for (const auto& ax : m_axes)
+        {
+            const auto* regular_axis = dynamic_cast<const RegularAxis*>(ax.get());
+            if (regular_axis == nullptr)
+            {
+                m_all_regular = false;
+                m_regular_axes.clear();
+                break;
+            }
+            m_regular_axes.push_back(*regular_axis);
+        }
     }
 
     //! Simple convenience for 1D arrays that calls through to the shape based `prepare` function.
@@ -311,14 +305,19 @@ public:
     ~Histogram() = default;
 
     //! Bin value and update the histogram count.
+    /*! The number of values is known at compile time, so they are gathered
+     *  into an array on the stack and binned without any heap allocations.
+     */
     template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
     {
-        std::pair<std::vector<float>, Weight<T>> value_vector = getValueVector(values...);
-        size_t value_bin = bin(value_vector.first);
+        std::array<float, countValues<FloatsOrWeight...>()> value_array;
+        Weight<T> weight;
+        getValueArray(value_array.data(), weight, values...);
+        size_t value_bin = bin(value_array);
         // Check for sentinel to avoid overflow.
         if (value_bin != Axis::OVERFLOW_BIN)
         {
-            m_bin_counts[value_bin] += value_vector.second.value;
+            m_bin_counts[value_bin] += weight.value;
         }
     }
 
@@ -337,29 +336,18 @@ public:
      *  are then combined into a single linear index using the underlying
      *  ManagedArray.
      */
-    size_t bin(std::vector<float> values) const
+    size_t bin(const std::vector<float>& values) const
     {
-        if (values.size() != m_axes.size())
-        {
-            std::ostringstream msg;
-            msg << "This Histogram is " << m_axes.size() << "-dimensional, but " << values.size()
-                << " values were provided in bin" << std::endl;
-            throw std::invalid_argument(msg.str());
-        }
-        // First bin the values along each axis.
-        std::vector<size_t> ax_bins;
-        for (unsigned int ax_idx = 0; ax_idx < m_axes.size(); ++ax_idx)
-        {
-            size_t bin_i = m_axes[ax_idx]->bin(values[ax_idx]);
-            // Immediately return sentinel if any bin is out of bounds.
-            if (bin_i == Axis::OVERFLOW_BIN)
-            {
-                return Axis::OVERFLOW_BIN;
-            }
-            ax_bins.push_back(bin_i);
-        }
+        return bin(values.data(), values.size());
+    }
 
-        return m_bin_counts.getIndex(ax_bins);
+    //! Find the bin of a fixed number of values.
+    /*! This overload avoids allocating a vector of values, and is used by
+     *  operator().
+     */
+    template<size_t D> size_t bin(const std::array<float, D>& values) const
+    {
+        return bin(values.data(), D);
     }
 
     //! Get the computed histogram.
@@ -368,6 +356,15 @@ public:
         return m_bin_counts;
     }
 
+    //! Get the computed histogram for writing.
+    /*! This allows computes to prepare the counts array themselves, e.g. as
+     *  a double-buffered output (see DoubleBufferedCompute).
+     */
+    ManagedArray<T>& getWritableBinCounts()
+    {
+        return m_bin_counts;
+    }
+
     //! Get the shape of the computed histogram.
     std::vector<size_t> shape() const
     {
@@ -451,9 +448,8 @@ public:
     //!< Aggregate a set of thread-local histograms into this one.
     /*! This function is the standard method for parallel aggregation of a
      * histogram. The simplest way to achieve parallel-safe accumulation is to
-     * create a ThreadLocalHistogram object, which holds a local copy of a
-     * histogram on each thread. This function then accumulates the results
-     * into this object.
+     * create a ThreadLocalHistogram object, which accumulates counts from
+     * each thread. This function then collects the results into this object.
      *
      * \param local_histograms The set of local histograms to reduce into this one.
      */
@@ -483,43 +479,81 @@ public:
 protected:
     std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes.
     ManagedArray<T> m_bin_counts;              //!< Counts for each bin
+    bool m_all_regular {false};                //!< Whether all axes are RegularAxis instances.
+    std::vector<RegularAxis> m_regular_axes;   //!< Copies of the axes if they are all regular.
 
-    //! The base case for type float when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
+    //! Find the bin of an array of values.
+    /*! Bins are computed along each axis and combined into a row-major linear
+     *  index as they are found. Regular axes are binned with non-virtual
+     *  calls that can be inlined.
      */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value) const
+    size_t bin(const float* values, size_t num_values) const
     {
-        return {{value}, Weight<T>()};
+        if (num_values != m_axes.size())
+        {
+            std::ostringstream msg;
+            msg << "This Histogram is " << m_axes.size() << "-dimensional, but " << num_values
+                << " values were provided in bin" << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+        size_t linear_bin = 0;
+        for (size_t ax_idx = 0; ax_idx < num_values; ++ax_idx)
+        {
+            size_t bin_i;
+            size_t ax_size;
+            if (m_all_regular)
+            {
+                bin_i = m_regular_axes[ax_idx].RegularAxis::bin(values[ax_idx]);
+                ax_size = m_regular_axes[ax_idx].size();
+            }
+            else
+            {
+                bin_i = m_axes[ax_idx]->bin(values[ax_idx]);
+                ax_size = m_axes[ax_idx]->size();
+            }
+            // Immediately return sentinel if any bin is out of bounds.
+            if (bin_i == Axis::OVERFLOW_BIN)
+            {
+                return Axis::OVERFLOW_BIN;
+            }
+            linear_bin = linear_bin * ax_size + bin_i;
+        }
+        return linear_bin;
     }
 
-    //! The base case for type Weight when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
-     */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight) const
+    //! Count the values (as opposed to weights) among the arguments of operator().
+    template<typename... FloatsOrWeight> static constexpr size_t countValues()
     {
-        return {{}, weight};
+        const bool is_value[] = {!std::is_same<FloatsOrWeight, Weight<T>>::value..., false};
+        size_t count = 0;
+        for (size_t i = 0; i < sizeof...(FloatsOrWeight); ++i)
+        {
+            count += is_value[i] ? 1 : 0;
+        }
+        return count;
     }
 
-    //! The recursive case for constructing a vector of values (see base-case function docs).
+    //! The base case when filling an array with the values provided to operator().
+    /*! This function and the accompanying recursive functions below employ
+     * variadic templating to accept an arbitrary set of float values and
+     * write them into an array, and to extract an optional weight.
+     */
+    static void getValueArray(float* /*values*/, Weight<T>& /*weight*/) {}
+
+    //! The recursive case for a value when filling an array (see base-case function docs).
     template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value, FloatsOrWeight... values) const
+    static void getValueArray(float* values, Weight<T>& weight, float value, FloatsOrWeight... rest)
     {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.first.insert(tmp.first.begin(), value);
-        return tmp;
+        *values = value;
+        getValueArray(values + 1, weight, rest...);
     }
 
-    //! The recursive case for constructing a vector of values (see base-case function docs).
+    //! The recursive case for a weight when filling an array (see base-case function docs).
     template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight, FloatsOrWeight... values) const
+    static void getValueArray(float* values, Weight<T>& weight, Weight<T> value_weight, FloatsOrWeight... rest)
     {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.second = weight;
-        return tmp;
+        weight = value_weight;
+        getValueArray(values, weight, rest...);
     }
 };
 
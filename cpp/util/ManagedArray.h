@@ -1,13 +1,18 @@
 #ifndef MANAGED_ARRAY_H
 #define MANAGED_ARRAY_H
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
+#include "ArrayPool.h"
+#include "utils.h"
+
 /*! \file ManagedArray.h
     \brief Defines the standard array class to be used throughout freud.
 */
@@ -50,10 +55,11 @@ public:
      *  constructor as the default constructor.
      *
      *  \param shape Shape of the array to allocate.
+     *  \param parallel_reset Whether large arrays may be zeroed in parallel (see reset).
      */
-    ManagedArray(const std::vector<size_t>& shape = {0})
+    ManagedArray(const std::vector<size_t>& shape = {0}, bool parallel_reset = true)
     {
-        prepare(shape, true);
+        prepare(shape, true, parallel_reset);
     }
 
     //! Constructor based on a shape tuple.
@@ -83,16 +89,21 @@ public:
      *
      *  \param new_shape Shape of the array to allocate.
      *  \param force Reallocate regardless of whether anything changed or needs to be persisted.
+     *  \param parallel_reset Whether large arrays may be zeroed in parallel (see reset).
      */
-    void prepare(const std::vector<size_t>& new_shape, bool force = false)
+    void prepare(const std::vector<size_t>& new_shape, bool force = false, bool parallel_reset = true)
     {
         // If we resized, or if there are outstanding references, we create a new array. No matter what,
         // reset.
-        if (force || (m_data.use_count() > 1) || (new_shape != shape()))
+        if (force || (m_data.use_count() > 1) || !hasShape(new_shape))
         {
-            m_shape = std::make_shared<std::vector<size_t>>(new_shape);
+            // The shape, size and data pointers (including the control block
+            // of the data) are drawn from ArrayPool along with the data, so
+            // that repeated computations do not need the system allocator.
+            m_shape
+                = std::allocate_shared<Shape>(PoolAllocator<Shape>(), new_shape.cbegin(), new_shape.cend());
 
-            m_size = std::make_shared<size_t>(1);
+            m_size = std::allocate_shared<size_t>(PoolAllocator<size_t>(), 1);
             for (unsigned int i = m_shape->size() - 1; i != static_cast<unsigned int>(-1); --i)
             {
                 (*m_size) *= (*m_shape)[i];
@@ -104,18 +115,54 @@ public:
             // with a different data structure like std::vector, but it would
             // require writing additional gymnastics to ensure proper reference
             // management and should be carefully considered before any rewrite.
-            m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(
-                new T[size()], std::default_delete<T[]>())); // NOLINT(modernize-avoid-c-arrays)
+            m_data = std::allocate_shared<std::shared_ptr<T>>(PoolAllocator<std::shared_ptr<T>>(),
+                                                              allocate(size()));
+        }
+        reset(parallel_reset);
+    }
+
+    //! Prepare for writing new data, reusing the current memory even if it is shared.
+    /*! Unlike prepare, this function only reallocates if the shape changes.
+     *  Any other ManagedArrays (including NumPy arrays in Python) referencing
+     *  the current data will observe the reset and all subsequent writes, so
+     *  it should only be used when such aliasing is intended, e.g. for
+     *  double-buffered outputs.
+     *
+     *  \param new_shape Shape of the array to allocate.
+     */
+    void prepareInPlace(const std::vector<size_t>& new_shape)
+    {
+        if (!hasShape(new_shape))
+        {
+            prepare(new_shape, true);
+        }
+        else
+        {
+            reset();
         }
-        reset();
     }
 
     //! Reset the contents of array to be 0.
-    void reset()
+    /*! Large shared output arrays are zeroed in parallel in the active
+     *  execution context, so their pages are first touched by (and, if the
+     *  context is pinned to a NUMA node, placed on the node of) the threads
+     *  that will compute them. Arrays owned by a single thread, such as the
+     *  thread-local arrays of ThreadStorage, must be zeroed serially by that
+     *  thread instead, so that their pages are placed near it.
+     *
+     *  \param parallel Whether large arrays may be zeroed in parallel.
+     */
+    void reset(bool parallel = true)
     {
         if (size() != 0)
         {
-            memset((void*) get(), 0, sizeof(T) * size());
+            T* data = get();
+            forLoopWrapper(
+                0, size(),
+                [data](size_t begin, size_t end) {
+                    memset((void*) (data + begin), 0, sizeof(T) * (end - begin));
+                },
+                parallel && sizeof(T) * size() >= PARALLEL_RESET_BYTES);
         }
     }
 
@@ -175,7 +222,7 @@ public:
     //! Get the shape of the current array.
     std::vector<size_t> shape() const
     {
-        return *m_shape;
+        return std::vector<size_t>(m_shape->cbegin(), m_shape->cend());
     }
 
     //*************************************************************************
@@ -285,17 +332,7 @@ public:
      */
     static inline size_t getIndex(const std::vector<size_t>& shape, const std::vector<size_t>& indices)
     {
-        size_t cur_prod = 1;
-        size_t idx = 0;
-        // In getting the linear bin, we must iterate over bins in reverse
-        // order to build up the value of cur_prod because each subsequent axis
-        // contributes less according to row-major ordering.
-        for (unsigned int i = indices.size() - 1; i != static_cast<unsigned int>(-1); --i)
-        {
-            idx += indices[i] * cur_prod;
-            cur_prod *= shape[i];
-        }
-        return idx;
+        return linearIndex(shape, indices);
     }
 
     //! Get the linear index corresponding to a vector of indices in each dimension.
@@ -324,7 +361,7 @@ public:
             }
         }
 
-        return getIndex(*m_shape, indices);
+        return linearIndex(*m_shape, indices);
     }
 
     //! Return a copy of this array.
@@ -344,6 +381,54 @@ public:
     }
 
 private:
+    //! Shape of an array, stored in memory drawn from ArrayPool.
+    using Shape = std::vector<size_t, PoolAllocator<size_t>>;
+
+    //! Minimum size in bytes of arrays that are zeroed in parallel.
+    static constexpr size_t PARALLEL_RESET_BYTES = size_t(1) << 20;
+
+    //! Allocate storage for an array of n elements.
+    /*! The storage is provided by ArrayPool, which aligns it to and pads it
+     *  up to whole cache lines, so arrays written concurrently by different
+     *  threads (such as the thread-local arrays of ThreadStorage) never share
+     *  a cache line. The elements are left uninitialized, since every caller
+     *  zeroes them with reset() anyway. The storage is returned to ArrayPool
+     *  (and possibly recycled) when the last ManagedArray referencing it is
+     *  destroyed.
+     */
+    static std::shared_ptr<T> allocate(size_t n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "ManagedArray elements are zero-initialized with memset and never destroyed.");
+        size_t capacity = n * sizeof(T);
+        T* data = static_cast<T*>(ArrayPool::allocate(capacity));
+        return std::shared_ptr<T>(
+            data, [capacity](T* ptr) { ArrayPool::deallocate(ptr, capacity); }, PoolAllocator<T>());
+    }
+
+    //! Whether the array has the given shape.
+    bool hasShape(const std::vector<size_t>& shape) const
+    {
+        return std::equal(shape.cbegin(), shape.cend(), m_shape->cbegin(), m_shape->cend());
+    }
+
+    //! Compute the linear index of a vector of indices into an array of any shape container type.
+    template<typename ShapeType>
+    static inline size_t linearIndex(const ShapeType& shape, const std::vector<size_t>& indices)
+    {
+        size_t cur_prod = 1;
+        size_t idx = 0;
+        // In getting the linear bin, we must iterate over bins in reverse
+        // order to build up the value of cur_prod because each subsequent axis
+        // contributes less according to row-major ordering.
+        for (unsigned int i = indices.size() - 1; i != static_cast<unsigned int>(-1); --i)
+        {
+            idx += indices[i] * cur_prod;
+            cur_prod *= shape[i];
+        }
+        return idx;
+    }
+
     //! The base case for building up the index.
     /*! These argument building functions are templated on two types, one that
      *  encapsulates the current object being operated on and the other being
@@ -367,7 +452,7 @@ private:
     }
 
     std::shared_ptr<std::shared_ptr<T>> m_data;   //!< Pointer to array.
-    std::shared_ptr<std::vector<size_t>> m_shape; //!< Shape of array.
+    std::shared_ptr<Shape> m_shape;               //!< Shape of array.
     std::shared_ptr<size_t> m_size;               //!< Size of array.
 };
 
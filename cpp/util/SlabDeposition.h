@@ -0,0 +1,403 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SLAB_DEPOSITION_H
+#define SLAB_DEPOSITION_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "utils.h"
+
+/*! \file SlabDeposition.h
+    \brief Parallel deposition of point contributions onto grids partitioned into slabs.
+*/
+
+namespace freud { namespace util {
+
+//! Deposit contributions of points onto a shared grid with spatial ownership.
+/*! The grid is viewed as num_rows rows (the slowest varying axis) of row_size
+ *  values each, and is split into contiguous slabs of rows. Points are sorted
+ *  by the slab containing their row, and each slab is processed by a single
+ *  task that writes the rows it owns directly into the grid. Contributions of
+ *  a slab's points to rows within halo rows outside of the slab are written to
+ *  small halo buffers private to the slab, which are merged into the grid once
+ *  all slabs are done.
+ *
+ *  Unlike accumulating into one private copy of the grid per thread, memory
+ *  use stays at the grid itself plus 2 * halo rows per slab, independent of
+ *  the number of threads, and no reduction over the copies is needed. The
+ *  number of slabs is limited so that the halos never exceed the size of the
+ *  grid, so very wide halos (relative to the number of rows) leave some
+ *  threads idle rather than growing the memory; see chooseNumSlabs.
+ *
+ *  Values are combined with Combine (addition by default), whose identity must
+ *  be T(0).
+ */
+template<typename T, typename Combine = std::plus<T>> class SlabDeposition
+{
+public:
+    //! Writes the contributions of the points of one slab.
+    class Writer
+    {
+    public:
+        //! Combine a value into the grid.
+        /*! \param row Row of the grid, which must be within halo rows of the row of the point.
+         *  \param offset Index of the value within the row.
+         *  \param value Value to combine.
+         */
+        void deposit(size_t row, size_t offset, T value) const
+        {
+            T& target = getRow(row)[offset];
+            target = m_combine(target, value);
+        }
+
+        //! Combine consecutive values into one row of the grid.
+        /*! \param row Row of the grid, which must be within halo rows of the row of the point.
+         *  \param offset Index of the first value within the row.
+         *  \param values Values to combine.
+         *  \param count Number of values.
+         */
+        void deposit(size_t row, size_t offset, const T* values, size_t count) const
+        {
+            T* target = getRow(row) + offset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                target[i] = m_combine(target[i], values[i]);
+            }
+        }
+
+        //! Combine the same value into consecutive values of one row of the grid.
+        /*! \param row Row of the grid, which must be within halo rows of the row of the point.
+         *  \param offset Index of the first value within the row.
+         *  \param value Value to combine.
+         *  \param count Number of values.
+         */
+        void fill(size_t row, size_t offset, T value, size_t count) const
+        {
+            T* target = getRow(row) + offset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                target[i] = m_combine(target[i], value);
+            }
+        }
+
+    private:
+        friend class SlabDeposition;
+
+        Writer(const SlabDeposition& deposition, T* grid, T* halos, size_t first_row, size_t last_row)
+            : m_num_rows(deposition.m_num_rows), m_row_size(deposition.m_row_size), m_halo(deposition.m_halo),
+              m_grid(grid), m_halos(halos), m_first_row(first_row), m_last_row(last_row)
+        {}
+
+        //! Get the storage of a row, either in the grid or in the halo buffers.
+        T* getRow(size_t row) const
+        {
+            if (row >= m_first_row && row < m_last_row)
+            {
+                return m_grid + row * m_row_size;
+            }
+            // Rows before the slab are stored in halo rows [0, halo), and rows
+            // after it in halo rows [halo, 2 * halo), nearest rows last and
+            // first respectively.
+            const size_t before = (m_first_row + m_num_rows - row) % m_num_rows;
+            if (before >= 1 && before <= m_halo)
+            {
+                return m_halos + (m_halo - before) * m_row_size;
+            }
+            const size_t after = (row + m_num_rows - m_last_row) % m_num_rows;
+            if (after < m_halo)
+            {
+                return m_halos + (m_halo + after) * m_row_size;
+            }
+            throw std::out_of_range("Deposited row is outside of the halo of the slab.");
+        }
+
+        size_t m_num_rows;  //!< Number of rows in the grid.
+        size_t m_row_size;  //!< Number of values in a row.
+        size_t m_halo;      //!< Number of halo rows on either side of the slab.
+        T* m_grid;          //!< The grid.
+        T* m_halos;         //!< Halo rows of the slab.
+        size_t m_first_row; //!< First row owned by the slab.
+        size_t m_last_row;  //!< One past the last row owned by the slab.
+        Combine m_combine;  //!< Operation combining values.
+    };
+
+    //! Constructor
+    /*! \param num_rows Number of rows in the grid.
+     *  \param row_size Number of values in each row.
+     *  \param halo Maximum distance in rows between the row of a point and the rows it writes to.
+     *  \param periodic Whether rows wrap around periodically. Otherwise rows
+     *         outside of the grid are never written to.
+     *  \param num_slabs Number of slabs, or 0 to use chooseNumSlabs.
+     */
+    SlabDeposition(size_t num_rows, size_t row_size, size_t halo, bool periodic, size_t num_slabs = 0)
+        : m_num_rows(num_rows), m_row_size(row_size), m_halo(halo), m_periodic(periodic),
+          m_num_slabs(num_slabs == 0 ? chooseNumSlabs(num_rows, halo, getMaxConcurrency()) : num_slabs)
+    {
+        m_num_slabs = std::max(size_t(1), std::min(m_num_slabs, num_rows));
+    }
+
+    //! Choose the number of slabs for a grid.
+    /*! Several slabs per thread balance the load between threads, but the
+     *  halos of all slabs together may not exceed the size of the grid.
+     */
+    static size_t chooseNumSlabs(size_t num_rows, size_t halo, size_t num_threads)
+    {
+        const size_t max_slabs = (halo == 0) ? num_rows : num_rows / (2 * halo);
+        return std::max(size_t(1), std::min(SLABS_PER_THREAD * num_threads, max_slabs));
+    }
+
+    //! Get the number of slabs.
+    size_t getNumSlabs() const
+    {
+        return m_num_slabs;
+    }
+
+    //! Deposit the contributions of all points onto the grid.
+    /*! The grid is not reset, so contributions are combined with its current values.
+     *
+     *  \param grid Grid of num_rows * row_size values.
+     *  \param num_points Number of points.
+     *  \param row_of Function returning the row (in [0, num_rows)) of a point.
+     *  \param deposit Function called as deposit(point, writer) for each point,
+     *         which deposits the contributions of the point with the writer.
+     */
+    template<typename RowOf, typename Deposit>
+    void compute(ManagedArray<T>& grid, size_t num_points, const RowOf& row_of, const Deposit& deposit) const
+    {
+        // Sort the points by slab.
+        std::vector<size_t> slab_of_row(m_num_rows);
+        for (size_t slab = 0; slab < m_num_slabs; ++slab)
+        {
+            std::fill(slab_of_row.begin() + getFirstRow(slab), slab_of_row.begin() + getFirstRow(slab + 1),
+                      slab);
+        }
+        std::vector<unsigned int> point_slabs(num_points);
+        forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                point_slabs[i] = static_cast<unsigned int>(slab_of_row[row_of(i)]);
+            }
+        });
+        std::vector<size_t> slab_starts(m_num_slabs + 1, 0);
+        for (size_t i = 0; i < num_points; ++i)
+        {
+            ++slab_starts[point_slabs[i] + 1];
+        }
+        for (size_t slab = 0; slab < m_num_slabs; ++slab)
+        {
+            slab_starts[slab + 1] += slab_starts[slab];
+        }
+        std::vector<size_t> sorted_points(num_points);
+        std::vector<size_t> positions(slab_starts.begin(), slab_starts.end() - 1);
+        for (size_t i = 0; i < num_points; ++i)
+        {
+            sorted_points[positions[point_slabs[i]]++] = i;
+        }
+
+        // Deposit each slab on a separate task.
+        const size_t halo_size = (m_num_slabs > 1) ? 2 * m_halo * m_row_size : 0;
+        std::vector<T> halos(m_num_slabs * halo_size, T(0));
+        T* grid_data = grid.get();
+        forLoopWrapper(0, m_num_slabs, [&](size_t begin, size_t end) {
+            for (size_t slab = begin; slab < end; ++slab)
+            {
+                const Writer writer(*this, grid_data, halos.data() + slab * halo_size, getFirstRow(slab),
+                                    getFirstRow(slab + 1));
+                for (size_t i = slab_starts[slab]; i < slab_starts[slab + 1]; ++i)
+                {
+                    deposit(sorted_points[i], writer);
+                }
+            }
+        });
+
+        if (halo_size == 0)
+        {
+            return;
+        }
+
+        // Merge the halos, in parallel over the values within rows.
+        const Combine combine;
+        forLoopWrapper(0, m_row_size, [&](size_t begin, size_t end) {
+            for (size_t slab = 0; slab < m_num_slabs; ++slab)
+            {
+                const T* slab_halos = halos.data() + slab * halo_size;
+                for (size_t h = 0; h < 2 * m_halo; ++h)
+                {
+                    // Halo row h is row first_row - halo + h before the slab, or
+                    // last_row + h - halo after it.
+                    long int row = (h < m_halo) ? long(getFirstRow(slab)) - long(m_halo) + long(h)
+                                                : long(getFirstRow(slab + 1)) + long(h) - long(m_halo);
+                    if (m_periodic)
+                    {
+                        row = ((row % long(m_num_rows)) + long(m_num_rows)) % long(m_num_rows);
+                    }
+                    else if (row < 0 || row >= long(m_num_rows))
+                    {
+                        continue;
+                    }
+                    T* target = grid_data + size_t(row) * m_row_size;
+                    const T* source = slab_halos + h * m_row_size;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        target[i] = combine(target[i], source[i]);
+                    }
+                }
+            }
+        });
+    }
+
+    //! Number of slabs per thread used by chooseNumSlabs to balance the load.
+    static constexpr size_t SLABS_PER_THREAD = 4;
+
+private:
+    //! Get the first row of a slab (or the number of rows for slab num_slabs).
+    size_t getFirstRow(size_t slab) const
+    {
+        return slab * m_num_rows / m_num_slabs;
+    }
+
+    size_t m_num_rows;  //!< Number of rows in the grid.
+    size_t m_row_size;  //!< Number of values in a row.
+    size_t m_halo;      //!< Number of halo rows on either side of each slab.
+    bool m_periodic;    //!< Whether rows wrap around periodically.
+    size_t m_num_slabs; //!< Number of slabs.
+};
+
+template<typename T, typename Combine> constexpr size_t SlabDeposition<T, Combine>::SLABS_PER_THREAD;
+
+//! Grid updated atomically from many threads, with the writer interface of SlabDeposition.
+/*! This is used when the halo is too wide to split the grid into independent
+ *  slabs. Every value is combined with a compare-and-swap loop, so any Combine
+ *  operation is supported. Its memory use is a single copy of the grid,
+ *  independent of the number of threads.
+ */
+template<typename T, typename Combine = std::plus<T>> class AtomicGridDeposition
+{
+public:
+    //! Writes contributions of points into the shared grid.
+    class Writer
+    {
+    public:
+        explicit Writer(AtomicGridDeposition& grid) : m_grid(grid) {}
+
+        void deposit(size_t row, size_t offset, T value) const
+        {
+            m_grid.combine(row * m_grid.m_row_size + offset, value);
+        }
+
+        void deposit(size_t row, size_t offset, const T* values, size_t count) const
+        {
+            const size_t first = row * m_grid.m_row_size + offset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_grid.combine(first + i, values[i]);
+            }
+        }
+
+        void fill(size_t row, size_t offset, T value, size_t count) const
+        {
+            const size_t first = row * m_grid.m_row_size + offset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_grid.combine(first + i, value);
+            }
+        }
+
+    private:
+        AtomicGridDeposition& m_grid; //!< Grid receiving the values.
+    };
+
+    //! Constructor
+    /*! \param num_rows Number of rows in the grid.
+     *  \param row_size Number of values in each row.
+     */
+    AtomicGridDeposition(size_t num_rows, size_t row_size)
+        : m_size(num_rows * row_size), m_row_size(row_size), m_values(new std::atomic<T>[m_size])
+    {
+        forLoopWrapper(0, m_size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_values[i].store(T(0), std::memory_order_relaxed);
+            }
+        });
+    }
+
+    //! Combine the deposited values into a grid of the same size, in parallel.
+    void combineInto(ManagedArray<T>& grid) const
+    {
+        T* grid_data = grid.get();
+        forLoopWrapper(0, m_size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                grid_data[i] = m_combine(grid_data[i], m_values[i].load(std::memory_order_relaxed));
+            }
+        });
+    }
+
+private:
+    void combine(size_t i, T value)
+    {
+        std::atomic<T>& target = m_values[i];
+        T current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, m_combine(current, value), std::memory_order_relaxed))
+        {
+        }
+    }
+
+    size_t m_size;                               //!< Number of values in the grid.
+    size_t m_row_size;                           //!< Number of values in a row.
+    std::unique_ptr<std::atomic<T>[]> m_values; //!< The deposited values.
+    Combine m_combine;                           //!< Operation combining values.
+};
+
+//! Deposit contributions of points onto a grid in parallel.
+/*! The grid is split into slabs with SlabDeposition whenever the halo allows
+ *  more than one slab, even if that leaves some threads idle, so that memory
+ *  use never grows with the number of threads. If the halo spans so much of
+ *  the grid that there is only a single slab, the points are deposited in
+ *  parallel into one atomically updated copy of the grid instead.
+ *
+ *  \param grid Grid of num_rows * row_size values, whose current values are combined with the contributions.
+ *  \param num_rows Number of rows in the grid.
+ *  \param row_size Number of values in each row.
+ *  \param halo Maximum distance in rows between the row of a point and the rows it writes to.
+ *  \param periodic Whether rows wrap around periodically.
+ *  \param num_points Number of points.
+ *  \param row_of Function returning the row (in [0, num_rows)) of a point.
+ *  \param deposit Function called as deposit(point, writer) for each point, which must accept both a
+ *         SlabDeposition<T, Combine>::Writer and an AtomicGridDeposition<T, Combine>::Writer.
+ */
+template<typename T, typename Combine = std::plus<T>, typename RowOf, typename Deposit>
+void depositOnGrid(ManagedArray<T>& grid, size_t num_rows, size_t row_size, size_t halo, bool periodic,
+                   size_t num_points, const RowOf& row_of, const Deposit& deposit)
+{
+    const size_t num_threads = getMaxConcurrency();
+    const size_t num_slabs = SlabDeposition<T, Combine>::chooseNumSlabs(num_rows, halo, num_threads);
+    if (num_slabs > 1 || num_threads == 1)
+    {
+        const SlabDeposition<T, Combine> slabs(num_rows, row_size, halo, periodic, num_slabs);
+        slabs.compute(grid, num_points, row_of, deposit);
+        return;
+    }
+
+    AtomicGridDeposition<T, Combine> shared(num_rows, row_size);
+    const typename AtomicGridDeposition<T, Combine>::Writer writer(shared);
+    forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            deposit(i, writer);
+        }
+    });
+    shared.combineInto(grid);
+}
+
+}; }; // end namespace freud::util
+
+#endif // SLAB_DEPOSITION_H
@@ -3,6 +3,7 @@
 
 #include "ManagedArray.h"
 #include "utils.h"
+#include <algorithm>
 #include <tbb/enumerable_thread_specific.h>
 #include <vector>
 
@@ -10,14 +11,20 @@ namespace freud { namespace util {
 
 //! Wrapper class for enumerable_thread_specific<T*>
 /*! It is expected that default value for T is 0.
+ *
+ *  Thread local arrays are created lazily by the first call to local() on
+ *  each thread and are zeroed serially by that thread, so their memory is
+ *  first touched by (and placed near) the thread that owns it. Zeroing them
+ *  in parallel would spread their pages across all workers and could let
+ *  the owning thread steal work that calls local() again while its array is
+ *  still being built. Their storage is padded to whole cache lines to avoid
+ *  false sharing.
  */
 template<typename T> class ThreadStorage
 {
 public:
     //! Default constructor
-    ThreadStorage()
-        : arrays(tbb::enumerable_thread_specific<ManagedArray<T>>([]() { return ManagedArray<T>(); }))
-    {}
+    ThreadStorage() : ThreadStorage(std::vector<size_t> {0}) {}
 
     //! Constructor with specific size for thread local arrays
     /*! \param size Size of the thread local arrays
@@ -27,10 +34,7 @@ public:
     //! Constructor with specific shape for thread local arrays
     /*! \param shape Vector of sizes in each dimension of the thread local arrays
      */
-    explicit ThreadStorage(const std::vector<size_t>& shape)
-        : arrays(
-            tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); }))
-    {}
+    explicit ThreadStorage(const std::vector<size_t>& shape) : arrays(makeLocalArrays(shape)) {}
 
     //! Destructor
     ~ThreadStorage() = default;
@@ -48,8 +52,7 @@ public:
      */
     void resize(std::vector<size_t> shape)
     {
-        arrays
-            = tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); });
+        arrays = makeLocalArrays(shape);
     }
 
     //! Reset the contents of thread local arrays to be 0
@@ -57,7 +60,7 @@ public:
     {
         for (auto array = arrays.begin(); array != arrays.end(); ++array)
         {
-            array->reset();
+            array->reset(false);
         }
     }
 
@@ -90,34 +93,101 @@ public:
         return arrays.local();
     }
 
+    //! Add the sum of the thread local arrays into the result array.
+    /*! The result is split into contiguous tiles that are reduced in
+     *  parallel. Within a tile the thread local arrays are summed as a
+     *  pairwise tree, streaming through one array at a time rather than
+     *  striding across all of them for every element. This keeps each task
+     *  reading from a single allocation at a time and limits the
+     *  growth of rounding errors to logarithmic in the number of threads.
+     */
     void reduceInto(ManagedArray<T>& result)
     {
-        if (arrays.size() == 0)
+        std::vector<const T*> local_arrays;
+        for (auto array = arrays.begin(); array != arrays.end(); ++array)
         {
-            // If no local arrays have been created, then no data can be reduced
-            // and an error will occur if we attempt to iterate over arrays.
+            local_arrays.push_back(array->get());
+        }
+
+        if (local_arrays.empty())
+        {
+            // If no local arrays have been created, then no data can be reduced.
             // We simply reset the result array so it's all zeros.
             result.reset();
+            return;
         }
-        else
-        {
-            // Reduce over arrays into the result array.
-            util::forLoopWrapper(0, result.size(), [=, &result](size_t begin, size_t end) {
-                for (size_t i = begin; i < end; ++i)
+
+        const size_t num_tiles = (result.size() + REDUCTION_TILE_SIZE - 1) / REDUCTION_TILE_SIZE;
+        util::forLoopWrapper(0, num_tiles, [&](size_t begin, size_t end) {
+            // Partial sums of 2^level arrays, with at most one per level.
+            std::vector<std::vector<T>> partial_sums;
+            std::vector<size_t> partial_levels;
+            for (size_t tile = begin; tile < end; ++tile)
+            {
+                const size_t offset = tile * REDUCTION_TILE_SIZE;
+                const size_t tile_size = std::min(REDUCTION_TILE_SIZE, result.size() - offset);
+                size_t num_partial = 0;
+                for (const T* local_array : local_arrays)
                 {
-                    for (auto arr = arrays.begin(); arr != arrays.end(); ++arr)
+                    if (partial_sums.size() == num_partial)
                     {
-                        result[i] += (*arr)[i];
+                        partial_sums.emplace_back(REDUCTION_TILE_SIZE);
+                        partial_levels.push_back(0);
+                    }
+                    std::copy(local_array + offset, local_array + offset + tile_size,
+                              partial_sums[num_partial].begin());
+                    partial_levels[num_partial] = 0;
+                    ++num_partial;
+
+                    // Merge partial sums of equal size, like carries in a binary counter.
+                    while (num_partial > 1
+                           && partial_levels[num_partial - 1] == partial_levels[num_partial - 2])
+                    {
+                        addTile(partial_sums[num_partial - 2], partial_sums[num_partial - 1], tile_size);
+                        ++partial_levels[num_partial - 2];
+                        --num_partial;
                     }
                 }
-            });
-        }
+                while (num_partial > 1)
+                {
+                    addTile(partial_sums[num_partial - 2], partial_sums[num_partial - 1], tile_size);
+                    --num_partial;
+                }
+
+                T* result_tile = result.get() + offset;
+                for (size_t i = 0; i < tile_size; ++i)
+                {
+                    result_tile[i] += partial_sums[0][i];
+                }
+            }
+        });
     }
 
 private:
+    //! Number of contiguous elements reduced together.
+    static constexpr size_t REDUCTION_TILE_SIZE = 1024;
+
+    //! Add the first n elements of source into target.
+    static void addTile(std::vector<T>& target, const std::vector<T>& source, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            target[i] += source[i];
+        }
+    }
+
+    //! Create thread local arrays that are zeroed serially by the thread that first uses them.
+    static tbb::enumerable_thread_specific<ManagedArray<T>> makeLocalArrays(const std::vector<size_t>& shape)
+    {
+        return tbb::enumerable_thread_specific<ManagedArray<T>>(
+            [shape]() { return ManagedArray<T>(shape, false); });
+    }
+
     tbb::enumerable_thread_specific<ManagedArray<T>> arrays; //!< thread local arrays
 };
 
+template<typename T> constexpr size_t ThreadStorage<T>::REDUCTION_TILE_SIZE;
+
 }; }; // end namespace freud::util
 
 #endif
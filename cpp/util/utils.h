@@ -7,6 +7,8 @@
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
 
+#include "ExecutionContext.h"
+
 namespace freud { namespace util {
 
 //! Clip v if it is outside the range [lo, hi].
@@ -37,8 +39,10 @@ inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool para
 {
     if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
-                          [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        executeInActiveContext([&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+                              [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        });
     }
     else
     {
@@ -60,10 +64,12 @@ inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col,
 {
     if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
-                          [&body](const tbb::blocked_range2d<size_t>& r) {
-                              body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-                          });
+        executeInActiveContext([&]() {
+            tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
+                              [&body](const tbb::blocked_range2d<size_t>& r) {
+                                  body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+                              });
+        });
     }
     else
     {
@@ -42,12 +42,20 @@ cdef extern from "Box.h" namespace "freud::box":
         void unwrap(vec3[float]*, const vec3[int]*,
                     unsigned int) const
         vec3[float] centerOfMass(vec3[float]*, size_t, float*) const
+        void centersOfMass(vec3[float]*, size_t, const unsigned int*,
+                           unsigned int, vec3[float]*, float*) const
         void center(vec3[float]*, size_t, float*) const
         void computeDistances(vec3[float]*, unsigned int,
                               vec3[float]*, unsigned int, float*
                               ) except +
         void computeAllDistances(vec3[float]*, unsigned int,
                                  vec3[float]*, unsigned int, float*)
+        void computeNearestDistances(vec3[float]*, unsigned int,
+                                     vec3[float]*, unsigned int, unsigned int,
+                                     float*, unsigned int*) except +
+        void computeDistanceHistogram(vec3[float]*, unsigned int,
+                                      vec3[float]*, unsigned int, float,
+                                      unsigned int, unsigned int*) except +
         void contains(vec3[float]*, unsigned int, bool*) const
         vec3[bool] getPeriodic() const
         bool getPeriodicX() const
@@ -57,3 +65,6 @@ cdef extern from "Box.h" namespace "freud::box":
         void setPeriodicX(bool)
         void setPeriodicY(bool)
         void setPeriodicZ(bool)
+
+cdef extern from "BoxBatch.h" namespace "freud::box":
+    void sinCosTurns(const float*, float*, float*, unsigned int)
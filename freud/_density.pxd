@@ -4,26 +4,41 @@
 from freud.util cimport vec3
 from freud._locality cimport BondHistogramCompute
 from libcpp cimport bool
+from libcpp.vector cimport vector
 
 cimport freud._box
 cimport freud._locality
+cimport freud._util
 cimport freud.util
 
 ctypedef unsigned int uint
 
 cdef extern from "CorrelationFunction.h" namespace "freud::density":
+    ctypedef enum CorrelationFunctionMethod:
+        correlation_direct
+        correlation_fft
+
     cdef cppclass CorrelationFunction[T](BondHistogramCompute):
-        CorrelationFunction(float, float) except +
+        CorrelationFunction(unsigned int, float, CorrelationFunctionMethod,
+                            float) except +
         void accumulate(const freud._locality.NeighborQuery*, const T*,
                         const vec3[float]*,
                         const T*,
                         unsigned int, const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[T] &getCorrelation()
+        CorrelationFunctionMethod getMethod() const
+        float getGridSpacing() const
 
 cdef extern from "GaussianDensity.h" namespace "freud::density":
+    ctypedef enum GaussianDensityMethod:
+        method_automatic
+        method_direct
+        method_fft
+
     cdef cppclass GaussianDensity:
-        GaussianDensity(vec3[unsigned int], float, float) except +
+        GaussianDensity(vec3[unsigned int], float, float,
+                        GaussianDensityMethod) except +
         const freud._box.Box & getBox() const
         void reset()
         void compute(const freud._locality.NeighborQuery*,
@@ -32,10 +47,14 @@ cdef extern from "GaussianDensity.h" namespace "freud::density":
         vec3[unsigned int] getWidth() const
         float getSigma() const
         float getRMax() const
+        GaussianDensityMethod getMethod() const
+        freud._util.AccumulationStrategy getAccumulationStrategy() const
+        void setAccumulationStrategy(freud._util.AccumulationStrategy)
 
 cdef extern from "LocalDensity.h" namespace "freud::density":
     cdef cppclass LocalDensity:
         LocalDensity(float, float)
+        LocalDensity(vector[float], float) except +
         const freud._box.Box & getBox() const
         void compute(
             const freud._locality.NeighborQuery*,
@@ -45,6 +64,8 @@ cdef extern from "LocalDensity.h" namespace "freud::density":
         const freud.util.ManagedArray[float] &getDensity() const
         const freud.util.ManagedArray[float] &getNumNeighbors() const
         float getRMax() const
+        const vector[float] &getRMaxs() const
+        bool hasMultipleRadii() const
         float getDiameter() const
 
 cdef extern from "RDF.h" namespace "freud::density":
@@ -58,6 +79,38 @@ cdef extern from "RDF.h" namespace "freud::density":
                         freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
+        void setDoubleBuffered(bool)
+        bool isDoubleBuffered() const
+
+cdef extern from "PartialRDF.h" namespace "freud::density":
+    cdef cppclass PartialRDF(BondHistogramCompute):
+        PartialRDF(unsigned int, unsigned int, float, float, bool) except +
+        const freud._box.Box & getBox() const
+        void accumulate(const freud._locality.NeighborQuery*,
+                        const vec3[float]*,
+                        unsigned int,
+                        const unsigned int*,
+                        const unsigned int*,
+                        const freud._locality.NeighborList*,
+                        freud._locality.QueryArgs) except +
+        const freud.util.ManagedArray[float] &getRDF()
+        const freud.util.ManagedArray[float] &getNr()
+        unsigned int getNumTypes() const
+
+cdef extern from "MeshDensity.h" namespace "freud::density":
+    ctypedef enum MeshAssignment:
+        assignment_ngp
+        assignment_cic
+        assignment_tsc
+
+    cdef cppclass MeshDensity:
+        MeshDensity(vec3[unsigned int], MeshAssignment) except +
+        const freud._box.Box & getBox() const
+        void compute(const freud._locality.NeighborQuery*,
+                     const float*) except +
+        const freud.util.ManagedArray[float] &getDensity() const
+        vec3[unsigned int] getWidth() const
+        MeshAssignment getAssignment() const
 
 cdef extern from "SphereVoxelization.h" namespace "freud::density":
     cdef cppclass SphereVoxelization:
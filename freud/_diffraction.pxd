@@ -0,0 +1,36 @@
+# Copyright (c) 2010-2020 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from freud.util cimport quat, vec3
+from freud._locality cimport BondHistogramCompute
+
+cimport freud._locality
+cimport freud.util
+
+cdef extern from "StaticStructureFactor.h" namespace "freud::diffraction":
+    ctypedef enum StaticStructureFactorMethod:
+        structure_factor_debye
+        structure_factor_direct
+
+    cdef cppclass StaticStructureFactor(BondHistogramCompute):
+        StaticStructureFactor(unsigned int, float, float,
+                              StaticStructureFactorMethod, float,
+                              unsigned int) except +
+        void accumulate(const freud._locality.NeighborQuery*,
+                        const vec3[float]*,
+                        unsigned int, const freud._locality.NeighborList*,
+                        freud._locality.QueryArgs) except +
+        const freud.util.ManagedArray[float] &getStructureFactor()
+        StaticStructureFactorMethod getMethod() const
+        float getRMax() const
+        unsigned int getMaxKPoints() const
+
+cdef extern from "DiffractionPattern.h" namespace "freud::diffraction":
+    cdef cppclass DiffractionPattern:
+        DiffractionPattern(unsigned int, unsigned int) except +
+        void compute(const freud._locality.NeighborQuery*,
+                     const quat[float]*, unsigned int, double,
+                     double) except +
+        const freud.util.ManagedArray[double] &getDiffraction() const
+        unsigned int getGridSize() const
+        unsigned int getOutputSize() const
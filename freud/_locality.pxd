@@ -7,6 +7,7 @@ from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
 from libcpp.pair cimport pair
 cimport freud._box
+cimport freud._util
 cimport freud.util
 
 cdef extern from "NeighborBond.h" namespace "freud::locality":
@@ -34,6 +35,11 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         float r_guess
         float scale
         bool exclude_ii
+        vector[float] r_shells
+        unsigned int num_types
+        const float* r_max_pairs
+        const unsigned int* point_types
+        const unsigned int* query_point_types
 
     cdef cppclass NeighborQuery:
         NeighborQuery() except +
@@ -56,6 +62,7 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         bool end()
         NeighborBond next()
         NeighborList *toNeighborList(bool)
+        vector[NeighborList*] toNeighborLists(bool) except +
 
 cdef extern from "RawPoints.h" namespace "freud::locality":
 
@@ -85,6 +92,9 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
         void setNumBonds(unsigned int, unsigned int, unsigned int)
         unsigned int filter[Iterator](const Iterator) except +
         unsigned int filter_r(float, float) except +
+        NeighborList* setUnion(const NeighborList &) except +
+        NeighborList* setIntersection(const NeighborList &) except +
+        NeighborList* setDifference(const NeighborList &) except +
 
         unsigned int find_first_index(unsigned int)
 
@@ -119,6 +129,9 @@ cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
         vector[vector[float]] getBinCenters() const
         vector[pair[float, float]] getBounds() const
         vector[size_t] getAxisSizes() const
+        freud._util.AccumulationStrategy getAccumulationStrategy() const
+        void setAccumulationStrategy(
+            freud._util.AccumulationStrategy) except +
 
 cdef extern from "PeriodicBuffer.h" namespace "freud::locality":
     cdef cppclass PeriodicBuffer:
@@ -56,6 +56,8 @@ cdef extern from "HexaticTranslational.h" namespace "freud::order":
         const freud.util.ManagedArray[float complex] &getOrder()
         unsigned int getK()
         bool isWeighted() const
+        void setDoubleBuffered(bool)
+        bool isDoubleBuffered() const
 
     cdef cppclass Translational:
         Translational(float, bool)
@@ -81,6 +83,8 @@ cdef extern from "Steinhardt.h" namespace "freud::order":
         bool isWl() const
         bool isWeighted() const
         bool isWlNormalized() const
+        void setDoubleBuffered(bool)
+        bool isDoubleBuffered() const
         unsigned int getL() const
 
 
@@ -1,5 +1,36 @@
 # Copyright (c) 2010-2020 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
+from libcpp.vector cimport vector
+
 cdef extern from "tbb_config.h" namespace "freud::parallel":
     void setNumThreads(unsigned int)
+
+cdef extern from "ArrayPool.h" namespace "freud::util":
+    cdef cppclass ArrayPool:
+        @staticmethod
+        void setEnabled(bool)
+        @staticmethod
+        bool isEnabled()
+        @staticmethod
+        void setHugePages(bool)
+        @staticmethod
+        bool getHugePages()
+        @staticmethod
+        void setMaxCachedBytes(size_t)
+        @staticmethod
+        size_t getMaxCachedBytes()
+        @staticmethod
+        size_t getCachedBytes()
+
+cdef extern from "ExecutionContext.h" namespace "freud::util":
+    cdef cppclass ExecutionContext:
+        ExecutionContext(unsigned int, int) except +
+        unsigned int getNumThreads() const
+        int getNumaNode() const
+        int getMaxConcurrency() const
+        void activate()
+        void deactivate() except +
+        @staticmethod
+        vector[int] getNumaNodes()
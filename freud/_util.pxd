@@ -29,5 +29,14 @@ cdef extern from "ManagedArray.h" namespace "freud::util":
         vector[size_t] shape() const
 
 
+cdef extern from "BinAccumulator.h" namespace "freud::util":
+    ctypedef enum AccumulationStrategy "freud::util::AccumulationStrategy":
+        accumulate_automatic "freud::util::AccumulationStrategy::automatic"
+        accumulate_dense "freud::util::AccumulationStrategy::dense"
+        accumulate_atomic "freud::util::AccumulationStrategy::atomic"
+        accumulate_cache "freud::util::AccumulationStrategy::cache"
+        accumulate_sparse "freud::util::AccumulationStrategy::sparse"
+
+
 cdef extern from "numpy/arrayobject.h":
     cdef int PyArray_SetBaseObject(numpy.ndarray arr, obj)
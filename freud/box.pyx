@@ -191,10 +191,11 @@ cdef class Box:
             :math:`\left(3, \right)` or :math:`\left(N, 3\right)` :class:`numpy.ndarray`:
                 Absolute coordinate vector(s).
         """  # noqa: E501
-        fractions = np.asarray(fractional_coordinates).copy()
+        fractions = np.asarray(fractional_coordinates)
         flatten = fractions.ndim == 1
         fractions = np.atleast_2d(fractions)
-        fractions = freud.util._convert_array(fractions, shape=(None, 3))
+        fractions = freud.util._convert_array(fractions, shape=(None, 3),
+                                              copy=True)
 
         cdef const float[:, ::1] l_points = fractions
         cdef unsigned int Np = l_points.shape[0]
@@ -213,10 +214,10 @@ cdef class Box:
             :math:`\left(3, \right)` or :math:`\left(N, 3\right)` :class:`numpy.ndarray`:
                 Fractional coordinate vector(s).
         """  # noqa: E501
-        vecs = np.asarray(absolute_coordinates).copy()
+        vecs = np.asarray(absolute_coordinates)
         flatten = vecs.ndim == 1
         vecs = np.atleast_2d(vecs)
-        vecs = freud.util._convert_array(vecs, shape=(None, 3))
+        vecs = freud.util._convert_array(vecs, shape=(None, 3), copy=True)
 
         cdef const float[:, ::1] l_points = vecs
         cdef unsigned int Np = l_points.shape[0]
@@ -299,7 +300,7 @@ cdef class Box:
         vecs = np.asarray(vecs)
         flatten = vecs.ndim == 1
         vecs = np.atleast_2d(vecs)
-        vecs = freud.util._convert_array(vecs, shape=(None, 3)).copy()
+        vecs = freud.util._convert_array(vecs, shape=(None, 3), copy=True)
 
         cdef const float[:, ::1] l_points = vecs
         cdef unsigned int Np = l_points.shape[0]
@@ -329,7 +330,7 @@ cdef class Box:
         if vecs.shape[0] != imgs.shape[0]:
             # Broadcasts (1, 3) to (N, 3) for both arrays
             vecs, imgs = np.broadcast_arrays(vecs, imgs)
-        vecs = freud.util._convert_array(vecs, shape=(None, 3)).copy()
+        vecs = freud.util._convert_array(vecs, shape=(None, 3), copy=True)
         imgs = freud.util._convert_array(imgs, shape=vecs.shape,
                                          dtype=np.int32)
 
@@ -384,6 +385,68 @@ cdef class Box:
             <vec3[float]*> &l_points[0, 0], Np, l_masses_ptr)
         return np.asarray([result.x, result.y, result.z])
 
+    def centers_of_mass(self, vecs, labels, num_labels=None, masses=None):
+        R"""Compute the centers of mass of labeled groups of vectors, using periodic boundaries.
+
+        This computes :meth:`~.center_of_mass` for every group of vectors
+        sharing a label in a single pass over the vectors, for instance for
+        all clusters found by :class:`freud.cluster.Cluster`.
+
+        Example::
+
+            >>> import freud
+            >>> box = freud.Box.cube(10)
+            >>> points = [[-1, -1, 0], [-1, 1, 0], [2, 0, 0], [4.5, 0, 0],
+            ...           [-4.5, 0, 0]]
+            >>> centers = box.centers_of_mass(points, [0, 0, 0, 1, 1])
+            >>> centers.shape
+            (2, 3)
+
+        Args:
+            vecs (:math:`\left(N, 3\right)` :class:`numpy.ndarray`):
+                Vectors used to find centers of mass.
+            labels (:math:`\left(N, \right)` :class:`numpy.ndarray`):
+                Label of each vector.
+            num_labels (unsigned int):
+                Number of labels, greater than all labels. Labels without
+                any vectors have NaN centers. If :code:`None`, one more than
+                the largest label is used (Default value = :code:`None`).
+            masses (:math:`\left(N, \right)` :class:`numpy.ndarray`):
+                Masses corresponding to each vector, defaulting to 1 if not
+                provided or :code:`None` (Default value = :code:`None`).
+
+        Returns:
+            :math:`\left(N_{labels}, 3\right)` :class:`numpy.ndarray`:
+                Center of mass of each label.
+        """  # noqa: E501
+        vecs = freud.util._convert_array(vecs, shape=(None, 3))
+        labels = freud.util._convert_array(
+            labels, shape=(len(vecs), ), dtype=np.uint32)
+        if num_labels is None:
+            num_labels = int(labels.max()) + 1 if len(labels) > 0 else 0
+        if len(labels) > 0 and labels.max() >= num_labels:
+            raise ValueError("All labels must be less than num_labels.")
+
+        cdef unsigned int l_num_labels = num_labels
+        cdef float[:, ::1] centers = np.full(
+            (l_num_labels, 3), np.nan, dtype=np.float32)
+        cdef size_t Np = vecs.shape[0]
+        if Np == 0 or l_num_labels == 0:
+            return np.asarray(centers)
+
+        cdef const float[:, ::1] l_points = vecs
+        cdef const unsigned int[::1] l_labels = labels
+        cdef float* l_masses_ptr = NULL
+        cdef float[::1] l_masses
+        if masses is not None:
+            l_masses = freud.util._convert_array(masses, shape=(len(vecs), ))
+            l_masses_ptr = &l_masses[0]
+
+        self.thisptr.centersOfMass(
+            <vec3[float]*> &l_points[0, 0], Np, &l_labels[0], l_num_labels,
+            <vec3[float]*> &centers[0, 0], l_masses_ptr)
+        return np.asarray(centers)
+
     def center(self, vecs, masses=None):
         R"""Subtract center of mass from an array of vectors, using periodic boundaries.
 
@@ -412,7 +475,7 @@ cdef class Box:
             :math:`\left(N, 3\right)` :class:`numpy.ndarray`:
                 Vectors with center of mass subtracted.
         """  # noqa: E501
-        vecs = freud.util._convert_array(vecs, shape=(None, 3)).copy()
+        vecs = freud.util._convert_array(vecs, shape=(None, 3), copy=True)
         cdef const float[:, ::1] l_points = vecs
 
         cdef float* l_masses_ptr = NULL
@@ -497,6 +560,95 @@ cdef class Box:
 
         return np.asarray(distances)
 
+    def compute_nearest_distances(self, query_points, points, k=1):
+        R"""Find the nearest points to each query point by comparing all pairs.
+
+        This calculates the same distances as
+        :meth:`~.compute_all_distances`, but only keeps the ``k`` smallest
+        distances of each query point, so no
+        :math:`N_{query\_points} \times N_{points}` array is allocated.
+
+        Args:
+            query_points (:math:`\left(N_{query\_points}, 3 \right)` :class:`numpy.ndarray`):
+                Array of query points.
+            points (:math:`\left(N_{points}, 3 \right)` :class:`numpy.ndarray`):
+                Array of points.
+            k (unsigned int):
+                Number of nearest points to find for each query point, at
+                most :math:`N_{points}` (Default value = 1).
+
+        Returns:
+            tuple (:math:`\left(N_{query\_points}, k \right)` :class:`numpy.ndarray`, :math:`\left(N_{query\_points}, k \right)` :class:`numpy.ndarray`):
+                Distances to the nearest points of each query point in
+                increasing order, and the indices of those points.
+        """  # noqa: E501
+        query_points = freud.util._convert_array(
+            np.atleast_2d(query_points), shape=(None, 3))
+        points = freud.util._convert_array(
+            np.atleast_2d(points), shape=(None, 3))
+
+        cdef:
+            const float[:, ::1] l_query_points = query_points
+            const float[:, ::1] l_points = points
+            size_t n_query_points = query_points.shape[0]
+            size_t n_points = points.shape[0]
+            unsigned int l_k = k
+            float[:, ::1] distances = np.empty(
+                [n_query_points, l_k], dtype=np.float32)
+            unsigned int[:, ::1] indices = np.empty(
+                [n_query_points, l_k], dtype=np.uint32)
+
+        self.thisptr.computeNearestDistances(
+            <vec3[float]*> &l_query_points[0, 0], n_query_points,
+            <vec3[float]*> &l_points[0, 0], n_points, l_k,
+            <float *> &distances[0, 0], <unsigned int*> &indices[0, 0])
+
+        return np.asarray(distances), np.asarray(indices)
+
+    def compute_distance_histogram(self, query_points, points, bins, r_max):
+        R"""Histogram the distances between all pairs of query points and points.
+
+        This calculates the same distances as
+        :meth:`~.compute_all_distances`, but only counts them, so no
+        :math:`N_{query\_points} \times N_{points}` array is allocated.
+
+        Args:
+            query_points (:math:`\left(N_{query\_points}, 3 \right)` :class:`numpy.ndarray`):
+                Array of query points.
+            points (:math:`\left(N_{points}, 3 \right)` :class:`numpy.ndarray`):
+                Array of points.
+            bins (unsigned int):
+                Number of bins of width :math:`r_{max} / bins`.
+            r_max (float):
+                Upper bound of the histogram. As in
+                :func:`numpy.histogram`, the last bin includes its right
+                edge, so pairs at a distance of exactly :code:`r_max` are
+                counted and pairs at larger distances are not.
+
+        Returns:
+            :math:`\left(bins, \right)` :class:`numpy.ndarray`:
+                Number of pairs in each bin.
+        """  # noqa: E501
+        query_points = freud.util._convert_array(
+            np.atleast_2d(query_points), shape=(None, 3))
+        points = freud.util._convert_array(
+            np.atleast_2d(points), shape=(None, 3))
+
+        cdef:
+            const float[:, ::1] l_query_points = query_points
+            const float[:, ::1] l_points = points
+            size_t n_query_points = query_points.shape[0]
+            size_t n_points = points.shape[0]
+            unsigned int l_bins = bins
+            unsigned int[::1] counts = np.empty(l_bins, dtype=np.uint32)
+
+        self.thisptr.computeDistanceHistogram(
+            <vec3[float]*> &l_query_points[0, 0], n_query_points,
+            <vec3[float]*> &l_points[0, 0], n_points, r_max, l_bins,
+            <unsigned int*> &counts[0])
+
+        return np.asarray(counts)
+
     def contains(self, points):
         R"""Returns boolean array (mask) corresponding to point membership in a box.
 
@@ -860,3 +1012,32 @@ cdef BoxFromCPP(const freud._box.Box & cppbox):
                   cppbox.getPeriodicY(),
                   cppbox.getPeriodicZ()]
     return b
+
+
+def _sin_cos_turns(turns):
+    R"""Compute the sines and cosines of angles given in turns.
+
+    This exposes the vectorized evaluation used for periodic centers of mass
+    for testing.
+
+    Args:
+        turns (:math:`\left(N, \right)` :class:`numpy.ndarray`):
+            Angles in turns (one turn is :math:`2 \pi`).
+
+    Returns:
+        tuple (:math:`\left(N, \right)` :class:`numpy.ndarray`, :math:`\left(N, \right)` :class:`numpy.ndarray`):
+            The sines and cosines of the angles.
+    """  # noqa: E501
+    turns = freud.util._convert_array(turns, shape=(None, ))
+    cdef unsigned int n = turns.shape[0]
+    # The vectorized implementation processes lanes of 8 angles, so the
+    # buffers are padded to a multiple of 8.
+    cdef unsigned int padded_n = (n + 7) // 8 * 8
+    if n == 0:
+        return np.empty(0, dtype=np.float32), np.empty(0, dtype=np.float32)
+    cdef float[::1] l_turns = np.zeros(padded_n, dtype=np.float32)
+    l_turns[:n] = turns
+    cdef float[::1] sines = np.empty(padded_n, dtype=np.float32)
+    cdef float[::1] cosines = np.empty(padded_n, dtype=np.float32)
+    freud._box.sinCosTurns(&l_turns[0], &sines[0], &cosines[0], n)
+    return np.asarray(sines)[:n], np.asarray(cosines)[:n]
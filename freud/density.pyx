@@ -13,10 +13,12 @@ import numpy as np
 
 from cython.operator cimport dereference
 from freud.util cimport _Compute
-from freud.locality cimport _PairCompute, _SpatialHistogram1D
+from freud.locality cimport (_PairCompute, _SpatialHistogram,
+                             _SpatialHistogram1D)
 from freud.util cimport vec3
 
 from collections.abc import Sequence
+from libcpp.vector cimport vector
 
 cimport freud._density
 cimport freud.box
@@ -54,18 +56,56 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
         :code:`None`, we omit accumulating the self-correlation value in the
         first bin.
 
+    .. note::
+        **FFT method:** With :code:`method='fft'`, the values and the number
+        of points are deposited onto grids spanning the box, which are
+        correlated with fast Fourier transforms, and the correlation of each
+        grid displacement is binned by its length. The cost no longer grows
+        with the number of bonds within :code:`r_max`, which makes this much
+        faster for correlations extending over a large part of the box, but
+        distances are rounded to displacements between grid cells, so the
+        result approximates the direct method to within the grid spacing. All
+        pairs of points within :code:`r_max` are included, so neighbor lists
+        are not supported, and :code:`r_max` may be at most half the width of
+        the box along periodic dimensions.
+
     Args:
         bins (unsigned int):
             The number of bins in the RDF.
         r_max (float):
             Maximum pointwise distance to include in the calculation.
+        method (str, optional):
+            Method used to compute the correlation function, either
+            :code:`'direct'` to accumulate the product of the values of every
+            bond, or :code:`'fft'` to correlate the values on a grid with fast
+            Fourier transforms (Default value = :code:`'direct'`).
+        grid_spacing (float, optional):
+            Grid spacing of the :code:`'fft'` method. Uses the bin width
+            :code:`r_max / bins` if :code:`None` (Default value =
+            :code:`None`).
     """  # noqa E501
     cdef freud._density.CorrelationFunction[np.complex128_t] * thisptr
     cdef is_complex
 
-    def __cinit__(self, unsigned int bins, float r_max):
+    known_methods = {'direct': freud._density.correlation_direct,
+                     'fft': freud._density.correlation_fft}
+
+    def __cinit__(self, unsigned int bins, float r_max, str method='direct',
+                  grid_spacing=None):
+        cdef freud._density.CorrelationFunctionMethod l_method
+        try:
+            l_method = self.known_methods[method]
+        except KeyError:
+            raise ValueError(
+                'Unknown CorrelationFunction method: {}'.format(method))
+        if grid_spacing is None:
+            grid_spacing = 0
+        elif grid_spacing <= 0:
+            raise ValueError("grid_spacing must be positive.")
+
         self.thisptr = self.histptr = new \
-            freud._density.CorrelationFunction[np.complex128_t](bins, r_max)
+            freud._density.CorrelationFunction[np.complex128_t](
+                bins, r_max, l_method, grid_spacing)
         self.r_max = r_max
         self.is_complex = False
 
@@ -97,7 +137,11 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
                 neighbor pairs to use in the calculation, or a dictionary of
                 `query arguments
                 <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
-                (Default value: None).
+                (Default value: None). The :code:`'fft'` method correlates
+                all pairs within :code:`r_max` and raises a
+                :class:`ValueError` for any query argument other than
+                :code:`exclude_ii` (and :code:`r_max` equal to that of the
+                histogram).
             reset (bool):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
@@ -151,9 +195,25 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             freud.util.arr_type_t.COMPLEX_DOUBLE)
         return output if self.is_complex else np.real(output)
 
+    @property
+    def method(self):
+        """str: Method used to compute the correlation function."""
+        method = self.thisptr.getMethod()
+        for key, value in self.known_methods.items():
+            if value == method:
+                return key
+
+    @property
+    def grid_spacing(self):
+        """float: Grid spacing of the :code:`'fft'` method."""
+        return self.thisptr.getGridSpacing()
+
     def __repr__(self):
-        return ("freud.density.{cls}(bins={bins}, r_max={r_max})").format(
-            cls=type(self).__name__, bins=self.nbins, r_max=self.r_max)
+        return ("freud.density.{cls}(bins={bins}, r_max={r_max}, "
+                "method='{method}', grid_spacing={grid_spacing})").format(
+                    cls=type(self).__name__, bins=self.nbins,
+                    r_max=self.r_max, method=self.method,
+                    grid_spacing=self.grid_spacing)
 
     def plot(self, ax=None):
         """Plot complex correlation function.
@@ -210,10 +270,27 @@ cdef class GaussianDensity(_Compute):
             Distance over which to blur.
         sigma (float):
             Sigma parameter for Gaussian.
+        method (str, optional):
+            Method used to compute the density. :code:`'direct'` evaluates the
+            Gaussian of each point on every grid cell within :code:`r_max`.
+            :code:`'fft'` deposits the points on the grid with cloud-in-cell
+            assignment and convolves the grid with the Gaussian using fast
+            Fourier transforms, at a cost that does not grow with
+            :code:`sigma`. It requires an orthorhombic box and agrees with the
+            direct method up to a relative error of order
+            :math:`(\text{grid spacing} / \sigma)^2`, about 1% in typical
+            use. :code:`'auto'` uses the FFT method if it is estimated to be
+            faster and :code:`sigma` spans at least 4 grid cells, and the
+            direct method otherwise, so its results may differ slightly from
+            the direct method (Default value = :code:`'direct'`).
     """  # noqa: E501
     cdef freud._density.GaussianDensity * thisptr
 
-    def __cinit__(self, width, r_max, sigma):
+    known_methods = {'auto': freud._density.method_automatic,
+                     'direct': freud._density.method_direct,
+                     'fft': freud._density.method_fft}
+
+    def __cinit__(self, width, r_max, sigma, str method='direct'):
         cdef vec3[uint] width_vector
         if isinstance(width, int):
             width_vector = vec3[uint](width, width, width)
@@ -226,8 +303,15 @@ cdef class GaussianDensity(_Compute):
                              "sequence indicating the widths in each spatial "
                              "dimension (length 2 in 2D, length 3 in 3D).")
 
+        cdef freud._density.GaussianDensityMethod l_method
+        try:
+            l_method = self.known_methods[method]
+        except KeyError:
+            raise ValueError(
+                'Unknown GaussianDensity method: {}'.format(method))
+
         self.thisptr = new freud._density.GaussianDensity(
-            width_vector, r_max, sigma)
+            width_vector, r_max, sigma, l_method)
 
     def __dealloc__(self):
         del self.thisptr
@@ -292,12 +376,34 @@ cdef class GaussianDensity(_Compute):
         cdef vec3[uint] width = self.thisptr.getWidth()
         return (width.x, width.y, width.z)
 
+    @property
+    def method(self):
+        """str: Method used to compute the density."""
+        method = self.thisptr.getMethod()
+        for key, value in self.known_methods.items():
+            if value == method:
+                return key
+
+    @property
+    def accumulation_strategy(self):
+        """str: How the :code:`'fft'` method accumulates the points deposited
+        on the grid across threads (see
+        :attr:`freud.density.RDF.accumulation_strategy`). One of
+        :code:`'auto'` (the default), :code:`'dense'`, :code:`'atomic'`,
+        :code:`'cache'`, or :code:`'sparse'`. Can be changed at any time."""
+        return freud.util._from_accumulation_strategy(
+            self.thisptr.getAccumulationStrategy())
+
+    @accumulation_strategy.setter
+    def accumulation_strategy(self, value):
+        self.thisptr.setAccumulationStrategy(
+            freud.util._to_accumulation_strategy(value))
+
     def __repr__(self):
         return ("freud.density.{cls}({width}, "
-                "{r_max}, {sigma})").format(cls=type(self).__name__,
-                                            width=self.width,
-                                            r_max=self.r_max,
-                                            sigma=self.sigma)
+                "{r_max}, {sigma}, method='{method}')").format(
+                    cls=type(self).__name__, width=self.width,
+                    r_max=self.r_max, sigma=self.sigma, method=self.method)
 
     def plot(self, ax=None):
         """Plot Gaussian Density.
@@ -432,6 +538,164 @@ cdef class SphereVoxelization(_Compute):
             return None
 
 
+cdef class MeshDensity(_Compute):
+    R"""Computes the density of a system on a grid with particle-mesh
+    assignment.
+
+    The value of each point (1 if no values are given) is distributed over the
+    grid cells around it with the weights of an assignment scheme, which sum
+    to one, and divided by the cell volume:
+
+    .. math::
+
+        \rho(\vec{r}_c) = \frac{1}{V_c} \sum_i W(\vec{r}_c - \vec{r}_i) p_i
+
+    The available schemes are:
+
+    * :code:`'ngp'` (nearest grid point): the cell containing the point.
+    * :code:`'cic'` (cloud in cell): linear weights over the 2 cells per
+      dimension whose centers surround the point.
+    * :code:`'tsc'` (triangular shaped cloud): quadratic weights over the cell
+      containing the point and its neighbors, 3 cells per dimension.
+
+    Since each point only contributes to 1, 8, or 27 cells in 3D, this is much
+    faster than :class:`~.GaussianDensity` for coarse fields of many points,
+    e.g. as the input of Fourier transforms for structure factors or density
+    fluctuations. Higher order schemes reduce aliasing at a slightly higher
+    cost.
+
+    The grid spans the box along its box vectors, so the cells of triclinic
+    boxes are parallelepipeds. Assignment wraps around periodic dimensions,
+    while contributions outside of the grid along aperiodic dimensions are
+    discarded.
+
+    Args:
+        width (int or Sequence[int]):
+            The number of cells in the grid in each dimension (identical in
+            all dimensions if a single integer value is provided).
+        assignment (str, optional):
+            Assignment scheme, one of :code:`'ngp'`, :code:`'cic'`, or
+            :code:`'tsc'` (Default value = :code:`'cic'`).
+    """
+    cdef freud._density.MeshDensity * thisptr
+
+    known_assignments = {'ngp': freud._density.assignment_ngp,
+                         'cic': freud._density.assignment_cic,
+                         'tsc': freud._density.assignment_tsc}
+
+    def __cinit__(self, width, str assignment='cic'):
+        cdef vec3[uint] width_vector
+        if isinstance(width, int):
+            width_vector = vec3[uint](width, width, width)
+        elif isinstance(width, Sequence) and len(width) == 2:
+            width_vector = vec3[uint](width[0], width[1], 1)
+        elif isinstance(width, Sequence) and len(width) == 3:
+            width_vector = vec3[uint](width[0], width[1], width[2])
+        else:
+            raise ValueError("The width must be either a number of cells or "
+                             "a sequence indicating the widths in each "
+                             "spatial dimension (length 2 in 2D, length 3 in "
+                             "3D).")
+
+        cdef freud._density.MeshAssignment l_assignment
+        try:
+            l_assignment = self.known_assignments[assignment]
+        except KeyError:
+            raise ValueError(
+                'Unknown MeshDensity assignment: {}'.format(assignment))
+
+        self.thisptr = new freud._density.MeshDensity(
+            width_vector, l_assignment)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @_Compute._computed_property
+    def box(self):
+        """:class:`freud.box.Box`: Box used in the calculation."""
+        return freud.box.BoxFromCPP(self.thisptr.getBox())
+
+    def compute(self, system, values=None):
+        R"""Assigns the points to the grid.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            values ((:math:`N_{points}`) :class:`numpy.ndarray`):
+                Values (e.g. masses) associated with the system points. Uses a
+                value of 1 for every point if :code:`None`. (Default value =
+                :code:`None`).
+        """
+        cdef freud.locality.NeighborQuery nq = \
+            freud.locality.NeighborQuery.from_system(system)
+
+        cdef float* l_values_ptr = NULL
+        cdef float[::1] l_values
+        if values is not None:
+            l_values = freud.util._convert_array(
+                values, shape=(nq.points.shape[0], ))
+            l_values_ptr = &l_values[0]
+
+        self.thisptr.compute(nq.get_ptr(), l_values_ptr)
+        return self
+
+    @_Compute._computed_property
+    def density(self):
+        """(:math:`w_x`, :math:`w_y`, :math:`w_z`) :class:`numpy.ndarray`: The
+        density in each grid cell."""
+        data = freud.util.make_managed_numpy_array(
+            &self.thisptr.getDensity(), freud.util.arr_type_t.FLOAT)
+        if self.box.is2D:
+            return np.squeeze(data)
+        else:
+            return data
+
+    @property
+    def assignment(self):
+        """str: Assignment scheme."""
+        assignment = self.thisptr.getAssignment()
+        for key, value in self.known_assignments.items():
+            if value == assignment:
+                return key
+
+    @property
+    def width(self):
+        """tuple[int]: The number of cells in the grid in each dimension
+        (identical in all dimensions if a single integer value is provided)."""
+        cdef vec3[uint] width = self.thisptr.getWidth()
+        return (width.x, width.y, width.z)
+
+    def __repr__(self):
+        return ("freud.density.{cls}({width}, "
+                "assignment='{assignment}')").format(
+                    cls=type(self).__name__, width=self.width,
+                    assignment=self.assignment)
+
+    def plot(self, ax=None):
+        """Plot the density.
+
+        Args:
+            ax (:class:`matplotlib.axes.Axes`, optional): Axis to plot on. If
+                :code:`None`, make a new figure and axis.
+                (Default value = :code:`None`)
+
+        Returns:
+            (:class:`matplotlib.axes.Axes`): Axis with the plot.
+        """
+        import freud.plot
+        if not self.box.is2D:
+            return None
+        return freud.plot.density_plot(self.density, self.box, ax=ax)
+
+    def _repr_png_(self):
+        try:
+            import freud.plot
+            return freud.plot._ax_to_bytes(self.plot())
+        except (AttributeError, ImportError):
+            return None
+
+
 cdef class LocalDensity(_PairCompute):
     R"""Computes the local density around a particle.
 
@@ -459,23 +723,39 @@ cdef class LocalDensity(_PairCompute):
 
     .. image:: images/density.png
 
+    The density can be computed for several radii at once by passing a
+    sequence of values as :code:`r_max`. The neighbors of each query point are
+    then found once, out to the largest radius, and the outputs have one
+    column per radius, which is much faster than computing each radius
+    separately.
+
     Args:
-        r_max (float):
-            Maximum distance over which to calculate the density.
+        r_max (float or sequence of float):
+            Maximum distance over which to calculate the density, or a
+            sequence of such distances.
         diameter (float):
             Diameter of particle circumsphere.
     """
     cdef freud._density.LocalDensity * thisptr
 
-    def __cinit__(self, float r_max, float diameter):
-        self.thisptr = new freud._density.LocalDensity(r_max, diameter)
+    def __cinit__(self, r_max, float diameter):
+        cdef vector[float] r_maxs
+        if isinstance(r_max, (Sequence, np.ndarray)):
+            r_maxs = np.asarray(r_max, dtype=np.float32).ravel()
+            self.thisptr = new freud._density.LocalDensity(r_maxs, diameter)
+        else:
+            self.thisptr = new freud._density.LocalDensity(r_max, diameter)
 
     def __dealloc__(self):
         del self.thisptr
 
     @property
     def r_max(self):
-        """float: Maximum distance over which to calculate the density."""
+        """float or (:math:`N_{radii}`) :class:`numpy.ndarray`: Maximum
+        distance over which to calculate the density, or the distances if
+        several were given."""
+        if self.thisptr.hasMultipleRadii():
+            return np.array(self.thisptr.getRMaxs(), dtype=np.float32)
         return self.thisptr.getRMax()
 
     @property
@@ -534,22 +814,25 @@ cdef class LocalDensity(_PairCompute):
     @property
     def default_query_args(self):
         """The default query arguments are
-        :code:`{'mode': 'ball', 'r_max': self.r_max + 0.5*self.diameter}`."""
+        :code:`{'mode': 'ball', 'r_max': self.r_max + 0.5*self.diameter}`,
+        using the largest :code:`r_max` if there are several."""
         return dict(mode="ball",
-                    r_max=self.r_max + 0.5*self.diameter)
+                    r_max=self.thisptr.getRMax() + 0.5*self.diameter)
 
     @_Compute._computed_property
     def density(self):
-        """(:math:`N_{points}`) :class:`numpy.ndarray`: Density of points per
-        query point."""
+        """(:math:`N_{points}`) or (:math:`N_{points}`, :math:`N_{radii}`) :class:`numpy.ndarray`:
+        Density of points per query point, with one column per radius if
+        several were given."""  # noqa: E501
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getDensity(),
             freud.util.arr_type_t.FLOAT)
 
     @_Compute._computed_property
     def num_neighbors(self):
-        """(:math:`N_{points}`) :class:`numpy.ndarray`: Number of neighbor
-        points for each query point."""
+        """(:math:`N_{points}`) or (:math:`N_{points}`, :math:`N_{radii}`) :class:`numpy.ndarray`:
+        Number of neighbor points for each query point, with one column per
+        radius if several were given."""  # noqa: E501
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getNumNeighbors(),
             freud.util.arr_type_t.FLOAT)
@@ -557,7 +840,8 @@ cdef class LocalDensity(_PairCompute):
     def __repr__(self):
         return ("freud.density.{cls}(r_max={r_max}, "
                 "diameter={diameter})").format(cls=type(self).__name__,
-                                               r_max=self.r_max,
+                                               r_max=np.array(
+                                                   self.r_max).tolist(),
                                                diameter=self.diameter)
 
 
@@ -604,15 +888,23 @@ cdef class RDF(_SpatialHistogram1D):
             arguments are provided to :meth:`~.compute`, specifically if
             :code:`exclude_ii` is set to :code:`False`. This normalization is
             not meaningful in such cases and will simply convolute the data.
+        double_buffered (bool, optional):
+            Alternate :attr:`rdf`, :attr:`n_r` and :attr:`bin_counts`
+            between two retained buffers, so that analyzing a trajectory
+            frame by frame does not allocate new histograms while the
+            previous frame's arrays are still held.
+            Each compute overwrites the arrays of the compute before the
+            previous one (Default value = :code:`False`).
 
     """
     cdef freud._density.RDF * thisptr
 
     def __cinit__(self, unsigned int bins, float r_max, float r_min=0,
-                  normalize=False):
+                  normalize=False, double_buffered=False):
         if type(self) == RDF:
             self.thisptr = self.histptr = new freud._density.RDF(
                 bins, r_max, r_min, normalize)
+            self.thisptr.setDoubleBuffered(double_buffered)
 
             # r_max is left as an attribute rather than a property for now
             # since that change needs to happen at the _SpatialHistogram level
@@ -684,6 +976,16 @@ cdef class RDF(_SpatialHistogram1D):
             &self.thisptr.getNr(),
             freud.util.arr_type_t.FLOAT)
 
+    @property
+    def double_buffered(self):
+        """bool: Whether the histograms are double buffered. Can be changed
+        at any time."""
+        return self.thisptr.isDoubleBuffered()
+
+    @double_buffered.setter
+    def double_buffered(self, value):
+        self.thisptr.setDoubleBuffered(value)
+
     def __repr__(self):
         return ("freud.density.{cls}(bins={bins}, r_max={r_max}, "
                 "r_min={r_min})").format(cls=type(self).__name__,
@@ -715,3 +1017,212 @@ cdef class RDF(_SpatialHistogram1D):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class PartialRDF(_SpatialHistogram):
+    R"""Computes the partial RDFs :math:`g_{ab} \left( r \right)` of all
+    pairs of types in a single pass.
+
+    Every bond found from a query point of type :math:`a` to a point of type
+    :math:`b` is binned by its length into the partial RDF of the pair
+    :math:`(a, b)`, which is normalized by the number of query points of type
+    :math:`a` and the number density of the points of type :math:`b`:
+
+    .. math::
+
+        g_{ab}(r) = \frac{V}{N_a N_b} \sum_{i \in a} \sum_{j \in b}
+        \langle \delta(r - r_{ij}) \rangle
+
+    This is equivalent to computing an :class:`~.RDF` for the points of each
+    pair of types, but all pairs are found with one neighbor query. When
+    accumulating over several frames, the normalization is summed over the
+    frames, so the number of points of each type and the box may change
+    between frames.
+
+    .. note::
+        **2D:** :class:`freud.density.PartialRDF` properly handles 2D boxes.
+        The points must be passed in as :code:`[x, y, 0]`.
+
+    Args:
+        num_types (unsigned int):
+            The number of types. All types must be integers in
+            :code:`[0, num_types)`.
+        bins (unsigned int):
+            The number of bins in the RDFs.
+        r_max (float):
+            Maximum interparticle distance to include in the calculation.
+        r_min (float, optional):
+            Minimum interparticle distance to include in the calculation
+            (Default value = :code:`0`).
+        normalize (bool, optional):
+            Exclude the query point itself from the number density of points
+            of its own type, i.e. use :math:`N_b - 1` instead of :math:`N_b`
+            for :math:`a = b`, as in :class:`~.RDF`. It should only be used if
+            the query points are the system's points and :code:`exclude_ii` is
+            not set to :code:`False` (Default value = :code:`False`).
+    """
+    cdef freud._density.PartialRDF * thisptr
+
+    def __cinit__(self, unsigned int num_types, unsigned int bins,
+                  float r_max, float r_min=0, normalize=False):
+        if type(self) == PartialRDF:
+            self.thisptr = self.histptr = new freud._density.PartialRDF(
+                num_types, bins, r_max, r_min, normalize)
+            self.r_max = r_max
+
+    def __dealloc__(self):
+        if type(self) == PartialRDF:
+            del self.thisptr
+
+    def compute(self, system, types, query_points=None, query_types=None,
+                neighbors=None, reset=True):
+        R"""Calculates the partial RDFs and adds to the current histograms.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            types ((:math:`N_{points}`,) :class:`numpy.ndarray`):
+                The type of each point of the system.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to calculate the RDFs. Uses the system's
+                points if :code:`None` (Default value = :code:`None`).
+            query_types ((:math:`N_{query\_points}`,) :class:`numpy.ndarray`, optional):
+                The type of each query point. Must be provided with
+                :code:`query_points`, and uses :code:`types` if
+                :code:`query_points` is :code:`None` (Default value =
+                :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if query_types is None:
+            if query_points is not None:
+                raise ValueError(
+                    "query_types must be provided with query_points.")
+            query_types = types
+
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        cdef const unsigned int[::1] l_types = freud.util._convert_array(
+            types, shape=(nq.points.shape[0], ), dtype=np.uint32)
+        cdef const unsigned int[::1] l_query_types = \
+            freud.util._convert_array(
+                query_types, shape=(num_query_points, ), dtype=np.uint32)
+
+        self.thisptr.accumulate(
+            nq.get_ptr(),
+            <vec3[float]*> &l_query_points[0, 0],
+            num_query_points,
+            &l_types[0], &l_query_types[0],
+            nlist.get_ptr(),
+            dereference(qargs.thisptr))
+        return self
+
+    @_Compute._computed_property
+    def rdf(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`) \
+        :class:`numpy.ndarray`: The partial RDFs, where :code:`rdf[a, b]` is
+        the RDF of points of type :code:`b` around query points of type
+        :code:`a`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRDF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def n_r(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`) \
+        :class:`numpy.ndarray`: Cumulative bin counts. More precisely,
+        :code:`n_r[a, b, i]` is the average number of points of type :code:`b`
+        contained within a ball of radius :code:`bin_edges[i+1]` centered at a
+        query point of type :code:`a`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getNr(),
+            freud.util.arr_type_t.FLOAT)
+
+    @property
+    def num_types(self):
+        """unsigned int: The number of types."""
+        return self.thisptr.getNumTypes()
+
+    @property
+    def bin_centers(self):
+        """:math:`(N_{bins}, )` :class:`numpy.ndarray`: The centers of each
+        distance bin."""
+        vec = self.histptr.getBinCenters()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bin_edges(self):
+        """:math:`(N_{bins}+1, )` :class:`numpy.ndarray`: The edges of each
+        distance bin."""
+        vec = self.histptr.getBinEdges()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bounds(self):
+        """tuple: A tuple indicating upper and lower bounds of the
+        distances."""
+        vec = self.histptr.getBounds()
+        return vec[2]
+
+    @property
+    def nbins(self):
+        """int: The number of distance bins."""
+        return self.histptr.getAxisSizes()[2]
+
+    def __repr__(self):
+        return ("freud.density.{cls}(num_types={num_types}, bins={bins}, "
+                "r_max={r_max}, r_min={r_min})").format(
+                    cls=type(self).__name__, num_types=self.num_types,
+                    bins=self.nbins, r_max=self.bounds[1],
+                    r_min=self.bounds[0])
+
+    def plot(self, ax=None):
+        """Plot the partial radial distribution functions of all unordered
+        pairs of types.
+
+        Args:
+            ax (:class:`matplotlib.axes.Axes`, optional): Axis to plot on. If
+                :code:`None`, make a new figure and axis.
+                (Default value = :code:`None`)
+
+        Returns:
+            (:class:`matplotlib.axes.Axes`): Axis with the plot.
+        """
+        import freud.plot
+        pairs = [(a, b) for a in range(self.num_types)
+                 for b in range(a, self.num_types)]
+        rdf = self.rdf
+        ax = freud.plot.line_plot(self.bin_centers,
+                                  np.transpose([rdf[a, b] for a, b in pairs]),
+                                  title="Partial RDFs",
+                                  xlabel=r"$r$",
+                                  ylabel=r"$g_{ab}(r)$",
+                                  ax=ax)
+        ax.legend(["{}-{}".format(a, b) for a, b in pairs])
+        return ax
+
+    def _repr_png_(self):
+        try:
+            import freud.plot
+            return freud.plot._ax_to_bytes(self.plot())
+        except (AttributeError, ImportError):
+            return None
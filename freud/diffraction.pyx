@@ -3,7 +3,8 @@
 
 R"""
 The :class:`freud.diffraction` module provides functions for computing the
-diffraction pattern of particles in systems with long range order.
+diffraction pattern of particles in systems with long range order, and their
+static structure factor.
 
 .. rubric:: Stability
 
@@ -15,11 +16,14 @@ finalized in a future release.
 import freud.locality
 import logging
 import numpy as np
-import scipy.ndimage
 import rowan
 
+from cython.operator cimport dereference
 from libcpp cimport bool as cbool
-from freud.util cimport _Compute
+from freud.locality cimport _SpatialHistogram1D
+from freud.util cimport _Compute, quat, vec3
+cimport freud._diffraction
+cimport freud.locality
 cimport freud.util
 cimport numpy as np
 
@@ -44,6 +48,13 @@ cdef class DiffractionPattern(_Compute):
     as a multiplication in Fourier space. The computed diffraction pattern
     can be accessed as a square array of shape ``(output_size, output_size)``.
 
+    The pipeline runs in parallel in C++: the points are projected and
+    binned in parallel, the grid is transformed with a multithreaded FFT, the
+    Gaussian is applied analytically in Fourier space, and the image is
+    resampled in parallel. Several view orientations can be passed to
+    :meth:`compute` at once, in which case their diffraction patterns are
+    averaged, e.g. to compute powder averages.
+
     This method is based on the implementations in the open-source
     `GIXStapose application <https://github.com/cmelab/GIXStapose>`_ and its
     predecessor, diffractometer :cite:`Jankowski2017`.
@@ -55,22 +66,21 @@ cdef class DiffractionPattern(_Compute):
             Resolution of the output diffraction image, uses ``grid_size`` if
             not provided or ``None`` (Default value = :code:`None`).
     """
-    cdef int _grid_size
-    cdef int _output_size
+    cdef freud._diffraction.DiffractionPattern * thisptr
     cdef double[:] _k_values_orig
     cdef double[:, :, :] _k_vectors_orig
     cdef double[:] _k_values
     cdef double[:, :, :] _k_vectors
-    cdef double[:, :] _diffraction
     cdef double _box_matrix_scale_factor
     cdef double[:] _view_orientation
     cdef cbool _k_values_cached
     cdef cbool _k_vectors_cached
 
-    def __init__(self, grid_size=512, output_size=None):
-        self._grid_size = int(grid_size)
-        self._output_size = int(grid_size) if output_size is None \
-            else int(output_size)
+    def __cinit__(self, grid_size=512, output_size=None):
+        grid_size = int(grid_size)
+        output_size = grid_size if output_size is None else int(output_size)
+        self.thisptr = new freud._diffraction.DiffractionPattern(
+            grid_size, output_size)
 
         # Cache these because they are system-independent.
         self._k_values_orig = np.empty(self.output_size)
@@ -80,108 +90,9 @@ cdef class DiffractionPattern(_Compute):
         # Store these computed arrays which are exposed as properties.
         self._k_values = np.empty_like(self._k_values_orig)
         self._k_vectors = np.empty_like(self._k_vectors_orig)
-        self._diffraction = np.empty((self.output_size, self.output_size))
-
-    def _calc_proj(self, view_orientation, box):
-        """Calculate the inverse shear matrix from finding the projected box
-        vectors whose area of parallogram is the largest.
-
-        Args:
-            view_orientation ((:math:`4`) :class:`numpy.ndarray`):
-                View orientation as a quaternion.
-            box (:class:`~.box.Box`):
-                Simulation box.
-
-        Returns:
-            (2, 2) :class:`numpy.ndarray`:
-                Inverse shear matrix.
-        """
-        # Rotate the box matrix by the view orientation.
-        box_matrix = rowan.rotate(view_orientation, box.to_matrix())
-
-        # Compute normals for each box face.
-        # The area of the face is the length of the vector.
-        box_face_normals = np.cross(
-            np.roll(box_matrix, 1, axis=-1),
-            np.roll(box_matrix, -1, axis=-1),
-            axis=0)
-
-        # Compute view axis projections.
-        projections = np.abs(box_face_normals.T @ np.array([0., 0., 1.]))
-
-        # Determine the largest projection area along the view axis and use
-        # that face for the projection into 2D.
-        best_projection_axis = np.argmax(projections)
-        secondary_axes = np.array([
-            best_projection_axis + 1, best_projection_axis + 2]) % 3
 
-        # Figure out appropriate shear matrix
-        shear = box_matrix[np.ix_([0, 1], secondary_axes)]
-
-        # Return the inverse shear matrix
-        inv_shear = np.linalg.inv(shear)
-        return inv_shear
-
-    def _transform(self, img, box, inv_shear, zoom):
-        """Zoom, shear, and scale diffraction intensities.
-
-        Args:
-            img ((``grid_size//zoom, grid_size//zoom``) :class:`numpy.ndarray`):
-                Array of diffraction intensities.
-            box (:class:`~.box.Box`):
-                Simulation box.
-            inv_shear ((2, 2) :class:`numpy.ndarray`):
-                Inverse shear matrix.
-            zoom (float):
-                Scaling factor for incident wavevectors.
-
-        Returns:
-            (``output_size, output_size``) :class:`numpy.ndarray`:
-                Transformed array of diffraction intensities.
-        """  # noqa: E501
-
-        # The adjustments to roll and roll_shift ensure that the peak
-        # corresponding to k=0 is located at exactly
-        # (output_size//2, output_size//2), regardless of whether the grid_size
-        # and output_size are odd or even.
-
-        roll = img.shape[0] / 2
-        if img.shape[0] % 2 == 1:
-            roll -= 0.5
-
-        roll_shift = self.output_size / zoom / 2
-        if self.output_size % 2 == 1:
-            roll_shift -= 0.5 / zoom
-
-        box_matrix = box.to_matrix()
-        ss = np.max(box_matrix) * inv_shear
-
-        shift_matrix = np.array(
-            [[1, 0, -roll],
-             [0, 1, -roll],
-             [0, 0, 1]])
-
-        # Translation for [roll_shift, roll_shift]
-        # Then shift using ss
-        shear_matrix = np.array(
-            [[ss[1, 0], ss[0, 0], roll_shift],
-             [ss[1, 1], ss[0, 1], roll_shift],
-             [0, 0, 1]])
-
-        zoom_matrix = np.diag((zoom, zoom, 1))
-
-        # This matrix uses homogeneous coordinates. It is a 3x3 matrix that
-        # transforms 2D points and adds an offset.
-        inverse_transform = np.linalg.inv(
-            zoom_matrix @ shear_matrix @ shift_matrix)
-
-        img = scipy.ndimage.affine_transform(
-            input=img,
-            matrix=inverse_transform,
-            output_shape=(self.output_size, self.output_size),
-            order=1,
-            mode="constant")
-        return img
+    def __dealloc__(self):
+        del self.thisptr
 
     def compute(self, system, view_orientation=None, zoom=4, peak_width=1):
         R"""Computes diffraction pattern.
@@ -190,53 +101,36 @@ cdef class DiffractionPattern(_Compute):
             system:
                 Any object that is a valid argument to
                 :class:`freud.locality.NeighborQuery.from_system`.
-            view_orientation ((:math:`4`) :class:`numpy.ndarray`, optional):
-                View orientation. Uses :math:`(1, 0, 0, 0)` if not provided
-                or :code:`None` (Default value = :code:`None`).
+            view_orientation ((:math:`4`) or (:math:`N_{views}`, :math:`4`) :class:`numpy.ndarray`, optional):
+                View orientation, or several view orientations whose
+                diffraction patterns are averaged. Uses :math:`(1, 0, 0, 0)`
+                if not provided or :code:`None` (Default value =
+                :code:`None`).
             zoom (float):
                 Scaling factor for incident wavevectors (Default value = 4).
             peak_width (float):
                 Width of Gaussian convolved with points, in system length units
                 (Default value = 1).
-        """
-        system = freud.locality.NeighborQuery.from_system(system)
+        """  # noqa E501
+        cdef freud.locality.NeighborQuery nq = \
+            freud.locality.NeighborQuery.from_system(system)
 
         if view_orientation is None:
             view_orientation = np.array([1., 0., 0., 0.])
+        view_orientation = np.asarray(view_orientation)
+        if view_orientation.ndim == 1:
+            view_orientation = view_orientation[np.newaxis]
         view_orientation = freud.util._convert_array(
-            view_orientation, (4,), np.double)
-
-        grid_size = int(self.grid_size / zoom)
-
-        # Compute the box projection matrix
-        inv_shear = self._calc_proj(view_orientation, system.box)
+            view_orientation, (None, 4))
+        if len(view_orientation) == 0:
+            raise ValueError(
+                "DiffractionPattern requires at least one view orientation.")
 
-        # Rotate points by the view quaternion and shear by the box projection
-        xy = rowan.rotate(view_orientation, system.points)[:, 0:2]
-        xy = xy @ inv_shear.T
-
-        # Map positions to [0, 1] and compute a histogram "image"
-        # Use grid_size+1 bin edges so that there are grid_size bins
-        xy += 0.5
-        xy %= 1
-        im, _, _ = np.histogram2d(
-            xy[:, 0], xy[:, 1], bins=np.linspace(0, 1, grid_size+1))
-
-        # Compute FFT and convolve with Gaussian
-        cdef double complex[:, :] diffraction_fft
-        diffraction_fft = np.fft.fft2(im)
-        diffraction_fft = scipy.ndimage.fourier.fourier_gaussian(
-            diffraction_fft, peak_width / zoom)
-        diffraction_fft = np.fft.fftshift(diffraction_fft)
-
-        # Compute the squared modulus of the FFT, which is S(k)
-        self._diffraction = np.real(
-            diffraction_fft * np.conjugate(diffraction_fft))
-
-        # Transform the image (scale, shear, zoom) and normalize S(k) by N^2
-        N = len(system.points)
-        self._diffraction = self._transform(
-            self._diffraction, system.box, inv_shear, zoom) / (N*N)
+        cdef const float[:, ::1] l_view_orientations = view_orientation
+        cdef unsigned int n_views = l_view_orientations.shape[0]
+        self.thisptr.compute(
+            nq.get_ptr(), <quat[float]*> &l_view_orientations[0, 0],
+            n_views, zoom, peak_width)
 
         # Compute a cached array of k-vectors that can be rotated and scaled
         if not self._called_compute:
@@ -252,8 +146,9 @@ cdef class DiffractionPattern(_Compute):
 
         # Cache the view orientation and box matrix scale factor for
         # lazy evaluation of k-values and k-vectors
-        self._box_matrix_scale_factor = np.max(system.box.to_matrix())
-        self._view_orientation = view_orientation
+        self._box_matrix_scale_factor = np.max(nq.box.to_matrix())
+        self._view_orientation = rowan.normalize(
+            view_orientation[0].astype(np.double))
         self._k_values_cached = False
         self._k_vectors_cached = False
 
@@ -262,12 +157,12 @@ cdef class DiffractionPattern(_Compute):
     @property
     def grid_size(self):
         """int: Resolution of the diffraction grid."""
-        return self._grid_size
+        return self.thisptr.getGridSize()
 
     @property
     def output_size(self):
         """int: Resolution of the output diffraction image."""
-        return self._output_size
+        return self.thisptr.getOutputSize()
 
     @_Compute._computed_property
     def diffraction(self):
@@ -275,7 +170,9 @@ cdef class DiffractionPattern(_Compute):
         (``output_size``, ``output_size``) :class:`numpy.ndarray`:
             diffraction pattern.
         """
-        return np.asarray(self._diffraction)
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getDiffraction(),
+            freud.util.arr_type_t.DOUBLE)
 
     @_Compute._computed_property
     def k_values(self):
@@ -290,7 +187,7 @@ cdef class DiffractionPattern(_Compute):
     def k_vectors(self):
         """
         (``output_size``, ``output_size``, 3) :class:`numpy.ndarray`:
-            k-vectors.
+            k-vectors, rotated by the first view orientation.
         """
         if not self._k_vectors_cached:
             self._k_vectors = rowan.rotate(
@@ -355,3 +252,218 @@ cdef class DiffractionPattern(_Compute):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class StaticStructureFactor(_SpatialHistogram1D):
+    R"""Computes the static structure factor :math:`S(k)` as a function of
+    the magnitude of the wavevector :math:`k`.
+
+    Two methods are available. The :code:`'debye'` method histograms the
+    distances of all pairs of points closer than :code:`r_max` in parallel
+    and evaluates the Debye formula at the centers of the :math:`k` bins:
+
+    .. math::
+
+        S(k) = 1 + \frac{1}{N} \sum_{i \neq j, r_{ij} < r_{max}}
+        \frac{\sin(k r_{ij})}{k r_{ij}} - \rho V(k)
+
+    where :math:`V(k) = 4 \pi (\sin(k r_{max}) - k r_{max}
+    \cos(k r_{max})) / k^3` removes the contribution of a uniform density
+    :math:`\rho` beyond :code:`r_max` in boxes that are periodic in all
+    dimensions. The distances are binned finely enough that the result
+    matches the sum over the pairs to about a part in :math:`10^4`. The
+    :code:`'debye'` method requires a 3D box, and the self term :math:`1`
+    assumes that the query points are the system's points.
+
+    The :code:`'direct'` method evaluates
+
+    .. math::
+
+        S(\vec{k}) = \frac{1}{N} \left| \sum_{j=1}^{N}
+        e^{i \vec{k} \cdot \vec{r}_j} \right|^2
+
+    for the wavevectors :math:`\vec{k}` allowed by the periodic box and
+    averages it over the wavevectors in each bin, so it is exact for periodic
+    systems but only resolves :math:`k` down to :math:`2 \pi / L`. Bins
+    without any allowed wavevectors are NaN. If query points are provided,
+    :math:`\frac{1}{N_{query}} \operatorname{Re}\left(\sum_{p}
+    e^{-i \vec{k} \cdot \vec{r}_p} \sum_{q}
+    e^{i \vec{k} \cdot \vec{r}_q}\right)` is computed instead. The
+    phases are evaluated with vectorized sines and cosines, in parallel over
+    the wavevectors.
+
+    Both methods accumulate over frames when :code:`reset=False`, and the box
+    and number of points may change between frames.
+
+    .. note::
+        **2D:** The :code:`'direct'` method properly handles 2D boxes. The
+        points must be passed in as :code:`[x, y, 0]`.
+
+    Args:
+        bins (unsigned int):
+            Number of bins in :math:`k`.
+        k_max (float):
+            Maximum :math:`k` value to include in the calculation.
+        k_min (float, optional):
+            Minimum :math:`k` value to include in the calculation (Default
+            value = :code:`0`).
+        method (str, optional):
+            Either :code:`'debye'` or :code:`'direct'` (Default value =
+            :code:`'debye'`).
+        r_max (float, optional):
+            Maximum distance of the pairs of the :code:`'debye'` method, which
+            requires it. It is ignored by the :code:`'direct'` method (Default
+            value = :code:`None`).
+        max_k_points (unsigned int, optional):
+            Approximate maximum number of wavevectors of the :code:`'direct'`
+            method, which are distributed evenly among the bins, or :code:`0`
+            to use all allowed wavevectors (Default value = :code:`10000`).
+    """
+    cdef freud._diffraction.StaticStructureFactor * thisptr
+
+    known_methods = {
+        'debye': freud._diffraction.structure_factor_debye,
+        'direct': freud._diffraction.structure_factor_direct}
+
+    def __cinit__(self, unsigned int bins, float k_max, float k_min=0,
+                  str method='debye', r_max=None,
+                  unsigned int max_k_points=10000):
+        cdef freud._diffraction.StaticStructureFactorMethod l_method
+        try:
+            l_method = self.known_methods[method]
+        except KeyError:
+            raise ValueError(
+                'Unknown StaticStructureFactor method: {}'.format(method))
+        if r_max is None:
+            r_max = 0
+        self.thisptr = self.histptr = \
+            new freud._diffraction.StaticStructureFactor(
+                bins, k_max, k_min, l_method, r_max, max_k_points)
+        self.r_max = r_max
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, query_points=None, neighbors=None, reset=True):
+        R"""Calculates the static structure factor and adds it to the
+        current one.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to calculate the structure factor. Uses the
+                system's points if :code:`None` (Default value =
+                :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None). Only the :code:`'debye'` method uses
+                neighbors.
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if self.method == 'direct':
+            if neighbors is not None:
+                raise ValueError(
+                    "The direct method of StaticStructureFactor does not "
+                    "use neighbors.")
+            # A null neighbor list skips the neighbor query.
+            neighbors = freud.locality.NeighborList(_null=True)
+
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        self.thisptr.accumulate(
+            nq.get_ptr(),
+            <vec3[float]*> &l_query_points[0, 0],
+            num_query_points, nlist.get_ptr(),
+            dereference(qargs.thisptr))
+        return self
+
+    @_Compute._computed_property
+    def S_k(self):
+        """(:math:`N_{bins}`) :class:`numpy.ndarray`: The static structure
+        factor at the centers of the :math:`k` bins."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getStructureFactor(),
+            freud.util.arr_type_t.FLOAT)
+
+    @property
+    def k_values(self):
+        """(:math:`N_{bins}`) :class:`numpy.ndarray`: The centers of the
+        :math:`k` bins."""
+        return self.bin_centers
+
+    @_Compute._computed_property
+    def bin_counts(self):
+        """(:math:`N_{bins}`) :class:`numpy.ndarray`: The number of
+        wavevectors averaged in each bin by the :code:`'direct'` method,
+        summed over frames (zero for the :code:`'debye'` method)."""
+        return freud.util.make_managed_numpy_array(
+            &self.histptr.getBinCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @property
+    def method(self):
+        """str: Method used to compute the structure factor."""
+        method = self.thisptr.getMethod()
+        for key, value in self.known_methods.items():
+            if value == method:
+                return key
+
+    @property
+    def max_k_points(self):
+        """unsigned int: Approximate maximum number of wavevectors of the
+        :code:`'direct'` method."""
+        return self.thisptr.getMaxKPoints()
+
+    def __repr__(self):
+        r_max = self.thisptr.getRMax() if self.method == 'debye' else None
+        return ("freud.diffraction.{cls}(bins={bins}, k_max={k_max}, "
+                "k_min={k_min}, method='{method}', r_max={r_max}, "
+                "max_k_points={max_k_points})").format(
+                    cls=type(self).__name__, bins=self.nbins,
+                    k_max=self.bounds[1], k_min=self.bounds[0],
+                    method=self.method, r_max=r_max,
+                    max_k_points=self.max_k_points)
+
+    def plot(self, ax=None):
+        """Plot static structure factor.
+
+        Args:
+            ax (:class:`matplotlib.axes.Axes`, optional): Axis to plot on. If
+                :code:`None`, make a new figure and axis.
+                (Default value = :code:`None`)
+
+        Returns:
+            (:class:`matplotlib.axes.Axes`): Axis with the plot.
+        """
+        import freud.plot
+        return freud.plot.line_plot(self.k_values, self.S_k,
+                                    title="Static Structure Factor",
+                                    xlabel=r"$k$",
+                                    ylabel=r"$S(k)$",
+                                    ax=ax)
+
+    def _repr_png_(self):
+        try:
+            import freud.plot
+            return freud.plot._ax_to_bytes(self.plot())
+        except (AttributeError, ImportError):
+            return None
@@ -55,6 +55,11 @@ cdef class _RawPoints(NeighborQuery):
 
 cdef class _QueryArgs:
     cdef freud._locality.QueryArgs * thisptr
+    # References to the arrays of per-type-pair cutoffs and types, which are
+    # passed to C++ by pointer and must outlive the C++ query arguments.
+    cdef object _r_max_pairs
+    cdef object _point_types
+    cdef object _query_point_types
 
 cdef class _PairCompute(_Compute):
     pass
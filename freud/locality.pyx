@@ -37,7 +37,8 @@ cdef class _QueryArgs:
 
     def __cinit__(self, mode=None, r_min=None, r_max=None, r_guess=None,
                   num_neighbors=None, exclude_ii=None,
-                  scale=None, **kwargs):
+                  scale=None, r_shells=None, r_max_pairs=None,
+                  point_types=None, query_point_types=None, **kwargs):
         if type(self) == _QueryArgs:
             self.thisptr = new freud._locality.QueryArgs()
             self.mode = mode
@@ -53,6 +54,14 @@ cdef class _QueryArgs:
                 self.exclude_ii = exclude_ii
             if scale is not None:
                 self.scale = scale
+            if r_shells is not None:
+                self.r_shells = r_shells
+            if r_max_pairs is not None:
+                self.r_max_pairs = r_max_pairs
+            if point_types is not None:
+                self.point_types = point_types
+            if query_point_types is not None:
+                self.query_point_types = query_point_types
             if len(kwargs):
                 err_str = ", ".join(
                     "{} = {}".format(k, v) for k, v in kwargs.items())
@@ -149,6 +158,69 @@ cdef class _QueryArgs:
     def scale(self, value):
         self.thisptr.scale = value
 
+    @property
+    def r_shells(self):
+        return list(self.thisptr.r_shells)
+
+    @r_shells.setter
+    def r_shells(self, value):
+        self.thisptr.r_shells = [float(r) for r in value]
+
+    @property
+    def r_max_pairs(self):
+        return self._r_max_pairs
+
+    @r_max_pairs.setter
+    def r_max_pairs(self, value):
+        value = freud.util._convert_array(value, shape=(None, None))
+        if value.shape[0] != value.shape[1] or value.shape[0] == 0:
+            raise ValueError("r_max_pairs must be a nonempty square matrix.")
+        cdef const float[:, ::1] l_r_max_pairs = value
+        self._r_max_pairs = value
+        self.thisptr.r_max_pairs = &l_r_max_pairs[0, 0]
+        self.thisptr.num_types = value.shape[0]
+
+    @property
+    def point_types(self):
+        return self._point_types
+
+    @point_types.setter
+    def point_types(self, value):
+        value = freud.util._convert_array(value, shape=(None,),
+                                          dtype=np.uint32)
+        cdef const unsigned int[::1] l_point_types = value
+        self._point_types = value
+        self.thisptr.point_types = &l_point_types[0] if len(value) else NULL
+
+    @property
+    def query_point_types(self):
+        return self._query_point_types
+
+    @query_point_types.setter
+    def query_point_types(self, value):
+        value = freud.util._convert_array(value, shape=(None,),
+                                          dtype=np.uint32)
+        cdef const unsigned int[::1] l_query_point_types = value
+        self._query_point_types = value
+        self.thisptr.query_point_types = \
+            &l_query_point_types[0] if len(value) else NULL
+
+    def _validate_types(self, num_points, num_query_points):
+        """Check the lengths of the type arrays used with per-type-pair
+        cutoffs. If no query point types were provided, the point types are
+        used for the query points."""
+        if self._r_max_pairs is None:
+            return
+        if self._point_types is None:
+            raise ValueError("point_types must be provided with r_max_pairs.")
+        if self._query_point_types is None:
+            self.query_point_types = self._point_types
+        if len(self._point_types) != num_points:
+            raise ValueError("point_types must have one entry per point.")
+        if len(self._query_point_types) != num_query_points:
+            raise ValueError(
+                "query_point_types must have one entry per query point.")
+
     def __repr__(self):
         return ("freud.locality.{cls}(mode={mode}, r_max={r_max}, "
                 "num_neighbors={num_neighbors}, exclude_ii={exclude_ii}, "
@@ -227,6 +299,45 @@ cdef class NeighborQueryResult:
 
         return nl
 
+    def toNeighborLists(self, sort_by_distance=False):
+        """Convert query result to one :class:`~NeighborList` per shell.
+
+        The neighbors are found in a single traversal up to the largest
+        cutoff in the :code:`r_shells` query argument. The lists are nested:
+        the list for shell :math:`k` contains all bonds with distances less
+        than :code:`r_shells[k]`. If :code:`r_shells` is not set, a single
+        list containing all neighbors is returned.
+
+        Args:
+            sort_by_distance (bool):
+                If :code:`True`, sort neighboring bonds by distance.
+                If :code:`False`, sort neighboring bonds by point index
+                (Default value = :code:`False`).
+
+        Returns:
+            list[:class:`~NeighborList`]: One :class:`~NeighborList` for each
+            shell cutoff.
+        """
+        cdef const float[:, ::1] l_points = self.points
+        cdef shared_ptr[freud._locality.NeighborQueryIterator] iterator = \
+            self.nq.nqptr.query(
+                <vec3[float]*> &l_points[0, 0],
+                self.points.shape[0],
+                dereference(self.query_args.thisptr))
+
+        cdef vector[freud._locality.NeighborList*] cnlists = dereference(
+            iterator).toNeighborLists(sort_by_distance)
+        cdef NeighborList nl
+        nlists = []
+        for i in range(cnlists.size()):
+            nl = _nlist_from_cnlist(cnlists[i])
+            # Explicitly manage a manually created nlist so that it will be
+            # deleted when the Python object is.
+            nl._managed = True
+            nlists.append(nl)
+
+        return nlists
+
 
 cdef class NeighborQuery:
     R"""Class representing a set of points along with the ability to query for
@@ -398,6 +509,7 @@ cdef class NeighborQuery:
             np.atleast_2d(query_points), shape=(None, 3))
 
         cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
+        args._validate_types(self.points.shape[0], query_points.shape[0])
         return NeighborQueryResult.init(self, query_points, args)
 
     cdef freud._locality.NeighborQuery * get_ptr(self):
@@ -700,6 +812,68 @@ cdef class NeighborList:
         self.thisptr.filter_r(r_max, r_min)
         return self
 
+    def union(self, NeighborList other):
+        R"""Create a NeighborList containing the bonds in either this
+        NeighborList or another.
+
+        Both NeighborLists must be sorted by query point index and then by
+        point index, which is the default ordering of NeighborLists created
+        by queries. Bonds present in both NeighborLists are taken from this
+        object, including their distances and weights.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The NeighborList to combine with this one.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: The union of the bonds.
+        """
+        cdef NeighborList result = _nlist_from_cnlist(
+            self.thisptr.setUnion(dereference(other.thisptr)))
+        result._managed = True
+        return result
+
+    def intersection(self, NeighborList other):
+        R"""Create a NeighborList containing the bonds in both this
+        NeighborList and another.
+
+        Both NeighborLists must be sorted by query point index and then by
+        point index, which is the default ordering of NeighborLists created
+        by queries. The distances and weights are taken from this object.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The NeighborList to intersect with this one.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: The intersection of the
+            bonds.
+        """
+        cdef NeighborList result = _nlist_from_cnlist(
+            self.thisptr.setIntersection(dereference(other.thisptr)))
+        result._managed = True
+        return result
+
+    def difference(self, NeighborList other):
+        R"""Create a NeighborList containing the bonds in this NeighborList
+        that are not in another.
+
+        Both NeighborLists must be sorted by query point index and then by
+        point index, which is the default ordering of NeighborLists created
+        by queries.
+
+        Args:
+            other (:class:`freud.locality.NeighborList`):
+                The NeighborList whose bonds are removed from this one.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: The difference of the bonds.
+        """
+        cdef NeighborList result = _nlist_from_cnlist(
+            self.thisptr.setDifference(dereference(other.thisptr)))
+        result._managed = True
+        return result
+
 
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     """Create a Python NeighborList object that points to an existing C++
@@ -931,6 +1105,7 @@ cdef class _PairCompute(_Compute):
                 query_points, shape=(None, 3))
         cdef const float[:, ::1] l_query_points = query_points
         cdef unsigned int num_query_points = l_query_points.shape[0]
+        qargs._validate_types(nq.points.shape[0], num_query_points)
         return (nq, nlist, qargs, l_query_points, num_query_points)
 
     def _resolve_neighbors(self, neighbors, query_points=None):
@@ -1017,6 +1192,23 @@ cdef class _SpatialHistogram(_PairCompute):
         histogram."""
         return list(self.histptr.getAxisSizes())
 
+    @property
+    def accumulation_strategy(self):
+        """str: How bin counts are accumulated across threads. The default,
+        :code:`'auto'`, keeps a private copy of the bins on each thread unless
+        that exceeds a memory limit, in which case :code:`'cache'` is used.
+        :code:`'dense'`, :code:`'atomic'`, :code:`'cache'`, or
+        :code:`'sparse'` forces that strategy. All strategies give the same
+        results up to floating point rounding. Setting this property resets
+        the accumulated data."""
+        return freud.util._from_accumulation_strategy(
+            self.histptr.getAccumulationStrategy())
+
+    @accumulation_strategy.setter
+    def accumulation_strategy(self, value):
+        self.histptr.setAccumulationStrategy(
+            freud.util._to_accumulation_strategy(value))
+
     def _reset(self):
         # Resets the values of RDF in memory.
         self.histptr.reset()
@@ -288,11 +288,17 @@ cdef class Hexatic(_PairCompute):
             Voronoi neighbor list, this results in the 2D Minkowski Structure
             Metrics :math:`\psi'_k` :cite:`Mickel2013` (Default value =
             :code:`False`).
+        double_buffered (bool, optional):
+            Reuse two buffers for :attr:`particle_order` in turn instead
+            of allocating a new array whenever the previous one is still
+            referenced. Only the two most recent results remain valid
+            (Default value = :code:`False`).
     """  # noqa: E501
     cdef freud._order.Hexatic * thisptr
 
-    def __cinit__(self, k=6, weighted=False):
+    def __cinit__(self, k=6, weighted=False, double_buffered=False):
         self.thisptr = new freud._order.Hexatic(k, weighted)
+        self.thisptr.setDoubleBuffered(double_buffered)
 
     def __dealloc__(self):
         del self.thisptr
@@ -359,6 +365,16 @@ cdef class Hexatic(_PairCompute):
         """bool: Whether neighbor weights were used in the computation."""
         return self.thisptr.isWeighted()
 
+    @property
+    def double_buffered(self):
+        """bool: Whether :attr:`particle_order` is double buffered. Can be
+        changed at any time."""
+        return self.thisptr.isDoubleBuffered()
+
+    @double_buffered.setter
+    def double_buffered(self, value):
+        self.thisptr.setDoubleBuffered(value)
+
     def __repr__(self):
         return "freud.order.{cls}(k={k}, weighted={weighted})".format(
             cls=type(self).__name__, k=self.k, weighted=self.weighted)
@@ -559,13 +575,21 @@ cdef class Steinhardt(_PairCompute):
         wl_normalize (bool, optional):
             Determines whether to normalize the :math:`w_l` version
             of the Steinhardt order parameter (Default value = :code:`False`).
+        double_buffered (bool, optional):
+            Alternate :attr:`ql`, :attr:`particle_order` and the internal
+            per-particle harmonics between two retained buffers. With many
+            particles and large :code:`l`, this saves an allocation and zero
+            fill of the harmonics on every compute, at the cost of the
+            results from two computes ago being overwritten
+            (Default value = :code:`False`).
     """  # noqa: E501
     cdef freud._order.Steinhardt * thisptr
 
     def __cinit__(self, l, average=False, wl=False, weighted=False,
-                  wl_normalize=False):
+                  wl_normalize=False, double_buffered=False):
         self.thisptr = new freud._order.Steinhardt(l, average, wl, weighted,
                                                    wl_normalize)
+        self.thisptr.setDoubleBuffered(double_buffered)
 
     def __dealloc__(self):
         del self.thisptr
@@ -591,6 +615,16 @@ cdef class Steinhardt(_PairCompute):
     def wl_normalize(self):
         return self.thisptr.isWlNormalized()
 
+    @property
+    def double_buffered(self):
+        """bool: Whether the per-particle outputs are double buffered. Can be
+        changed at any time."""
+        return self.thisptr.isDoubleBuffered()
+
+    @double_buffered.setter
+    def double_buffered(self, value):
+        self.thisptr.setDoubleBuffered(value)
+
     @property
     def l(self):  # noqa: E743
         """unsigned int: Spherical harmonic quantum number l."""
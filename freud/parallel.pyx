@@ -5,6 +5,11 @@ R"""
 The :class:`freud.parallel` module controls the parallelization behavior of
 freud, determining how many threads the TBB-enabled parts of freud will use.
 freud uses all available threads for parallelization unless directed otherwise.
+Computations can also be run in isolated thread pools with
+:class:`ExecutionContext`, e.g. to run several analyses concurrently without
+oversubscribing cores.
+It also controls an optional pool that recycles the memory of freud's arrays
+between computations.
 """
 
 cimport freud._parallel
@@ -60,3 +65,133 @@ class NumThreads:
 
     def __exit__(self, *args):
         set_num_threads(self.restore_N)
+
+
+cdef class ExecutionContext:
+    R"""Isolated pool of threads for running computations.
+
+    Computations started from the current thread inside a :code:`with` block
+    using this context run in its own pool of threads, which is limited to
+    :code:`num_threads` threads and optionally pinned to a NUMA node. Unlike
+    :func:`set_num_threads`, which limits all of freud, contexts only affect
+    the computations run inside them, so concurrent analyses (e.g. in
+    different Python threads) can each be given their own share of the cores.
+    Contexts may be nested and reused.
+
+    .. code-block:: python
+
+        context = freud.parallel.ExecutionContext(num_threads=4)
+        with context:
+            rdf.compute(system)
+
+    Args:
+        num_threads (int, optional):
+            Maximum number of threads to use. If :code:`None`, use all
+            available threads (Default value = :code:`None`).
+        numa_node (int, optional):
+            NUMA node to pin the threads to, one of :func:`get_numa_nodes`.
+            If :code:`None`, the threads are not pinned (Default value =
+            :code:`None`).
+    """
+    cdef freud._parallel.ExecutionContext * thisptr
+
+    def __cinit__(self, num_threads=None, numa_node=None):
+        if num_threads is not None and num_threads < 1:
+            raise ValueError("num_threads must be positive.")
+        cdef unsigned int c_num_threads = \
+            0 if num_threads is None else num_threads
+        cdef int c_numa_node = -1 if numa_node is None else numa_node
+        self.thisptr = new freud._parallel.ExecutionContext(
+            c_num_threads, c_numa_node)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def __enter__(self):
+        self.thisptr.activate()
+        return self
+
+    def __exit__(self, *args):
+        self.thisptr.deactivate()
+
+    @property
+    def num_threads(self):
+        """int: Maximum number of threads (:code:`None` if all available
+        threads are used)."""
+        num_threads = self.thisptr.getNumThreads()
+        return None if num_threads == 0 else num_threads
+
+    @property
+    def numa_node(self):
+        """int: NUMA node the threads are pinned to (:code:`None` if not
+        pinned)."""
+        numa_node = self.thisptr.getNumaNode()
+        return None if numa_node < 0 else numa_node
+
+    @property
+    def max_concurrency(self):
+        """int: Number of threads that computations in this context can
+        use."""
+        return self.thisptr.getMaxConcurrency()
+
+    def __repr__(self):
+        return ("freud.parallel.{cls}(num_threads={num_threads}, "
+                "numa_node={numa_node})").format(
+                    cls=type(self).__name__, num_threads=self.num_threads,
+                    numa_node=self.numa_node)
+
+
+def get_numa_nodes():
+    R"""Get the NUMA nodes that an :class:`ExecutionContext` can be pinned to.
+
+    Returns:
+        list[int]: The NUMA nodes, or an empty list if the topology is not
+        known (NUMA support requires oneTBB with hwloc).
+    """
+    return list(freud._parallel.ExecutionContext.getNumaNodes())
+
+
+def set_memory_pool(enabled=True, huge_pages=False, max_cached_bytes=None):
+    R"""Configure the pool recycling the memory of freud's arrays.
+
+    When enabled, the memory of arrays computed by freud is kept in a pool
+    when the arrays are no longer referenced (on the C++ or Python side), and
+    reused by later computations producing arrays of similar sizes. This
+    avoids repeated allocations and page faults when analyzing many frames
+    of a trajectory. Disabling the pool releases all memory kept in it.
+
+    Args:
+        enabled (bool, optional):
+            Whether to recycle memory (Default value = :code:`True`).
+        huge_pages (bool, optional):
+            Whether to request transparent huge pages for arrays of at least
+            2 MiB. Only has an effect on Linux (Default value =
+            :code:`False`).
+        max_cached_bytes (int, optional):
+            Maximum number of bytes kept in the pool. If :code:`None`, the
+            current limit (initially 1 GiB) is kept (Default value =
+            :code:`None`).
+    """
+    if max_cached_bytes is not None:
+        if max_cached_bytes < 0:
+            raise ValueError("max_cached_bytes must be non-negative.")
+        freud._parallel.ArrayPool.setMaxCachedBytes(max_cached_bytes)
+    freud._parallel.ArrayPool.setHugePages(huge_pages)
+    freud._parallel.ArrayPool.setEnabled(enabled)
+
+
+def get_memory_pool():
+    R"""Get the configuration and usage of the pool recycling array memory.
+
+    Returns:
+        dict: The keys :code:`enabled`, :code:`huge_pages`, and
+        :code:`max_cached_bytes` hold the values set with
+        :func:`set_memory_pool`, and :code:`cached_bytes` holds the number of
+        bytes currently kept in the pool.
+    """
+    return {
+        'enabled': freud._parallel.ArrayPool.isEnabled(),
+        'huge_pages': freud._parallel.ArrayPool.getHugePages(),
+        'max_cached_bytes': freud._parallel.ArrayPool.getMaxCachedBytes(),
+        'cached_bytes': freud._parallel.ArrayPool.getCachedBytes(),
+    }
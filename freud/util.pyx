@@ -6,6 +6,7 @@ import freud.box
 
 from functools import wraps
 
+cimport freud._util
 cimport numpy as np
 
 # numpy must be initialized. When using numpy from C or Cython you must
@@ -195,7 +196,7 @@ cdef class _Compute(object):
         return repr(self)
 
 
-def _convert_array(array, shape=None, dtype=np.float32):
+def _convert_array(array, shape=None, dtype=np.float32, copy=False):
     """Function which takes a given array, checks the dimensions and shape,
     and converts to a supplied dtype.
 
@@ -207,12 +208,18 @@ def _convert_array(array, shape=None, dtype=np.float32):
         dtype: :code:`dtype` to convert the array to if :code:`array.dtype`
             is different. If :code:`None`, :code:`dtype` will not be changed
             (Default value = :class:`numpy.float32`).
+        copy (bool): If :code:`True`, the returned array never shares memory
+            with the input, but it is only copied once if a conversion is
+            needed (Default value = :code:`False`).
 
     Returns:
         :class:`numpy.ndarray`: Array.
     """
+    original = array
     array = np.asarray(array)
     return_arr = np.require(array, dtype=dtype, requirements=['C'])
+    if copy and np.may_share_memory(return_arr, original):
+        return_arr = return_arr.copy()
     if shape is not None:
         if array.ndim != len(shape):
             raise ValueError("array.ndim = {}; expected ndim = {}".format(
@@ -252,3 +259,36 @@ def _convert_box(box, dimensions=None):
         raise ValueError("The box must be {}-dimensional.".format(dimensions))
 
     return box
+
+
+_accumulation_strategies = {
+    'auto': freud._util.accumulate_automatic,
+    'dense': freud._util.accumulate_dense,
+    'atomic': freud._util.accumulate_atomic,
+    'cache': freud._util.accumulate_cache,
+    'sparse': freud._util.accumulate_sparse}
+
+
+def _to_accumulation_strategy(strategy):
+    """Convert the name of a bin accumulation strategy to its C++ value.
+
+    Args:
+        strategy (str):
+            One of :code:`'auto'`, :code:`'dense'`, :code:`'atomic'`,
+            :code:`'cache'`, or :code:`'sparse'`.
+
+    Returns:
+        int: The C++ accumulation strategy.
+    """
+    try:
+        return _accumulation_strategies[strategy]
+    except KeyError:
+        raise ValueError(
+            "Unknown accumulation strategy: {}".format(strategy))
+
+
+def _from_accumulation_strategy(strategy):
+    """Convert a C++ bin accumulation strategy to its name."""
+    for key, value in _accumulation_strategies.items():
+        if value == strategy:
+            return key
@@ -214,6 +214,96 @@ class TestBox(unittest.TestCase):
         npt.assert_allclose(
             box.center_of_mass(points, masses), com, atol=1e-6)
 
+    def _serial_centers_of_mass(self, box, points, labels, num_labels,
+                                masses=None):
+        # Reference implementation matching the original serial computation,
+        # which averaged std::polar phases of the fractional coordinates.
+        if masses is None:
+            masses = np.ones(len(points))
+        phases = np.exp(2*np.pi*1j*box.make_fractional(points))
+        centers = np.full((num_labels, 3), np.nan)
+        for label in range(num_labels):
+            mask = labels == label
+            if not np.any(mask):
+                continue
+            angle = np.angle(phases[mask].T @ masses[mask])
+            centers[label] = box.wrap(box.make_absolute(angle / (2*np.pi)))
+        return centers
+
+    def test_centers_of_mass(self):
+        np.random.seed(0)
+        box = freud.box.Box(8, 9, 10, 0.2, 0.1, 0.3)
+        num_labels = 6
+        # Clusters centered on and near the periodic boundaries, with label
+        # 3 left empty.
+        seeds = box.make_absolute([
+            [0.5, 0.5, 0.5], [0.5, 0, 0], [0, -0.5, 0.1],
+            [0.2, 0.3, 0.4], [-0.49, 0.49, -0.5], [0, 0, 0]])
+        labels = np.random.choice([0, 1, 2, 4, 5], size=500).astype(
+            np.uint32)
+        points = seeds[labels] + np.random.normal(scale=0.5, size=(500, 3))
+        points = box.wrap(points.astype(np.float32))
+        masses = np.random.uniform(0.5, 2, size=500).astype(np.float32)
+
+        for point_masses in [None, masses]:
+            centers = box.centers_of_mass(
+                points, labels, num_labels, point_masses)
+            reference = self._serial_centers_of_mass(
+                box, points, labels, num_labels, point_masses)
+            self.assertEqual(centers.shape, (num_labels, 3))
+            self.assertTrue(np.all(np.isnan(centers[3])))
+            occupied = [0, 1, 2, 4, 5]
+            npt.assert_allclose(
+                box.wrap(centers[occupied] - reference[occupied]), 0,
+                atol=1e-4)
+            for label in occupied:
+                mask = labels == label
+                label_masses = (None if point_masses is None
+                                else point_masses[mask])
+                npt.assert_allclose(
+                    box.wrap(centers[label] - box.center_of_mass(
+                        points[mask], label_masses)), 0, atol=1e-4)
+
+    def test_centers_of_mass_empty(self):
+        box = freud.box.Box.cube(5)
+        centers = box.centers_of_mass(np.zeros((0, 3)), [], 3)
+        self.assertEqual(centers.shape, (3, 3))
+        self.assertTrue(np.all(np.isnan(centers)))
+
+        # Trailing labels without any points are NaN.
+        centers = box.centers_of_mass([[2.4, 0, 0], [-2.4, 0, 0]], [1, 1], 4)
+        self.assertTrue(np.all(np.isnan(centers[[0, 2, 3]])))
+        npt.assert_allclose(
+            box.wrap(centers[1] - [2.5, 0, 0]), 0, atol=1e-5)
+
+    def test_centers_of_mass_invalid_labels(self):
+        box = freud.box.Box.cube(5)
+        with self.assertRaises(ValueError):
+            box.centers_of_mass([[0, 0, 0], [1, 1, 1]], [0, 2], 2)
+
+    def test_sin_cos_turns(self):
+        # Cover the full turn range densely, including the exact quarter and
+        # eighth turns where the argument reduction switches quadrants.
+        turns = np.concatenate([
+            np.linspace(-1, 1, 200001), np.arange(-8, 9) / 8,
+            np.arange(-8, 9) / 8 + 1e-7, np.arange(-8, 9) / 8 - 1e-7,
+            np.random.uniform(-0.5, 0.5, size=1001)]).astype(np.float32)
+        sines, cosines = freud.box._sin_cos_turns(turns)
+        angles = 2*np.pi*turns.astype(np.float64)
+        self.assertEqual(sines.shape, turns.shape)
+        self.assertEqual(cosines.shape, turns.shape)
+        npt.assert_allclose(sines, np.sin(angles), rtol=0, atol=2e-7)
+        npt.assert_allclose(cosines, np.cos(angles), rtol=0, atol=2e-7)
+
+        # Exact quarter turns give exact values.
+        sines, cosines = freud.box._sin_cos_turns([0, 0.25, 0.5, -0.25, 1])
+        npt.assert_array_equal(np.abs(sines), [0, 1, 0, 1, 0])
+        npt.assert_array_equal(np.abs(cosines), [1, 0, 1, 0, 1])
+
+        sines, cosines = freud.box._sin_cos_turns([])
+        self.assertEqual(len(sines), 0)
+        self.assertEqual(len(cosines), 0)
+
     def test_center(self):
         box = freud.box.Box.cube(5)
 
@@ -267,6 +357,33 @@ class TestBox(unittest.TestCase):
 
         npt.assert_equal(testfraction, f_point)
 
+    def test_transform_many_vectors(self):
+        # Enough vectors to span several batches, with a partial last batch.
+        for is2D in [False, True]:
+            box = freud.box.Box(2, 3, 0 if is2D else 4, 0.5, 0.2, -0.3,
+                                is2D=is2D)
+            np.random.seed(0)
+            points = np.random.uniform(-10, 10, size=(1003, 3))
+            if is2D:
+                points[:, 2] = 0
+            original = points.copy()
+
+            wrapped = box.wrap(points)
+            images = box.get_images(points)
+            npt.assert_equal(points, original)
+            fractions = box.make_fractional(wrapped)
+            self.assertTrue(np.all(fractions >= -1e-5))
+            self.assertTrue(np.all(fractions <= 1 + 1e-5))
+            npt.assert_allclose(box.make_absolute(fractions), wrapped,
+                                atol=1e-5)
+            npt.assert_allclose(box.unwrap(wrapped, images), points,
+                                atol=1e-4)
+            npt.assert_equal(box.get_images(box.unwrap(wrapped, images)),
+                             images)
+            for i in [0, 63, 64, 1002]:
+                npt.assert_allclose(wrapped[i], box.wrap(points[i]),
+                                    atol=1e-6)
+
     def test_vectors(self):
         """Test getting lattice vectors"""
         b_list = [1, 2, 3, 0.1, 0.2, 0.3]
@@ -509,6 +626,54 @@ class TestBox(unittest.TestCase):
         npt.assert_allclose(distances,
                             [[1., 0., 1.], [np.sqrt(2), 1., 0.]], rtol=1e-6)
 
+    def test_compute_nearest_distances(self):
+        box = freud.box.Box(5, 6, 7, 0.5, 0.2, -0.3)
+        np.random.seed(0)
+        query_points = box.wrap(np.random.uniform(-3, 3, size=(10, 3)))
+        points = box.wrap(np.random.uniform(-3, 3, size=(200, 3)))
+        all_distances = box.compute_all_distances(query_points, points)
+
+        distances, indices = box.compute_nearest_distances(
+            query_points, points, k=4)
+        self.assertEqual(distances.shape, (10, 4))
+        npt.assert_allclose(
+            distances, np.sort(all_distances, axis=1)[:, :4], rtol=1e-6)
+        npt.assert_allclose(
+            np.take_along_axis(all_distances, indices.astype(np.int64), 1),
+            distances, rtol=1e-6)
+
+        with self.assertRaises(ValueError):
+            box.compute_nearest_distances(query_points, points, k=0)
+        with self.assertRaises(ValueError):
+            box.compute_nearest_distances(query_points, points, k=201)
+
+    def test_compute_distance_histogram(self):
+        box = freud.box.Box(5, 6, 7, 0.5, 0.2, -0.3)
+        np.random.seed(0)
+        query_points = box.wrap(np.random.uniform(-3, 3, size=(10, 3)))
+        points = box.wrap(np.random.uniform(-3, 3, size=(200, 3)))
+        all_distances = box.compute_all_distances(query_points, points)
+
+        counts = box.compute_distance_histogram(
+            query_points, points, bins=10, r_max=2.5)
+        expected, _ = np.histogram(all_distances, bins=10, range=(0, 2.5))
+        npt.assert_equal(counts, expected)
+
+    def test_compute_distance_histogram_right_edge(self):
+        box = freud.box.Box.cube(10)
+        query_points = np.zeros((1, 3), dtype=np.float32)
+        points = np.array([[0, 0, 0], [1.25, 0, 0], [2.5, 0, 0],
+                           [1.5, 2, 0], [0, 0, -2.5], [2.6, 0, 0]],
+                          dtype=np.float32)
+        all_distances = box.compute_all_distances(query_points, points)
+
+        # The last bin includes distances equal to r_max, as in numpy.
+        counts = box.compute_distance_histogram(
+            query_points, points, bins=2, r_max=2.5)
+        expected, _ = np.histogram(all_distances, bins=2, range=(0, 2.5))
+        npt.assert_equal(counts, expected)
+        npt.assert_equal(counts, [1, 4])
+
     def test_contains_2d(self):
         box = freud.box.Box(2, 3, 0, 1, 0, 0)
         points = np.random.uniform(-0.5, 0.5, size=(100, 3)).astype(np.float32)
@@ -207,6 +207,101 @@ class TestCorrelationFunction(unittest.TestCase):
     def test_repr(self):
         cf = freud.density.CorrelationFunction(1000, 40)
         self.assertEqual(str(cf), str(eval(repr(cf))))
+        cf = freud.density.CorrelationFunction(100, 40, method='fft',
+                                               grid_spacing=0.1)
+        self.assertEqual(str(cf), str(eval(repr(cf))))
+
+    def test_fft_matches_direct(self):
+        # The grid correlation approximates the direct correlation to within
+        # the grid spacing.
+        r_max = 8
+        bins = 16
+        for is2D, grid_spacing in ((True, 0.1), (False, 0.25)):
+            box, points = freud.data.make_random_system(
+                20, 2000, is2D=is2D, seed=0)
+            phases = np.random.RandomState(1).rand(len(points))
+            values = np.exp(1j * (4 * np.pi * points[:, 0] / box.Lx
+                                  + phases))
+            query_points = points[::2]
+            query_values = np.exp(4j * np.pi * query_points[:, 0] / box.Lx)
+            for args in ((), (query_points, query_values)):
+                direct = freud.density.CorrelationFunction(bins, r_max)
+                direct.compute((box, points), values, *args)
+                fft = freud.density.CorrelationFunction(
+                    bins, r_max, method='fft', grid_spacing=grid_spacing)
+                fft.compute((box, points), values, *args)
+                npt.assert_allclose(fft.correlation, direct.correlation,
+                                    atol=0.02)
+                # Rounding distances to the grid mostly affects the counts at
+                # short distances.
+                npt.assert_allclose(fft.bin_counts[2:],
+                                    direct.bin_counts[2:], rtol=0.1)
+                npt.assert_allclose(np.sum(fft.bin_counts),
+                                    np.sum(direct.bin_counts), rtol=5e-3)
+
+    def test_fft_real(self):
+        box, points = freud.data.make_random_system(20, 1000, seed=0)
+        values = np.cos(4 * np.pi * points[:, 0] / box.Lx)
+        direct = freud.density.CorrelationFunction(10, 8)
+        direct.compute((box, points), values)
+        fft = freud.density.CorrelationFunction(10, 8, method='fft',
+                                                grid_spacing=0.1)
+        fft.compute((box, points), values)
+        self.assertFalse(np.iscomplexobj(fft.correlation))
+        npt.assert_allclose(fft.correlation, direct.correlation, atol=0.02)
+
+    def test_accumulation_strategies(self):
+        # Complex values cannot be added atomically, so only the dense and
+        # sparse strategies are available.
+        box, points = freud.data.make_random_system(20, 1000, seed=2)
+        angles = np.random.RandomState(2).rand(len(points)) * 2 * np.pi
+        for values in [np.exp(1j*angles), np.cos(angles)]:
+            for method in ['direct', 'fft']:
+                dense = freud.density.CorrelationFunction(10, 8, method)
+                dense.accumulation_strategy = 'dense'
+                dense.compute((box, points), values)
+                dense.compute((box, points), values, reset=False)
+
+                sparse = freud.density.CorrelationFunction(10, 8, method)
+                sparse.accumulation_strategy = 'sparse'
+                self.assertEqual(sparse.accumulation_strategy, 'sparse')
+                sparse.compute((box, points), values)
+                sparse.compute((box, points), values, reset=False)
+                npt.assert_array_equal(sparse.bin_counts, dense.bin_counts)
+                npt.assert_allclose(sparse.correlation, dense.correlation,
+                                    rtol=1e-6, atol=1e-8)
+
+                for strategy in ['atomic', 'cache']:
+                    with self.assertRaises(ValueError):
+                        sparse.accumulation_strategy = strategy
+                    self.assertEqual(sparse.accumulation_strategy, 'sparse')
+
+    def test_fft_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.density.CorrelationFunction(10, 8, method='mesh')
+        with self.assertRaises(ValueError):
+            freud.density.CorrelationFunction(10, 8, method='fft',
+                                              grid_spacing=-1)
+
+        box, points = freud.data.make_random_system(20, 100, seed=0)
+        values = np.ones(len(points))
+        cf = freud.density.CorrelationFunction(10, 12, method='fft')
+        with self.assertRaises(ValueError):
+            cf.compute((box, points), values)
+
+        cf = freud.density.CorrelationFunction(10, 8, method='fft')
+        nlist = freud.locality.AABBQuery(box, points).query(
+            points, {'r_max': 8, 'exclude_ii': True}).toNeighborList()
+        with self.assertRaises(ValueError):
+            cf.compute((box, points), values, neighbors=nlist)
+        for qargs in [{'num_neighbors': 4}, {'r_max': 8, 'r_min': 1},
+                      {'r_max': 6}, {'r_max': 8, 'r_shells': [4, 8]}]:
+            with self.assertRaises(ValueError):
+                cf.compute((box, points), values, neighbors=qargs)
+        cf.compute((box, points), values,
+                   neighbors={'r_max': 8, 'exclude_ii': False})
+        self.assertEqual(cf.method, 'fft')
+        self.assertAlmostEqual(cf.grid_spacing, 0.8)
 
     def test_repr_png(self):
         r_max = 10.0
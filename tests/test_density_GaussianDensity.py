@@ -131,6 +131,108 @@ class TestGaussianDensity(unittest.TestCase):
             # This has discretization error as well as single-precision error
             assert np.isclose(np.sum(gd.density), np.sum(values), rtol=1e-4)
 
+    def test_orthorhombic_matches_reference(self):
+        # Orthorhombic boxes use separable per-axis Gaussian weights, which
+        # must match a direct evaluation over all voxels.
+        width = (20, 24, 28)
+        r_max = 2.5
+        sigma = 0.8
+        box = freud.box.Box(10, 12, 14)
+        _, points = freud.data.make_random_system(10, 20, seed=1)
+        points = box.wrap(points * np.array([1, 1.2, 1.4]))
+        values = np.random.RandomState(0).rand(len(points))
+        gd = freud.density.GaussianDensity(width, r_max, sigma)
+        gd.compute((box, points), values)
+
+        grid_size = box.L / width
+        centers = np.stack(np.meshgrid(
+            *[(np.arange(w) + 0.5) * g - L / 2 for w, g, L in zip(
+                width, grid_size, box.L)], indexing='ij'), axis=-1)
+        reference = np.zeros(width)
+        for point, value in zip(points, values):
+            delta = box.wrap((centers - point).reshape(-1, 3))
+            r_sq = np.sum(delta**2, axis=-1).reshape(width)
+            gaussian = value * np.exp(-r_sq / (2 * sigma**2)) / (
+                2 * np.pi * sigma**2)**1.5
+            reference += np.where(r_sq < r_max**2, gaussian, 0)
+        npt.assert_allclose(gd.density, reference, rtol=1e-4, atol=1e-6)
+
+    def test_fft_matches_direct(self):
+        # The FFT method interpolates the Gaussian between grid cells, so it
+        # agrees with the direct method up to an error of order
+        # (grid spacing / sigma)^2.
+        r_max = 8
+        sigma = 2
+        values = np.random.RandomState(0).rand(200)
+        for is2D, width in ((False, (40, 48, 56)), (True, (80, 96))):
+            box, points = freud.data.make_random_system(
+                20, len(values), is2D=is2D, seed=0)
+            direct = freud.density.GaussianDensity(
+                width, r_max, sigma, method='direct')
+            fft = freud.density.GaussianDensity(
+                width, r_max, sigma, method='fft')
+            self.assertEqual(fft.method, 'fft')
+            direct.compute((box, points), values)
+            fft.compute((box, points), values)
+            npt.assert_allclose(fft.density, direct.density,
+                                atol=0.02 * np.max(direct.density))
+            npt.assert_allclose(np.sum(fft.density), np.sum(direct.density),
+                                rtol=1e-4)
+
+            # Aperiodic boxes are padded instead of wrapped.
+            box.periodic = False
+            direct.compute((box, points), values)
+            fft.compute((box, points), values)
+            npt.assert_allclose(fft.density, direct.density,
+                                atol=0.02 * np.max(direct.density))
+
+    def test_fft_invalid(self):
+        self.assertEqual(
+            freud.density.GaussianDensity(10, 1, 0.1).method, 'direct')
+        with self.assertRaises(ValueError):
+            freud.density.GaussianDensity(10, 1, 0.1, method='spectral')
+        box = freud.box.Box(10, 10, 10, 0.5, 0, 0)
+        gd = freud.density.GaussianDensity(20, 3, 1, method='fft')
+        with self.assertRaises(ValueError):
+            gd.compute((box, [[0, 0, 0]]))
+
+    def test_accumulation_strategies(self):
+        # The FFT method deposits the points with a BinAccumulator, whose
+        # strategies must all agree with private per-thread grids.
+        values = np.random.RandomState(1).rand(500)
+        for is2D, width in ((False, (40, 48, 56)), (True, (80, 96))):
+            box, points = freud.data.make_random_system(
+                20, len(values), is2D=is2D, seed=1)
+            gd = freud.density.GaussianDensity(width, 8, 2, method='fft')
+            self.assertEqual(gd.accumulation_strategy, 'auto')
+            gd.accumulation_strategy = 'dense'
+            dense = np.copy(gd.compute((box, points), values).density)
+            for strategy in ['atomic', 'cache', 'sparse', 'auto']:
+                gd.accumulation_strategy = strategy
+                self.assertEqual(gd.accumulation_strategy, strategy)
+                npt.assert_allclose(
+                    gd.compute((box, points), values).density, dense,
+                    rtol=1e-5, atol=1e-6 * np.max(dense))
+
+        with self.assertRaises(ValueError):
+            gd.accumulation_strategy = 'shared'
+
+    def test_wide_halo_thread_counts(self):
+        # Cutoffs spanning more rows than each thread's share of the grid
+        # limit the number of slabs, down to a single slab deposited
+        # atomically. The result must not depend on the number of threads.
+        box, points = freud.data.make_random_system(30, 500, seed=0)
+        for r_max, periodic in [(3, True), (3, False), (12, True)]:
+            box.periodic = (periodic, True, True)
+            gd = freud.density.GaussianDensity(
+                (40, 24, 28), r_max, r_max / 3, method='direct')
+            with freud.parallel.ExecutionContext(num_threads=1):
+                density = gd.compute((box, points)).density
+            for num_threads in (3, 16):
+                with freud.parallel.ExecutionContext(num_threads=num_threads):
+                    npt.assert_allclose(gd.compute((box, points)).density,
+                                        density, rtol=1e-5, atol=1e-7)
+
     def test_repr(self):
         gd = freud.density.GaussianDensity(100, 10.0, 0.1)
         self.assertEqual(str(gd), str(eval(repr(gd))))
@@ -139,6 +241,9 @@ class TestGaussianDensity(unittest.TestCase):
         gd3 = freud.density.GaussianDensity((98, 99, 100), 10.0, 0.1)
         self.assertEqual(str(gd3), str(eval(repr(gd3))))
 
+        gd_fft = freud.density.GaussianDensity(100, 10.0, 0.1, method='fft')
+        self.assertEqual(str(gd_fft), str(eval(repr(gd_fft))))
+
     def test_repr_png(self):
         width = 100
         r_max = 10.0
@@ -69,8 +69,37 @@ class TestLD(unittest.TestCase):
         neighbors = self.ld.num_neighbors
         npt.assert_array_less(np.fabs(neighbors - 1130.973355292), 200)
 
+    def test_multiple_radii(self):
+        """Test that each radius of a LocalDensity computed with several radii
+        matches a LocalDensity computed with that radius alone."""
+        r_maxs = [1.0, 1.5, 2.25, 3.0]
+        ld = freud.density.LocalDensity(r_maxs, self.diameter)
+        npt.assert_allclose(ld.r_max, r_maxs)
+        ld.compute((self.box, self.pos))
+        self.assertEqual(ld.density.shape, (len(self.pos), len(r_maxs)))
+        self.assertEqual(ld.num_neighbors.shape, (len(self.pos), len(r_maxs)))
+        for k, r_max in enumerate(r_maxs):
+            single = freud.density.LocalDensity(r_max, self.diameter)
+            single.compute((self.box, self.pos))
+            npt.assert_allclose(ld.num_neighbors[:, k], single.num_neighbors,
+                                rtol=1e-5)
+            npt.assert_allclose(ld.density[:, k], single.density, rtol=1e-5)
+
+        # A single radius given as a sequence still produces one column.
+        ld = freud.density.LocalDensity([self.r_max], self.diameter)
+        ld.compute((self.box, self.pos))
+        self.assertEqual(ld.density.shape, (len(self.pos), 1))
+
+    def test_invalid_radii(self):
+        with self.assertRaises(ValueError):
+            freud.density.LocalDensity([], self.diameter)
+        with self.assertRaises(ValueError):
+            freud.density.LocalDensity([1.0, 0.0], self.diameter)
+
     def test_repr(self):
         self.assertEqual(str(self.ld), str(eval(repr(self.ld))))
+        ld = freud.density.LocalDensity([1.0, 2.5], self.diameter)
+        self.assertEqual(str(ld), str(eval(repr(ld))))
 
     def test_points_ne_query_points(self):
         box = freud.box.Box.cube(10)
@@ -0,0 +1,129 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+def assignment_weights(assignment, u, width):
+    """Return the periodic voxel weights of a coordinate in voxel units."""
+    weights = np.zeros(width)
+    if assignment == 'ngp':
+        weights[int(np.floor(u)) % width] += 1
+    elif assignment == 'cic':
+        first = int(np.floor(u - 0.5))
+        d = u - 0.5 - first
+        weights[first % width] += 1 - d
+        weights[(first + 1) % width] += d
+    else:
+        center = int(np.floor(u))
+        d = u - (center + 0.5)
+        weights[(center - 1) % width] += 0.5 * (0.5 - d)**2
+        weights[center % width] += 0.75 - d**2
+        weights[(center + 1) % width] += 0.5 * (0.5 + d)**2
+    return weights
+
+
+def reference_density(box, points, values, width, assignment):
+    """Compute the density of points in a cubic periodic box with numpy."""
+    density = np.zeros(width)
+    voxel_volume = box.volume / np.prod(width)
+    fractions = box.make_fractional(points)
+    for fraction, value in zip(fractions, values):
+        u = fraction * width
+        wx = assignment_weights(assignment, u[0], width[0])
+        wy = assignment_weights(assignment, u[1], width[1])
+        wz = assignment_weights(assignment, u[2], width[2])
+        density += value * np.einsum('i,j,k->ijk', wx, wy, wz)
+    return density / voxel_volume
+
+
+class TestMeshDensity(unittest.TestCase):
+    def test_conservation(self):
+        # The weights of every scheme sum to one, so the integrated density
+        # equals the total value of the points.
+        for is2D in (True, False):
+            box, points = freud.data.make_random_system(
+                12, 500, is2D=is2D, seed=0)
+            values = np.random.RandomState(1).rand(len(points))
+            width = (16, 20) if is2D else (16, 20, 24)
+            for assignment in ('ngp', 'cic', 'tsc'):
+                mesh = freud.density.MeshDensity(width, assignment)
+                mesh.compute((box, points), values)
+                self.assertEqual(mesh.density.shape, width)
+                voxel_volume = box.volume / np.prod(width)
+                npt.assert_allclose(
+                    np.sum(mesh.density) * voxel_volume, np.sum(values),
+                    rtol=1e-4)
+
+    def test_ngp_single_point(self):
+        box = freud.box.Box.cube(10)
+        points = np.array([[-4.9, 0.2, 3.3]], dtype=np.float32)
+        mesh = freud.density.MeshDensity(10, 'ngp')
+        mesh.compute((box, points))
+        expected = np.zeros((10, 10, 10))
+        expected[0, 5, 8] = 1 / (box.volume / 1000)
+        npt.assert_allclose(mesh.density, expected, atol=1e-6)
+
+    def test_reference(self):
+        box = freud.box.Box.cube(10)
+        points = np.array([[-4.9, 0.2, 3.3],
+                           [1.37, -2.81, 4.95],
+                           [0, 0, 0]], dtype=np.float32)
+        values = np.array([1.0, 2.5, 0.5], dtype=np.float32)
+        width = (10, 12, 14)
+        for assignment in ('ngp', 'cic', 'tsc'):
+            mesh = freud.density.MeshDensity(width, assignment)
+            mesh.compute((box, points), values)
+            npt.assert_allclose(
+                mesh.density,
+                reference_density(box, points, values, width, assignment),
+                rtol=1e-4, atol=1e-6)
+
+    def test_aperiodic(self):
+        # Contributions outside of the grid along aperiodic dimensions are
+        # discarded.
+        box = freud.box.Box.cube(10)
+        box.periodic = (False, True, True)
+        points = np.array([[-4.9, 0, 0]], dtype=np.float32)
+        mesh = freud.density.MeshDensity(10, 'cic')
+        mesh.compute((box, points))
+        voxel_volume = box.volume / 1000
+        npt.assert_allclose(
+            np.sum(mesh.density) * voxel_volume, 0.6, rtol=1e-4)
+
+    def test_slab_boundaries(self):
+        # Place points on the edges between rows of voxels along x, so that
+        # the assignment stencils of many points straddle the boundaries of
+        # the slabs owned by different threads.
+        box = freud.box.Box.cube(12)
+        width = (24, 10, 10)
+        rng = np.random.RandomState(0)
+        x = np.repeat(np.arange(width[0]) * 0.5 - 6, 10)
+        points = np.column_stack(
+            [x, rng.uniform(-6, 6, (len(x), 2))]).astype(np.float32)
+        values = rng.rand(len(points))
+        reference = reference_density(box, points, values, width, 'tsc')
+        mesh = freud.density.MeshDensity(width, 'tsc')
+        for num_threads in (1, 2, 5, 8):
+            with freud.parallel.ExecutionContext(num_threads=num_threads):
+                mesh.compute((box, points), values)
+            npt.assert_allclose(mesh.density, reference, rtol=1e-4, atol=1e-6)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.density.MeshDensity(10, 'pcs')
+        with self.assertRaises(ValueError):
+            freud.density.MeshDensity((10, 10, 10, 10))
+
+    def test_repr(self):
+        mesh = freud.density.MeshDensity(100)
+        self.assertEqual(str(mesh), str(eval(repr(mesh))))
+        self.assertEqual(mesh.assignment, 'cic')
+
+        mesh3 = freud.density.MeshDensity((98, 99, 100), 'tsc')
+        self.assertEqual(str(mesh3), str(eval(repr(mesh3))))
+        self.assertEqual(mesh3.assignment, 'tsc')
+
+
+if __name__ == '__main__':
+    unittest.main()
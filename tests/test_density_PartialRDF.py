@@ -0,0 +1,134 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import matplotlib
+import unittest
+matplotlib.use('agg')
+
+
+class TestPartialRDF(unittest.TestCase):
+    def test_attribute_access(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        types = np.arange(len(points)) % 2
+        prdf = freud.density.PartialRDF(2, 10, 3)
+
+        with self.assertRaises(AttributeError):
+            prdf.rdf
+        with self.assertRaises(AttributeError):
+            prdf.n_r
+
+        prdf.compute((box, points), types)
+        self.assertEqual(prdf.rdf.shape, (2, 2, 10))
+        self.assertEqual(prdf.n_r.shape, (2, 2, 10))
+        self.assertEqual(prdf.bin_counts.shape, (2, 2, 10))
+        self.assertEqual(prdf.nbins, 10)
+        self.assertEqual(prdf.bin_centers.shape, (10, ))
+        self.assertEqual(prdf.bin_edges.shape, (11, ))
+        self.assertEqual(prdf.num_types, 2)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.density.PartialRDF(0, 10, 3)
+        with self.assertRaises(ValueError):
+            freud.density.PartialRDF(2, 0, 3)
+        with self.assertRaises(ValueError):
+            freud.density.PartialRDF(2, 10, 3, r_min=4)
+
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        prdf = freud.density.PartialRDF(2, 10, 3)
+        with self.assertRaises(ValueError):
+            prdf.compute((box, points), np.full(len(points), 2))
+        with self.assertRaises(ValueError):
+            prdf.compute((box, points), np.zeros(len(points)),
+                         query_points=points[:10])
+
+    def test_matches_rdf(self):
+        # The partial RDF of each pair of types matches the RDF of the points
+        # of one type around the query points of the other.
+        r_max = 3.0
+        bins = 30
+        box, points = freud.data.make_random_system(15, 1000, seed=0)
+        types = np.random.RandomState(1).randint(3, size=len(points))
+        query_points = points[::3]
+        query_types = types[::3]
+        prdf = freud.density.PartialRDF(3, bins, r_max, r_min=0.5)
+        prdf.compute((box, points), types, query_points, query_types)
+        for a in range(3):
+            for b in range(3):
+                rdf = freud.density.RDF(bins, r_max, r_min=0.5)
+                rdf.compute((box, points[types == b]),
+                            query_points[query_types == a])
+                npt.assert_allclose(prdf.rdf[a, b], rdf.rdf,
+                                    rtol=1e-5, atol=1e-5)
+                npt.assert_array_equal(prdf.bin_counts[a, b],
+                                       rdf.bin_counts)
+                # The average number of neighbors of type b of a query point
+                # of type a.
+                npt.assert_allclose(
+                    prdf.n_r[a, b],
+                    np.cumsum(rdf.bin_counts) / np.sum(query_types == a),
+                    rtol=1e-5)
+
+    def test_total_rdf(self):
+        # Weighting the partial RDFs by the pair fractions gives the total
+        # RDF.
+        for is2D in (False, True):
+            box, points = freud.data.make_random_system(
+                15, 1000, is2D=is2D, seed=0)
+            types = np.random.RandomState(1).randint(4, size=len(points))
+            prdf = freud.density.PartialRDF(4, 40, 4, normalize=True)
+            prdf.compute((box, points), types)
+            rdf = freud.density.RDF(40, 4, normalize=True)
+            rdf.compute((box, points))
+
+            counts = np.bincount(types, minlength=4).astype(np.float64)
+            weights = np.outer(counts, counts) - np.diag(counts)
+            weights /= len(points) * (len(points) - 1)
+            npt.assert_allclose(
+                np.einsum('ab,abr->r', weights, prdf.rdf), rdf.rdf,
+                rtol=1e-4, atol=1e-5)
+
+    def test_accumulation(self):
+        # The normalization is summed over frames with different
+        # compositions.
+        box, points = freud.data.make_random_system(15, 500, seed=0)
+        types = [np.arange(len(points)) % 2,
+                 (np.arange(len(points)) % 5 == 0).astype(np.uint32)]
+        prdf = freud.density.PartialRDF(2, 20, 3)
+        for frame_types in types:
+            prdf.compute((box, points), frame_types, reset=False)
+
+        bin_counts = 0
+        normalization = 0
+        for frame_types in types:
+            counts = np.bincount(frame_types, minlength=2)
+            normalization += np.outer(counts, counts) / box.volume
+            bin_counts += freud.density.PartialRDF(2, 20, 3).compute(
+                (box, points), frame_types).bin_counts
+        r = prdf.bin_edges
+        shell_volumes = 4 / 3 * np.pi * (r[1:]**3 - r[:-1]**3)
+        npt.assert_array_equal(prdf.bin_counts, bin_counts)
+        npt.assert_allclose(
+            prdf.rdf,
+            bin_counts / normalization[..., np.newaxis] / shell_volumes,
+            rtol=1e-5)
+
+    def test_repr(self):
+        prdf = freud.density.PartialRDF(3, 10, 3, r_min=0.5)
+        self.assertEqual(str(prdf), str(eval(repr(prdf))))
+
+    def test_repr_png(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        types = np.arange(len(points)) % 2
+        prdf = freud.density.PartialRDF(2, 10, 3)
+
+        with self.assertRaises(AttributeError):
+            prdf.plot()
+        self.assertEqual(prdf._repr_png_(), None)
+
+        prdf.compute((box, points), types)
+        prdf._repr_png_()
+
+
+if __name__ == '__main__':
+    unittest.main()
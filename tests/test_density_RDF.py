@@ -166,6 +166,35 @@ class TestRDF(unittest.TestCase):
         npt.assert_array_equal(rdf.rdf, np.zeros(bins))
         npt.assert_array_equal(rdf.n_r, np.zeros(bins))
 
+    def test_accumulation_strategies(self):
+        r_max = 3.0
+        bins = 30
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+
+        rdf = freud.density.RDF(bins, r_max)
+        self.assertEqual(rdf.accumulation_strategy, 'auto')
+        rdf.accumulation_strategy = 'dense'
+        rdf.compute((box, points))
+        rdf.compute((box, points), reset=False)
+
+        for strategy in ['atomic', 'cache', 'sparse', 'auto']:
+            other = freud.density.RDF(bins, r_max)
+            other.accumulation_strategy = strategy
+            self.assertEqual(other.accumulation_strategy, strategy)
+            other.compute((box, points))
+            other.compute((box, points), reset=False)
+            npt.assert_array_equal(other.bin_counts, rdf.bin_counts)
+            npt.assert_allclose(other.rdf, rdf.rdf, rtol=1e-6)
+            npt.assert_allclose(other.n_r, rdf.n_r, rtol=1e-6)
+
+        # Changing the strategy discards the accumulated counts.
+        other.accumulation_strategy = 'dense'
+        other.compute((box, points), reset=False)
+        npt.assert_array_equal(other.bin_counts * 2, rdf.bin_counts)
+
+        with self.assertRaises(ValueError):
+            rdf.accumulation_strategy = 'shared'
+
     @unittest.skipIf(NumpyVersion(np.__version__) < "1.15.0",
                      "Requires numpy>=1.15.0.")
     def test_bin_precision(self):
@@ -120,6 +120,50 @@ class TestSphereVoxelization(unittest.TestCase):
         with self.assertRaises(ValueError):
             vox.compute((test_box, test_points))
 
+    def test_voxel_centers(self):
+        # A voxel is occupied exactly when its center is within r_max of a
+        # point, including voxels at the rim of spheres whose radius is not
+        # a multiple of the voxel size.
+        for is2D, periodic in ((False, (True, True, True)),
+                               (False, (False, True, True)),
+                               (True, (True, False, True))):
+            box, points = freud.data.make_random_system(
+                10, 20, is2D=is2D, seed=0)
+            box.periodic = periodic
+            width = (17, 19) if is2D else (17, 19, 21)
+            r_max = 1.37
+            vox = freud.density.SphereVoxelization(width, r_max)
+            vox.compute((box, points))
+
+            L = box.L[:2] if is2D else box.L
+            axes = [(np.arange(w) + 0.5) * l / w - l / 2
+                    for w, l in zip(width, L)]
+            centers = np.stack(
+                np.meshgrid(*axes, indexing='ij'), axis=-1)
+            delta = centers[..., np.newaxis, :] - points[:, :len(L)]
+            for dim in range(len(L)):
+                if periodic[dim]:
+                    delta[..., dim] -= L[dim] * np.round(
+                        delta[..., dim] / L[dim])
+            r_sq = np.sum(delta**2, axis=-1)
+            expected = np.any(r_sq < r_max**2, axis=-1)
+            np.testing.assert_array_equal(vox.voxels, expected)
+
+    def test_uneven_slabs(self):
+        # A prime number of rows along x gives slab counts that are not a
+        # multiple of the number of threads, so some threads own more slabs
+        # and the slab boundaries fall at uneven rows.
+        box, points = freud.data.make_random_system(30, 400, seed=0)
+        vox = freud.density.SphereVoxelization((37, 24, 28), 1.2)
+        for periodic in (True, False):
+            box.periodic = (periodic, True, True)
+            with freud.parallel.ExecutionContext(num_threads=1):
+                voxels = vox.compute((box, points)).voxels
+            for num_threads in (3, 5, 7):
+                with freud.parallel.ExecutionContext(num_threads=num_threads):
+                    np.testing.assert_array_equal(
+                        vox.compute((box, points)).voxels, voxels)
+
     def test_repr(self):
         vox = freud.density.SphereVoxelization(100, 10.0)
         self.assertEqual(str(vox), str(eval(repr(vox))))
@@ -122,6 +122,49 @@ class TestDiffractionPattern(unittest.TestCase):
                     # by (number of points)**2
                     npt.assert_allclose(dp.diffraction[center_index], 1)
 
+    def test_multiple_views(self):
+        """Assert that the pattern of several view orientations is the
+        average of their individual patterns.
+        """
+        box, positions = freud.data.make_random_system(
+            box_size=10, num_points=1000, seed=0)
+        view_orientations = rowan.random.rand(5)
+        dp = freud.diffraction.DiffractionPattern(
+            grid_size=128, output_size=100)
+
+        singles = [
+            dp.compute((box, positions), view_orientation=view,
+                       zoom=2).diffraction.copy()
+            for view in view_orientations]
+        dp.compute((box, positions), view_orientation=view_orientations,
+                   zoom=2)
+        npt.assert_allclose(dp.diffraction, np.mean(singles, axis=0),
+                            rtol=1e-10, atol=1e-14)
+        npt.assert_allclose(dp.diffraction[50, 50], 1)
+
+        # The k-vectors are rotated by the first view orientation.
+        first = freud.diffraction.DiffractionPattern(
+            grid_size=128, output_size=100)
+        first.compute((box, positions), view_orientation=view_orientations[0],
+                      zoom=2)
+        npt.assert_allclose(dp.k_vectors, first.k_vectors)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.diffraction.DiffractionPattern(grid_size=0)
+        with self.assertRaises(ValueError):
+            freud.diffraction.DiffractionPattern(output_size=0)
+
+        box, positions = freud.data.make_random_system(
+            box_size=10, num_points=100, seed=0)
+        dp = freud.diffraction.DiffractionPattern(grid_size=64)
+        with self.assertRaises(ValueError):
+            dp.compute((box, positions), zoom=100)
+        with self.assertRaises(ValueError):
+            dp.compute((box, positions), view_orientation=np.zeros((0, 4)))
+        with self.assertRaises(ValueError):
+            dp.compute((box, positions), view_orientation=[0, 0, 0, 0])
+
     def test_repr(self):
         dp = freud.diffraction.DiffractionPattern()
         self.assertEqual(str(dp), str(eval(repr(dp))))
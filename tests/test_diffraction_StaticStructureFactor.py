@@ -0,0 +1,143 @@
+import freud
+import matplotlib
+import unittest
+import numpy as np
+import numpy.testing as npt
+matplotlib.use('agg')
+
+
+def direct_reference(box, points, bins, k_max, k_min):
+    """Average |sum exp(i k.r)|^2 / N over the k-vectors of a cubic box in
+    each bin."""
+    L = box.Lx
+    max_index = int(k_max * L / (2 * np.pi))
+    indices = np.arange(-max_index, max_index + 1)
+    miller = np.stack(np.meshgrid(indices, indices, indices), -1)
+    k_vectors = 2 * np.pi / L * miller.reshape(-1, 3)
+    k_norms = np.linalg.norm(k_vectors, axis=-1)
+    edges = np.linspace(k_min, k_max, bins + 1)
+    S = np.full(bins, np.nan)
+    for i in range(bins):
+        selected = k_vectors[(k_norms >= edges[i]) & (k_norms < edges[i + 1])
+                             & (k_norms > 0)]
+        if len(selected):
+            phases = np.exp(1j * selected @ points.T).sum(axis=-1)
+            S[i] = np.mean(np.abs(phases)**2) / len(points)
+    return S
+
+
+class TestStaticStructureFactor(unittest.TestCase):
+    def test_attribute_access(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        for method in ('debye', 'direct'):
+            sf = freud.diffraction.StaticStructureFactor(
+                20, 10, 1, method=method, r_max=4)
+            self.assertEqual(sf.method, method)
+            self.assertEqual(sf.nbins, 20)
+            self.assertEqual(sf.bounds, (1, 10))
+            npt.assert_allclose(sf.k_values, sf.bin_centers)
+
+            with self.assertRaises(AttributeError):
+                sf.S_k
+            with self.assertRaises(AttributeError):
+                sf.plot()
+
+            sf.compute((box, points))
+            self.assertEqual(sf.S_k.shape, (20, ))
+            self.assertEqual(sf.bin_counts.shape, (20, ))
+            sf.plot()
+            sf._repr_png_()
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.diffraction.StaticStructureFactor(0, 10, r_max=4)
+        with self.assertRaises(ValueError):
+            freud.diffraction.StaticStructureFactor(10, 10, 10, r_max=4)
+        with self.assertRaises(ValueError):
+            freud.diffraction.StaticStructureFactor(10, 10, method='fft')
+        with self.assertRaises(ValueError):
+            freud.diffraction.StaticStructureFactor(10, 10)
+
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        sf = freud.diffraction.StaticStructureFactor(10, 10, method='direct')
+        with self.assertRaises(ValueError):
+            sf.compute((box, points), neighbors={'r_max': 2})
+
+        box, points = freud.data.make_random_system(
+            10, 100, is2D=True, seed=0)
+        sf = freud.diffraction.StaticStructureFactor(10, 10, r_max=4)
+        with self.assertRaises(ValueError):
+            sf.compute((box, points))
+
+    def test_direct_matches_reference(self):
+        box, points = freud.data.make_random_system(8, 200, seed=0)
+        sf = freud.diffraction.StaticStructureFactor(
+            12, 6, 0.5, method='direct', max_k_points=0)
+        sf.compute((box, points))
+        npt.assert_allclose(
+            sf.S_k, direct_reference(box, points, 12, 6, 0.5), rtol=1e-4)
+
+    def test_debye_matches_reference(self):
+        r_max = 4.5
+        box, points = freud.data.make_random_system(10, 400, seed=0)
+        sf = freud.diffraction.StaticStructureFactor(20, 12, 0.5, r_max=r_max)
+        sf.compute((box, points))
+
+        distances = box.compute_all_distances(points, points)
+        distances = distances[(distances > 0) & (distances < r_max)]
+        k = sf.k_values[:, np.newaxis]
+        kr = k[:, 0] * r_max
+        uniform = len(points) / box.volume * 4 * np.pi * (
+            np.sin(kr) - kr * np.cos(kr)) / k[:, 0]**3
+        S = 1 + np.sum(np.sinc(k * distances / np.pi), axis=-1) \
+            / len(points) - uniform
+        npt.assert_allclose(sf.S_k, S, atol=2e-3)
+
+    def test_bragg_peak(self):
+        # The structure factor of a perfect FCC crystal with unit lattice
+        # constant vanishes for all wavevectors below the first Bragg peak at
+        # k = 2 pi sqrt(3).
+        box, points = freud.data.UnitCell.fcc().generate_system(4)
+        sf = freud.diffraction.StaticStructureFactor(
+            40, 15, 0.5, method='direct')
+        sf.compute((box, points))
+        k_peak = 2 * np.pi * np.sqrt(3)
+        peak = np.searchsorted(sf.bin_edges, k_peak) - 1
+        below = sf.S_k[:peak]
+        npt.assert_allclose(below[~np.isnan(below)], 0, atol=1e-3)
+        self.assertGreater(sf.S_k[peak], 1)
+
+    def test_accumulation(self):
+        frames = [freud.data.make_random_system(8, 200, seed=seed)
+                  for seed in range(2)]
+        for method in ('debye', 'direct'):
+            sf = freud.diffraction.StaticStructureFactor(
+                10, 8, 1, method=method, r_max=3.5)
+            single = [sf.compute(frame).S_k.copy() for frame in frames]
+            sf.compute(frames[0])
+            sf.compute(frames[1], reset=False)
+            # Both frames have the same box and number of points, so the
+            # accumulated structure factor is the mean of the frames.
+            npt.assert_allclose(sf.S_k, np.mean(single, axis=0), rtol=1e-5)
+
+    def test_max_k_points(self):
+        box, points = freud.data.make_random_system(20, 200, seed=0)
+        sf = freud.diffraction.StaticStructureFactor(
+            10, 8, 1, method='direct', max_k_points=100)
+        sf.compute((box, points))
+        npt.assert_array_less(sf.bin_counts, 11)
+        all_k = freud.diffraction.StaticStructureFactor(
+            10, 8, 1, method='direct', max_k_points=0)
+        all_k.compute((box, points))
+        npt.assert_array_less(sf.bin_counts, all_k.bin_counts + 1)
+
+    def test_repr(self):
+        for sf in (freud.diffraction.StaticStructureFactor(
+                       20, 10, 1, r_max=4),
+                   freud.diffraction.StaticStructureFactor(
+                       20, 10, method='direct', max_k_points=500)):
+            self.assertEqual(str(sf), str(eval(repr(sf))))
+
+
+if __name__ == '__main__':
+    unittest.main()
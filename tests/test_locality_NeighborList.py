@@ -249,6 +249,29 @@ class TestNeighborList(unittest.TestCase):
 
         self.assertEqual(tuples, sorted_tuples)
 
+    def test_set_operations(self):
+        points = self.nq.points
+        nlist_ball = self.nq.query(
+            points, dict(r_max=2.5, exclude_ii=True)).toNeighborList()
+        bonds = set(map(tuple, self.nlist[:]))
+        bonds_ball = set(map(tuple, nlist_ball[:]))
+
+        for result, expected in [
+                (self.nlist.union(nlist_ball), bonds | bonds_ball),
+                (self.nlist.intersection(nlist_ball), bonds & bonds_ball),
+                (self.nlist.difference(nlist_ball), bonds - bonds_ball)]:
+            self.assertEqual(result[:].tolist(),
+                             [list(bond) for bond in sorted(expected)])
+            self.assertEqual(result.num_query_points, self.N)
+            self.assertEqual(result.num_points, self.N)
+
+        # Distances are preserved from the first list.
+        intersection = nlist_ball.intersection(nlist_ball.copy())
+        npt.assert_equal(intersection[:], nlist_ball[:])
+        npt.assert_equal(intersection.distances, nlist_ball.distances)
+        self.assertEqual(
+            len(nlist_ball.difference(nlist_ball)), 0)
+
     def test_num_points(self):
         query_point_indices = [0, 0, 1, 2, 3]
         point_indices = [1, 2, 3, 0, 0]
@@ -287,6 +287,150 @@ class NeighborQueryTest(object):
 
         npt.assert_equal(set(result_list), set(list_nlist))
 
+    def test_query_shells_to_nlists(self):
+        """Test that shell NeighborLists match separate queries at each
+        cutoff."""
+        L = 10  # Box Dimensions
+        N = 400  # number of particles
+        r_shells = [1.0, 1.5, 2.0]
+
+        box, ref_points = freud.data.make_random_system(L, N, seed=0)
+        _, points = freud.data.make_random_system(L, N, seed=1)
+
+        nq = self.build_query_object(box, ref_points, L/10)
+
+        nlists = nq.query(points, dict(mode='ball', r_shells=r_shells,
+                                       exclude_ii=True)).toNeighborLists()
+        self.assertEqual(len(nlists), len(r_shells))
+        for r_max, nlist in zip(r_shells, nlists):
+            ref_nlist = nq.query(points, dict(mode='ball', r_max=r_max,
+                                              exclude_ii=True)).toNeighborList()
+            npt.assert_array_equal(nlist[:], ref_nlist[:])
+            npt.assert_allclose(nlist.distances, ref_nlist.distances)
+
+        # Without shells, a single list with all neighbors is returned.
+        nlists = nq.query(points, dict(mode='ball', r_max=2)).toNeighborLists()
+        self.assertEqual(len(nlists), 1)
+
+        with self.assertRaises(ValueError):
+            nq.query(points, dict(mode='ball', r_shells=[1.5, 1.0])
+                     ).toNeighborLists()
+        with self.assertRaises(ValueError):
+            nq.query(points, dict(mode='ball', r_max=1.0, r_shells=[0.5, 2.0])
+                     ).toNeighborLists()
+
+    def test_query_shells_on_boundary(self):
+        """Test that points on a shell radius are assigned to the same shell
+        as a separate query with that cutoff."""
+        L = 10  # Box Dimensions
+        # For these cutoffs, the square root of the largest single precision
+        # squared distance below the squared cutoff rounds up to the cutoff.
+        r_shells = [1.25, 1.4, 2.5]
+
+        # Rounding to single precision puts the squared distances of these
+        # points just inside or just outside of each shell.
+        np.random.seed(0)
+        directions = np.random.normal(size=(200, 3))
+        directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+        ref_points = np.concatenate(
+            [r * directions for r in r_shells] +
+            [[[1.25, 0, 0], [0.75, 1, 0], [0, 0, 1.4], [1.5, 2, 0]]]
+        ).astype(np.float32)
+        points = np.zeros((1, 3), dtype=np.float32)
+        box = freud.box.Box.cube(L)
+
+        nq = self.build_query_object(box, ref_points, L/10)
+
+        nlists = nq.query(points, dict(mode='ball', r_shells=r_shells)
+                          ).toNeighborLists()
+        for r_max, nlist in zip(r_shells, nlists):
+            ref_nlist = nq.query(points, dict(mode='ball', r_max=r_max)
+                                 ).toNeighborList()
+            npt.assert_array_equal(nlist[:], ref_nlist[:])
+            npt.assert_array_equal(nlist.distances, ref_nlist.distances)
+
+    def assert_type_pair_bonds(self, nq, points, r_max_pairs, point_types,
+                               query_point_types, nlist, exclude_ii=False):
+        """Assert that a per-type-pair query found the same bonds as separate
+        ball queries with the cutoff of each pair of types."""
+        ref_bonds = []
+        for (query_type, point_type), r_max in np.ndenumerate(r_max_pairs):
+            ref_nlist = nq.query(points, dict(
+                mode='ball', r_max=r_max, exclude_ii=exclude_ii)
+            ).toNeighborList()
+            mask = np.logical_and(
+                query_point_types[ref_nlist.query_point_indices] ==
+                query_type,
+                point_types[ref_nlist.point_indices] == point_type)
+            ref_bonds.append(ref_nlist[:][mask])
+        ref_bonds = np.concatenate(ref_bonds)
+        ref_bonds = ref_bonds[np.lexsort(ref_bonds[:, ::-1].T)]
+        npt.assert_array_equal(nlist[:], ref_bonds)
+
+    def test_query_type_pair_cutoffs(self):
+        """Test that per-type-pair cutoffs match separate queries with each
+        pair's cutoff."""
+        L = 10  # Box Dimensions
+        N = 400  # number of particles
+        r_max_pairs = np.array([[1.1, 1.3], [1.3, 1.8]], dtype=np.float32)
+
+        box, ref_points = freud.data.make_random_system(L, N, seed=0)
+        _, points = freud.data.make_random_system(L, N, seed=1)
+        np.random.seed(0)
+        ref_types = np.random.randint(2, size=N)
+        types = np.random.randint(2, size=N)
+
+        nq = self.build_query_object(box, ref_points, L/10)
+
+        nlist = nq.query(points, dict(
+            mode='ball', r_max_pairs=r_max_pairs, point_types=ref_types,
+            query_point_types=types)).toNeighborList()
+        self.assert_type_pair_bonds(nq, points, r_max_pairs, ref_types,
+                                    types, nlist)
+
+        # Query point types default to the point types.
+        nlist = nq.query(ref_points, dict(
+            mode='ball', r_max_pairs=r_max_pairs, point_types=ref_types,
+            exclude_ii=True)).toNeighborList()
+        self.assert_type_pair_bonds(nq, ref_points, r_max_pairs, ref_types,
+                                    ref_types, nlist, exclude_ii=True)
+
+        with self.assertRaises(ValueError):
+            nq.query(points, dict(mode='ball', r_max_pairs=r_max_pairs,
+                                  point_types=ref_types[:-1]))
+        with self.assertRaises(ValueError):
+            nq.query(points, dict(mode='ball', r_max_pairs=r_max_pairs,
+                                  point_types=ref_types + 2,
+                                  query_point_types=types)).toNeighborList()
+
+    def test_query_type_pair_cutoffs_on_boundary(self):
+        """Test that points on a pair cutoff are found exactly when a separate
+        query with that cutoff finds them."""
+        L = 10  # Box Dimensions
+        # For these cutoffs, the square root of the largest single precision
+        # squared distance below the squared cutoff rounds up to the cutoff.
+        r_max_pairs = np.array([[1.25, 1.4], [1.4, 2.5]], dtype=np.float32)
+
+        np.random.seed(0)
+        directions = np.random.normal(size=(200, 3))
+        directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+        ref_points = np.concatenate(
+            [r * directions for r in (1.25, 1.4, 2.5)] +
+            [[[1.25, 0, 0], [0.75, 1, 0], [0, 0, 1.4], [1.5, 2, 0]]]
+        ).astype(np.float32)
+        ref_types = np.arange(len(ref_points)) % 2
+        points = np.zeros((2, 3), dtype=np.float32)
+        types = np.array([0, 1])
+        box = freud.box.Box.cube(L)
+
+        nq = self.build_query_object(box, ref_points, L/10)
+
+        nlist = nq.query(points, dict(
+            mode='ball', r_max_pairs=r_max_pairs, point_types=ref_types,
+            query_point_types=types)).toNeighborList()
+        self.assert_type_pair_bonds(nq, points, r_max_pairs, ref_types,
+                                    types, nlist)
+
     def test_reciprocal(self):
         """Test that, for a random set of points, for each (i, j) neighbor
         pair there also exists a (j, i) neighbor pair for one set of points"""
@@ -653,6 +797,26 @@ class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
                                        exclude_ii=True)).toNeighborList()
         self.assertTrue(nlist_equal(nlist1, nlist2))
 
+    def test_query_points_outside_box(self):
+        """Check that periodic images of query points find the same
+        neighbors in a triclinic box."""
+        np.random.seed(0)
+        box = freud.box.Box(10, 11, 12, 0.3, -0.2, 0.4)
+        points = box.make_absolute(np.random.rand(1000, 3))
+        r_max = 1.5
+        lc = freud.locality.LinkCell(box, points, r_max)
+        nlist1 = lc.query(points, dict(r_max=r_max)).toNeighborList()
+
+        shift = (2 * box.to_matrix()[:, 0] - box.to_matrix()[:, 1]
+                 + 3 * box.to_matrix()[:, 2])
+        nlist2 = lc.query(points + shift, dict(r_max=r_max)).toNeighborList()
+        self.assertTrue(nlist_equal(nlist1, nlist2))
+        npt.assert_allclose(nlist1.distances, nlist2.distances, atol=1e-4)
+
+        # Compare against a brute force search.
+        distances = box.compute_all_distances(points, points)
+        npt.assert_equal(len(nlist1), np.sum(distances < r_max))
+
 
 class TestMultipleMethods(unittest.TestCase):
     """Check that different methods of making a NeighborList give the same
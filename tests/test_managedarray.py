@@ -50,6 +50,38 @@ class TestManagedArray(object):
         for prop in self.computed_properties:
             npt.assert_array_equal(copied[prop], accessed[prop])
 
+    def test_double_buffered(self):
+        """Check that double-buffered outputs alternate between two arrays,
+        preserving the previous result and reusing the one before it."""
+        self.build_object()
+        if not hasattr(self.obj, 'double_buffered'):
+            self.skipTest("The compute does not support double buffering.")
+        self.obj.double_buffered = True
+        self.assertTrue(self.obj.double_buffered)
+
+        copied = []
+        accessed = []
+        for i in range(3):
+            self.compute()
+            copied.append({prop: np.copy(getattr(self.obj, prop))
+                           for prop in self.computed_properties})
+            accessed.append({prop: getattr(self.obj, prop)
+                             for prop in self.computed_properties})
+
+        for prop in self.computed_properties:
+            self.assertTrue(
+                np.shares_memory(accessed[0][prop], accessed[2][prop]))
+            self.assertFalse(
+                np.shares_memory(accessed[1][prop], accessed[2][prop]))
+            for i in [1, 2]:
+                npt.assert_array_equal(copied[i][prop], accessed[i][prop])
+
+        self.obj.double_buffered = False
+        self.compute()
+        for prop in self.computed_properties:
+            self.assertFalse(np.shares_memory(
+                getattr(self.obj, prop), accessed[2][prop]))
+
 
 if __name__ == '__main__':
     unittest.main()
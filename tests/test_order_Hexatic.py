@@ -4,6 +4,7 @@ import freud
 import matplotlib
 import unittest
 import util
+from test_managedarray import TestManagedArray
 matplotlib.use('agg')
 
 
@@ -202,5 +203,18 @@ class TestHexatic(unittest.TestCase):
         hop.plot()
 
 
+class TestHexaticManagedArray(TestManagedArray, unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.order.Hexatic()
+
+    @property
+    def computed_properties(self):
+        return ['particle_order']
+
+    def compute(self):
+        box, points = freud.data.make_random_system(10, 200, is2D=True)
+        self.obj.compute((box, points))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -5,6 +5,7 @@ import matplotlib
 import rowan
 import unittest
 import util
+from test_managedarray import TestManagedArray
 matplotlib.use('agg')
 
 # Validated against manual calculation and pyboo
@@ -318,5 +319,18 @@ class TestSteinhardt(unittest.TestCase):
         npt.assert_allclose(np.nan_to_num(comp.particle_order), 0)
 
 
+class TestSteinhardtManagedArray(TestManagedArray, unittest.TestCase):
+    def build_object(self):
+        self.obj = freud.order.Steinhardt(6, average=True)
+
+    @property
+    def computed_properties(self):
+        return ['particle_order', 'ql']
+
+    def compute(self):
+        box, points = freud.data.make_random_system(5, 100)
+        self.obj.compute((box, points), neighbors={'r_max': 1.5})
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -1,4 +1,6 @@
 import freud
+import numpy as np
+import numpy.testing as npt
 import unittest
 
 
@@ -32,6 +34,71 @@ class TestParallel(unittest.TestCase):
         # to its previous value.
         self.assertEqual(freud.parallel.get_num_threads(), 1)
 
+    def test_execution_context(self):
+        """Test running computations in isolated execution contexts."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        ref = freud.density.RDF(bins=50, r_max=3)
+        ref.compute((box, points))
+
+        context = freud.parallel.ExecutionContext(num_threads=2)
+        self.assertEqual(context.num_threads, 2)
+        self.assertIsNone(context.numa_node)
+        self.assertEqual(context.max_concurrency, 2)
+        rdf = freud.density.RDF(bins=50, r_max=3)
+        with context:
+            with freud.parallel.ExecutionContext(num_threads=1) as inner:
+                self.assertEqual(inner.max_concurrency, 1)
+                rdf.compute((box, points))
+            npt.assert_allclose(rdf.rdf, ref.rdf, rtol=1e-6)
+            rdf.compute((box, points))
+        npt.assert_allclose(rdf.rdf, ref.rdf, rtol=1e-6)
+
+        # Contexts can be reused.
+        with context:
+            rdf.compute((box, points))
+        npt.assert_allclose(rdf.rdf, ref.rdf, rtol=1e-6)
+
+    def test_execution_context_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.parallel.ExecutionContext(num_threads=0)
+        nodes = freud.parallel.get_numa_nodes()
+        invalid_node = max(nodes, default=0) + 1
+        with self.assertRaises(ValueError):
+            freud.parallel.ExecutionContext(numa_node=invalid_node)
+        for node in nodes:
+            context = freud.parallel.ExecutionContext(numa_node=node)
+            self.assertEqual(context.numa_node, node)
+
+    def test_memory_pool(self):
+        """Test that arrays are recycled by the memory pool."""
+        freud.parallel.set_memory_pool(max_cached_bytes=2**20)
+        try:
+            pool = freud.parallel.get_memory_pool()
+            self.assertTrue(pool['enabled'])
+            self.assertFalse(pool['huge_pages'])
+            self.assertEqual(pool['max_cached_bytes'], 2**20)
+
+            box = freud.box.Box.cube(10)
+            points = box.wrap(np.random.rand(1000, 3) * 10)
+            rdf = freud.density.RDF(bins=100, r_max=4)
+            for _ in range(3):
+                rdf.compute((box, points))
+                rdf_values = rdf.rdf
+                self.assertTrue(np.all(np.isfinite(rdf_values)))
+            del rdf_values
+            self.assertGreater(
+                freud.parallel.get_memory_pool()['cached_bytes'], 0)
+            self.assertLessEqual(
+                freud.parallel.get_memory_pool()['cached_bytes'], 2**20)
+        finally:
+            freud.parallel.set_memory_pool(
+                enabled=False, max_cached_bytes=2**30)
+        self.assertEqual(freud.parallel.get_memory_pool()['cached_bytes'], 0)
+
+    def test_memory_pool_invalid(self):
+        with self.assertRaises(ValueError):
+            freud.parallel.set_memory_pool(max_cached_bytes=-1)
+
 
 if __name__ == '__main__':
     unittest.main()
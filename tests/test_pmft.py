@@ -180,6 +180,30 @@ class TestPMFT:
 
         assert np.isclose(np.nanmean(rdf), 1, rtol=1e-2, atol=1e-2)
 
+    def test_accumulation_strategies(self):
+        """Verify that every bin accumulation strategy gives the same
+        histogram as private per-thread bins."""
+        N = 500
+        system = freud.data.make_random_system(10, N, self.ndim == 2, seed=4)
+        np.random.seed(4)
+        orientations = rowan.random.rand(N) if self.ndim == 3 else \
+            np.random.rand(N)*2*np.pi
+
+        pmft = self.make_pmft()
+        pmft.accumulation_strategy = 'dense'
+        pmft.compute(system, orientations)
+        pmft.compute(system, orientations, reset=False)
+        self.assertGreater(np.sum(pmft.bin_counts), 0)
+
+        for strategy in ['atomic', 'cache', 'sparse']:
+            other = self.make_pmft()
+            other.accumulation_strategy = strategy
+            self.assertEqual(other.accumulation_strategy, strategy)
+            other.compute(system, orientations)
+            other.compute(system, orientations, reset=False)
+            npt.assert_array_equal(other.bin_counts, pmft.bin_counts)
+            npt.assert_allclose(other.pmft, pmft.pmft, rtol=1e-6)
+
 
 class TestPMFT2D(TestPMFT):
     def test_2d_box_3d_points(self):